@@ -0,0 +1,468 @@
+/// \file Baselines.cpp
+/// \brief Implementation of the baseline PRNGs that Cayley32 is compared with.
+
+#include "Includes.h"
+#include "Baselines.h"
+
+#if defined(_MSC_VER) && defined(_M_X64) //Windows Visual Studio on x64
+  #include <intrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+//Helper functions
+
+#pragma region helpers
+
+/// Rotate a 64-bit word left.
+/// \param x Word to be rotated.
+/// \param k Number of bits to rotate by, \f$0 \leq k < 64\f$.
+/// \return x rotated left by k bits.
+
+static inline uint64_t rotl64(uint64_t x, int k){
+  return (x << k) | (x >> ((64 - k) & 63));
+} //rotl64
+
+/// Rotate a 32-bit word left.
+/// \param x Word to be rotated.
+/// \param k Number of bits to rotate by, \f$0 < k < 32\f$.
+/// \return x rotated left by k bits.
+
+static inline uint32_t rotl32(uint32_t x, int k){
+  return (x << k) | (x >> (32 - k));
+} //rotl32
+
+/// Multiply two 64-bit words giving a 128-bit product.
+/// \param a First multiplicand.
+/// \param b Second multiplicand.
+/// \param hi [OUT] High 64 bits of the product.
+/// \return Low 64 bits of the product.
+
+static inline uint64_t mulhilo(uint64_t a, uint64_t b, uint64_t& hi){
+  #if defined(__SIZEOF_INT128__) //gcc and clang on 64-bit machines
+    const unsigned __int128 r = (unsigned __int128)a*b; //product
+    hi = uint64_t(r >> 64);
+    return uint64_t(r);
+
+  #elif defined(_MSC_VER) && defined(_M_X64) //Windows Visual Studio on x64
+    return _umul128(a, b, &hi);
+
+  #else //portable, from 32-bit halves
+    const uint64_t a0 = uint32_t(a), a1 = a >> 32; //halves of a
+    const uint64_t b0 = uint32_t(b), b1 = b >> 32; //halves of b
+    const uint64_t p00 = a0*b0, p01 = a0*b1, p10 = a1*b0; //partial products
+    const uint64_t mid = (p00 >> 32) + uint32_t(p01) + uint32_t(p10); //middle
+
+    hi = a1*b1 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | uint32_t(p00);
+  #endif
+} //mulhilo
+
+#pragma endregion helpers
+
+///////////////////////////////////////////////////////////////////////////////
+//SplitMix64
+
+#pragma region splitmix64
+
+/// Constructor.
+/// \param seed Seed.
+
+CSplitMix64::CSplitMix64(uint64_t seed){
+  srand(seed);
+} //constructor
+
+/// Seed the generator.
+/// \param seed Seed.
+
+void CSplitMix64::srand(uint64_t seed){
+  m_nState = seed;
+} //srand
+
+/// Generate 64 pseudorandom bits.
+/// \return 64 pseudorandom bits.
+
+uint64_t CSplitMix64::rand(){
+  uint64_t z = (m_nState += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+} //rand
+
+/// Generate many pseudorandom words.
+/// \param p [OUT] Buffer of at least n words.
+/// \param n Number of words.
+
+void CSplitMix64::fill(uint64_t* p, size_t n){
+  for(size_t i=0; i<n; i++)
+    p[i] = rand();
+} //fill
+
+/// Generate 64 pseudorandom bits.
+/// \return 64 pseudorandom bits.
+
+uint64_t CSplitMix64::operator()(){
+  return rand();
+} //operator()
+
+#pragma endregion splitmix64
+
+///////////////////////////////////////////////////////////////////////////////
+//xoshiro256**
+
+#pragma region xoshiro256
+
+/// Constructor.
+/// \param seed Seed.
+
+CXoshiro256::CXoshiro256(uint64_t seed){
+  srand(seed);
+} //constructor
+
+/// Seed the generator by filling the state from SplitMix64, which cannot
+/// make it all zero.
+/// \param seed Seed.
+
+void CXoshiro256::srand(uint64_t seed){
+  CSplitMix64 sm(seed); //seed expander
+  sm.fill(m_nState, 4);
+} //srand
+
+/// Generate 64 pseudorandom bits.
+/// \return 64 pseudorandom bits.
+
+uint64_t CXoshiro256::rand(){
+  uint64_t* s = m_nState; //shorthand
+  const uint64_t result = rotl64(s[1]*5, 7)*9; //return result
+  const uint64_t t = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl64(s[3], 45);
+
+  return result;
+} //rand
+
+/// Generate many pseudorandom words. The state is kept in locals so that
+/// the compiler can keep it in registers.
+/// \param p [OUT] Buffer of at least n words.
+/// \param n Number of words.
+
+void CXoshiro256::fill(uint64_t* p, size_t n){
+  uint64_t s0 = m_nState[0], s1 = m_nState[1]; //local copy of state
+  uint64_t s2 = m_nState[2], s3 = m_nState[3]; //local copy of state
+
+  for(size_t i=0; i<n; i++){
+    p[i] = rotl64(s1*5, 7)*9;
+    const uint64_t t = s1 << 17;
+
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3 = rotl64(s3, 45);
+  } //for
+
+  m_nState[0] = s0; m_nState[1] = s1;
+  m_nState[2] = s2; m_nState[3] = s3;
+} //fill
+
+/// Generate 64 pseudorandom bits.
+/// \return 64 pseudorandom bits.
+
+uint64_t CXoshiro256::operator()(){
+  return rand();
+} //operator()
+
+#pragma endregion xoshiro256
+
+///////////////////////////////////////////////////////////////////////////////
+//PCG64
+
+#pragma region pcg64
+
+static const uint64_t PCG_MUL_HI = 0x2360ED051FC65DA4ULL; ///< Multiplier, high.
+static const uint64_t PCG_MUL_LO = 0x4385DF649FCCF645ULL; ///< Multiplier, low.
+
+/// Constructor.
+/// \param seed Seed.
+
+CPCG64::CPCG64(uint64_t seed){
+  srand(seed);
+} //constructor
+
+/// Advance the LCG, that is, multiply the state by the multiplier and add
+/// the increment, both modulo \f$2^{128}\f$.
+
+void CPCG64::Step(){
+  uint64_t hi; //high word of product of low words
+  const uint64_t lo = mulhilo(m_nStateLo, PCG_MUL_LO, hi); //low word
+
+  hi += m_nStateLo*PCG_MUL_HI + m_nStateHi*PCG_MUL_LO;
+
+  m_nStateLo = lo + m_nIncLo;
+  m_nStateHi = hi + m_nIncHi + (m_nStateLo < lo);
+} //Step
+
+/// Seed the generator the way that pcg64_srandom_r() does.
+/// \param seed Initial state.
+/// \param stream Stream selector.
+
+void CPCG64::srand(uint64_t seed, uint64_t stream){
+  m_nStateLo = m_nStateHi = 0;
+  m_nIncLo = (stream << 1) | 1; //increment must be odd
+  m_nIncHi = stream >> 63;
+
+  Step();
+  m_nStateLo += seed;
+  m_nStateHi += m_nStateLo < seed;
+  Step();
+} //srand
+
+/// Generate 64 pseudorandom bits by advancing the LCG and applying the
+/// XSL-RR output function to the new state.
+/// \return 64 pseudorandom bits.
+
+uint64_t CPCG64::rand(){
+  Step();
+  return rotl64(m_nStateHi ^ m_nStateLo, (64 - int(m_nStateHi >> 58)) & 63);
+} //rand
+
+/// Generate many pseudorandom words.
+/// \param p [OUT] Buffer of at least n words.
+/// \param n Number of words.
+
+void CPCG64::fill(uint64_t* p, size_t n){
+  for(size_t i=0; i<n; i++)
+    p[i] = rand();
+} //fill
+
+/// Generate 64 pseudorandom bits.
+/// \return 64 pseudorandom bits.
+
+uint64_t CPCG64::operator()(){
+  return rand();
+} //operator()
+
+#pragma endregion pcg64
+
+///////////////////////////////////////////////////////////////////////////////
+//Philox4x64-10
+
+#pragma region philox
+
+/// Constructor.
+/// \param seed Seed.
+
+CPhilox4x64::CPhilox4x64(uint64_t seed){
+  srand(seed);
+} //constructor
+
+/// Seed the generator by setting the key and resetting the counter.
+/// \param seed Seed.
+
+void CPhilox4x64::srand(uint64_t seed){
+  m_nKey[0] = seed;
+  m_nKey[1] = 0;
+
+  for(int i=0; i<4; i++)
+    m_nCtr[i] = 0;
+
+  m_nIndex = 4; //current block is used up
+} //srand
+
+/// The Philox4x64-10 block function.
+/// \param ctr Counter.
+/// \param out [OUT] Encrypted counter.
+
+void CPhilox4x64::Encrypt(const uint64_t ctr[4], uint64_t out[4]) const{
+  uint64_t x0 = ctr[0], x1 = ctr[1], x2 = ctr[2], x3 = ctr[3]; //block
+  uint64_t k0 = m_nKey[0], k1 = m_nKey[1]; //round key
+
+  for(int r=0; r<10; r++){
+    uint64_t hi0, hi1; //high words of products
+    const uint64_t lo0 = mulhilo(0xD2E7470EE14C6C93ULL, x0, hi0);
+    const uint64_t lo1 = mulhilo(0xCA5A826395121157ULL, x2, hi1);
+
+    x0 = hi1 ^ x1 ^ k0;
+    x1 = lo1;
+    x2 = hi0 ^ x3 ^ k1;
+    x3 = lo0;
+
+    k0 += 0x9E3779B97F4A7C15ULL; //bump the key
+    k1 += 0xBB67AE8584CAA73BULL;
+  } //for
+
+  out[0] = x0; out[1] = x1; out[2] = x2; out[3] = x3;
+} //Encrypt
+
+/// Increment the 256-bit counter.
+
+void CPhilox4x64::Increment(){
+  for(int i=0; i<4 && ++m_nCtr[i] == 0; i++); //carry
+} //Increment
+
+/// Generate 64 pseudorandom bits.
+/// \return 64 pseudorandom bits.
+
+uint64_t CPhilox4x64::rand(){
+  if(m_nIndex == 4){ //need a new block
+    Encrypt(m_nCtr, m_nBlock);
+    Increment();
+    m_nIndex = 0;
+  } //if
+
+  return m_nBlock[m_nIndex++];
+} //rand
+
+/// Generate many pseudorandom words. Whole blocks are encrypted directly
+/// into the buffer.
+/// \param p [OUT] Buffer of at least n words.
+/// \param n Number of words.
+
+void CPhilox4x64::fill(uint64_t* p, size_t n){
+  for(; n > 0 && m_nIndex < 4; n--) //use up the current block
+    *p++ = m_nBlock[m_nIndex++];
+
+  for(; n >= 4; n-=4, p+=4){ //whole blocks
+    Encrypt(m_nCtr, p);
+    Increment();
+  } //for
+
+  for(; n > 0; n--) //part of one more block
+    *p++ = rand();
+} //fill
+
+/// Generate 64 pseudorandom bits.
+/// \return 64 pseudorandom bits.
+
+uint64_t CPhilox4x64::operator()(){
+  return rand();
+} //operator()
+
+#pragma endregion philox
+
+///////////////////////////////////////////////////////////////////////////////
+//ChaCha20
+
+#pragma region chacha20
+
+/// The ChaCha quarter round.
+
+#define QUARTERROUND(a, b, c, d) \
+  a += b; d = rotl32(d ^ a, 16); \
+  c += d; b = rotl32(b ^ c, 12); \
+  a += b; d = rotl32(d ^ a,  8); \
+  c += d; b = rotl32(b ^ c,  7);
+
+/// Constructor.
+/// \param seed Seed.
+
+CChaCha20::CChaCha20(uint64_t seed){
+  srand(seed);
+} //constructor
+
+/// Seed the generator by expanding the seed into a key with SplitMix64 and
+/// resetting the counter.
+/// \param seed Seed.
+
+void CChaCha20::srand(uint64_t seed){
+  CSplitMix64 sm(seed); //key expander
+  uint32_t key[8]; //key
+
+  for(int i=0; i<8; i+=2){
+    const uint64_t k = sm.rand(); //two words of key
+    key[i] = uint32_t(k);
+    key[i + 1] = uint32_t(k >> 32);
+  } //for
+
+  SetKey(key);
+} //srand
+
+/// Set the key directly and reset the counter.
+/// \param key Key as eight little-endian words.
+
+void CChaCha20::SetKey(const uint32_t key[8]){
+  m_nInput[0] = 0x61707865; //"expand 32-byte k"
+  m_nInput[1] = 0x3320646E;
+  m_nInput[2] = 0x79622D32;
+  m_nInput[3] = 0x6B206574;
+
+  for(int i=0; i<8; i++)
+    m_nInput[4 + i] = key[i];
+
+  for(int i=12; i<16; i++) //counter and nonce
+    m_nInput[i] = 0;
+
+  m_nIndex = 8; //current block is used up
+} //SetKey
+
+/// The ChaCha20 block function. Encrypt the current counter and increment it.
+/// \param out [OUT] 64 bytes of keystream as little-endian words.
+
+void CChaCha20::Encrypt(uint64_t out[8]){
+  uint32_t x[16]; //working state
+
+  for(int i=0; i<16; i++)
+    x[i] = m_nInput[i];
+
+  for(int r=0; r<20; r+=2){ //double rounds
+    QUARTERROUND(x[0], x[4], x[ 8], x[12]) //columns
+    QUARTERROUND(x[1], x[5], x[ 9], x[13])
+    QUARTERROUND(x[2], x[6], x[10], x[14])
+    QUARTERROUND(x[3], x[7], x[11], x[15])
+    QUARTERROUND(x[0], x[5], x[10], x[15]) //diagonals
+    QUARTERROUND(x[1], x[6], x[11], x[12])
+    QUARTERROUND(x[2], x[7], x[ 8], x[13])
+    QUARTERROUND(x[3], x[4], x[ 9], x[14])
+  } //for
+
+  for(int i=0; i<8; i++)
+    out[i] = uint64_t(x[2*i] + m_nInput[2*i]) |
+      uint64_t(x[2*i + 1] + m_nInput[2*i + 1]) << 32;
+
+  if(++m_nInput[12] == 0) //64-bit block counter
+    ++m_nInput[13];
+} //Encrypt
+
+#undef QUARTERROUND
+
+/// Generate 64 pseudorandom bits.
+/// \return 64 pseudorandom bits.
+
+uint64_t CChaCha20::rand(){
+  if(m_nIndex == 8){ //need a new block
+    Encrypt(m_nBlock);
+    m_nIndex = 0;
+  } //if
+
+  return m_nBlock[m_nIndex++];
+} //rand
+
+/// Generate many pseudorandom words. Whole blocks are encrypted directly
+/// into the buffer.
+/// \param p [OUT] Buffer of at least n words.
+/// \param n Number of words.
+
+void CChaCha20::fill(uint64_t* p, size_t n){
+  for(; n > 0 && m_nIndex < 8; n--) //use up the current block
+    *p++ = m_nBlock[m_nIndex++];
+
+  for(; n >= 8; n-=8, p+=8) //whole blocks
+    Encrypt(p);
+
+  for(; n > 0; n--) //part of one more block
+    *p++ = rand();
+} //fill
+
+/// Generate 64 pseudorandom bits.
+/// \return 64 pseudorandom bits.
+
+uint64_t CChaCha20::operator()(){
+  return rand();
+} //operator()
+
+#pragma endregion chacha20
@@ -0,0 +1,142 @@
+/// \file Baselines.h
+/// \brief Declaration of the baseline PRNGs that Cayley32 is compared with.
+///
+/// Each baseline has the same interface as CMersenneTwister, that is, a
+/// constructor and srand() that take a 64-bit seed, rand() and operator()()
+/// that generate 64 pseudorandom bits, and fill() that generates many
+/// pseudorandom words into a buffer. The output of each is identical to that
+/// of its authors' reference code when seeded in the same way.
+
+#ifndef __baselines__
+#define __baselines__
+
+#include <cinttypes>
+#include <cstddef>
+
+/// \brief Vigna's SplitMix64.
+///
+/// A Weyl sequence with a 64-bit mixing function. It is used here to expand
+/// a 64-bit seed into the larger states of the other baselines, as their
+/// authors recommend.
+
+class CSplitMix64{
+  private:
+    uint64_t m_nState = 0; ///< State.
+
+  public:
+    CSplitMix64(uint64_t seed=0); ///< Constructor.
+
+    void srand(uint64_t seed); ///< Seed the generator.
+    uint64_t rand(); ///< Generate 64 pseudorandom bits.
+    void fill(uint64_t* p, size_t n); ///< Generate many pseudorandom words.
+
+    uint64_t operator()(); ///< Generate 64 pseudorandom bits.
+}; //CSplitMix64
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// \brief Blackman and Vigna's xoshiro256**.
+///
+/// A linear generator with 256 bits of state and a nonlinear scrambler.
+/// The state is seeded from SplitMix64.
+
+class CXoshiro256{
+  private:
+    uint64_t m_nState[4]; ///< State.
+
+  public:
+    CXoshiro256(uint64_t seed=0); ///< Constructor.
+
+    void srand(uint64_t seed); ///< Seed the generator.
+    uint64_t rand(); ///< Generate 64 pseudorandom bits.
+    void fill(uint64_t* p, size_t n); ///< Generate many pseudorandom words.
+
+    uint64_t operator()(); ///< Generate 64 pseudorandom bits.
+}; //CXoshiro256
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// \brief O'Neill's PCG64.
+///
+/// A 128-bit linear congruential generator with the XSL-RR output function,
+/// that is, pcg64 from the PCG reference code. The seed and the stream
+/// selector are each 128 bits there; srand() takes 64-bit values for both.
+
+class CPCG64{
+  private:
+    uint64_t m_nStateLo = 0; ///< Low 64 bits of state.
+    uint64_t m_nStateHi = 0; ///< High 64 bits of state.
+    uint64_t m_nIncLo = 0; ///< Low 64 bits of increment.
+    uint64_t m_nIncHi = 0; ///< High 64 bits of increment.
+
+    void Step(); ///< Advance the LCG.
+
+  public:
+    CPCG64(uint64_t seed=0); ///< Constructor.
+
+    void srand(uint64_t seed, uint64_t stream=0); ///< Seed the generator.
+    uint64_t rand(); ///< Generate 64 pseudorandom bits.
+    void fill(uint64_t* p, size_t n); ///< Generate many pseudorandom words.
+
+    uint64_t operator()(); ///< Generate 64 pseudorandom bits.
+}; //CPCG64
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// \brief Salmon et al.'s Philox4x64-10.
+///
+/// A counter-based generator that encrypts a 256-bit counter with a 128-bit
+/// key using 10 rounds of a multiply-based Feistel-like network, giving four
+/// words per block. The key is the seed zero-extended to 128 bits and the
+/// counter starts at zero.
+
+class CPhilox4x64{
+  private:
+    uint64_t m_nKey[2]; ///< Key.
+    uint64_t m_nCtr[4]; ///< Counter of the next block.
+    uint64_t m_nBlock[4]; ///< Current block of output.
+    int m_nIndex = 4; ///< Index of next word of output in the current block.
+
+    void Encrypt(const uint64_t ctr[4], uint64_t out[4]) const; ///< Block function.
+    void Increment(); ///< Increment the counter.
+
+  public:
+    CPhilox4x64(uint64_t seed=0); ///< Constructor.
+
+    void srand(uint64_t seed); ///< Seed the generator.
+    uint64_t rand(); ///< Generate 64 pseudorandom bits.
+    void fill(uint64_t* p, size_t n); ///< Generate many pseudorandom words.
+
+    uint64_t operator()(); ///< Generate 64 pseudorandom bits.
+}; //CPhilox4x64
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// \brief Bernstein's ChaCha20 stream cipher as a PRNG.
+///
+/// The keystream of ChaCha20 in its original form with a 64-bit block
+/// counter and a 64-bit nonce of zero, read as little-endian words. The
+/// 256-bit key is expanded from the seed by SplitMix64, or may be set
+/// directly with SetKey() to reproduce published keystreams. Each block
+/// gives eight words.
+
+class CChaCha20{
+  private:
+    uint32_t m_nInput[16]; ///< Constants, key, counter, and nonce.
+    uint64_t m_nBlock[8]; ///< Current block of output.
+    int m_nIndex = 8; ///< Index of next word of output in the current block.
+
+    void Encrypt(uint64_t out[8]); ///< Block function, increments the counter.
+
+  public:
+    CChaCha20(uint64_t seed=0); ///< Constructor.
+
+    void srand(uint64_t seed); ///< Seed the generator.
+    void SetKey(const uint32_t key[8]); ///< Set the key.
+    uint64_t rand(); ///< Generate 64 pseudorandom bits.
+    void fill(uint64_t* p, size_t n); ///< Generate many pseudorandom words.
+
+    uint64_t operator()(); ///< Generate 64 pseudorandom bits.
+}; //CChaCha20
+
+#endif
@@ -0,0 +1,906 @@
+/// \file Benchmark.cpp
+/// \brief Implementation of the benchmarks.
+
+#include <atomic>
+#include <thread>
+
+#include "Includes.h"
+#include "Benchmark.h"
+#include "Cayley32.h"
+#include "CayleyPacked.h"
+#include "CayleyBank.h"
+#include "Shuffle.h"
+#include "CayleyWide.h"
+#include "Threads.h"
+#include "Kernels.h"
+#include "mt19937-64.h"
+#include "Baselines.h"
+#include "Histogram.h"
+
+uint64_t WallTimeInNanoseconds(); ///< Wall clock time in nanoseconds.
+
+///////////////////////////////////////////////////////////////////////////////
+//Multi-core scaling
+
+#pragma region scaling
+
+/// \brief Per-thread result of the scaling benchmark.
+///
+/// The padding makes each slot a whole cache line, so that no two slots
+/// can share a line however the array is aligned and threads that write
+/// their results do not falsely share with their neighbours.
+
+struct CScalingSlot{
+  uint64_t m_nElapsed = 0; ///< Elapsed time in nanoseconds.
+  uint8_t m_nPad[64 - sizeof(uint64_t)]; ///< Padding to a cache line.
+}; //CScalingSlot
+
+/// \brief Generate pseudorandom numbers on one thread of the scaling benchmark.
+///
+/// Pin the current thread to a core, construct and seed an instance of
+/// Cayley32, wait until all of the other threads are ready, then time the
+/// generation of pseudorandom numbers into a small buffer. The generator
+/// and buffer are on this thread's stack, so they share no cache lines with
+/// other threads. If there is no warm instance, then the power tables are
+/// built by this thread. Otherwise they are borrowed from the warm instance,
+/// which is built by its owner after pinning, so that the operating system
+/// puts its pages on the owner's NUMA node when they are first touched.
+/// \param i Thread index, which is also the core to be pinned to.
+/// \param nThreads Number of threads.
+/// \param seed Seed, which will be offset by the thread index.
+/// \param n Number of 64-bit words to generate.
+/// \param bOwner Whether this thread is to build the warm instance.
+/// \param warm Warm instance whose tables are to be shared, or nullptr to
+///   build our own.
+/// \param ready Number of threads ready to start.
+/// \param slot [OUT] Result.
+
+static void ScalingThread(uint32_t i, uint32_t nThreads, uintx_t seed,
+  uint64_t n, bool bOwner, std::atomic<Cayley32*>* warm,
+  std::atomic<uint32_t>* ready, CScalingSlot* slot)
+{
+  const uint32_t nBufSize = 4096; //buffer size in 64-bit words
+  uint64_t buffer[nBufSize]; //buffer for pseudo-random numbers
+
+  PinThread(i);
+
+  Cayley32 cayley32; //new PRNG with fixed generators
+  seed += int(i); //independent seed for each thread
+
+  if(warm != nullptr){ //borrow the power tables
+    if(bOwner){ //build them first
+      Cayley32* p = new Cayley32; //warm instance, first touched here
+      uintx_t s(seed); //seed for the warm instance
+      p->srand(s);
+      warm->store(p);
+    } //if
+
+    while(warm->load() == nullptr) //wait for the owner
+      std::this_thread::yield();
+
+    cayley32.ShareTables(*warm->load());
+  } //if
+
+  cayley32.srand(seed); //seed it
+
+  ready->fetch_add(1); //this thread is ready
+
+  while(ready->load() < nThreads) //wait for the others
+    std::this_thread::yield();
+
+  const uint64_t t0 = WallTimeInNanoseconds(); //start time
+
+  for(uint64_t j=0; j<n; j++)
+    buffer[j%nBufSize] = cayley32.rand();
+
+  slot->m_nElapsed = WallTimeInNanoseconds() - t0;
+
+  volatile uint64_t sink = buffer[n%nBufSize]; //keep the compiler honest
+  (void)sink;
+} //ScalingThread
+
+/// \brief Multi-core scaling benchmark.
+///
+/// Run independent instances of Cayley32 on \f$N\f$ pinned threads for
+/// \f$1 \leq N \leq c\f$, where \f$c\f$ is the number of logical cores, and
+/// print a table of the aggregate throughput, the mean, minimum, and maximum
+/// per-thread throughput, and the scaling efficiency, which is the aggregate
+/// throughput divided by \f$N\f$ times the single-thread throughput.
+/// Cayley32 has no shared mutable state, so efficiency below 1 comes from
+/// shared hardware such as caches, memory bandwidth, and hyperthreads.
+/// A large spread between the minimum and maximum per-thread throughput
+/// indicates contention between threads. The power tables may be built by
+/// every thread, by the first thread on each NUMA node and shared by the
+/// others on that node, or by the first thread and shared by all, which
+/// shows the cost of reading tables from another socket's memory.
+/// \param seed Seed, which will be offset by the thread index.
+/// \param n Number of 64-bit words to generate per thread.
+/// \param mode Which threads get their own copy of the power tables.
+
+void ScalingBenchmark(const uintx_t& seed, uint64_t n, TableMode mode){
+  const uint32_t nCores = GetCoreCount(); //number of logical cores
+  const double bytes = double(n*sizeof(uint64_t)); //bytes per thread
+  double base = 0; //single-thread throughput
+
+  std::vector<uint32_t> node(nCores, 0); //table copy used by each core
+  uint32_t nCopies = 1; //maximum number of table copies
+
+  if(mode == TableMode::Node){ //one copy per NUMA node
+    for(uint32_t i=0; i<nCores; i++)
+      node[i] = GetNodeOfCore(i);
+
+    nCopies = GetNodeCount();
+  } //if
+
+  printf("Scaling of Cayley32 on 1 to %u threads, ", nCores);
+  printf("%" PRIu64 " Megabits per thread, ", (8*n*sizeof(uint64_t))/1048576);
+
+  switch(mode){
+    case TableMode::Core: printf("tables per core.\n"); break;
+    case TableMode::Node: printf("tables per node (%u nodes).\n", nCopies); break;
+    case TableMode::Shared: printf("tables shared.\n"); break;
+  } //switch
+
+  printf("Threads   Total GB/s   Mean GB/s    Min GB/s    Max GB/s  Efficiency\n");
+
+  for(uint32_t nThreads=1; nThreads<=nCores; nThreads++){
+    std::vector<CScalingSlot> slot(nThreads); //result per thread
+    std::vector<std::thread> threads; //the threads
+    std::atomic<uint32_t> ready(0); //number of threads ready to start
+    std::vector<std::atomic<Cayley32*>> warm(nCopies); //warm instances
+    std::vector<bool> owned(nCopies, false); //whether a copy has an owner
+
+    for(auto& w: warm)
+      w.store(nullptr);
+
+    for(uint32_t i=0; i<nThreads; i++){
+      const uint32_t k = node[i]; //table copy for this thread
+      const bool bOwner = !owned[k]; //first thread to use this copy
+      owned[k] = true;
+
+      threads.push_back(std::thread(ScalingThread, i, nThreads, seed, n,
+        bOwner, mode == TableMode::Core? nullptr: &warm[k], &ready,
+        &slot[i]));
+    } //for
+
+    for(auto& t: threads)
+      t.join();
+
+    for(auto& w: warm)
+      delete w.load();
+
+    uint64_t tmax = 0; //longest elapsed time
+    double sum = 0, lo = 0, hi = 0; //per-thread throughput sum, min, max
+
+    for(uint32_t i=0; i<nThreads; i++){
+      const uint64_t t = std::max(slot[i].m_nElapsed, uint64_t(1)); //safety
+      const double r = bytes/double(t); //bytes per nanosecond is GB/s
+
+      tmax = std::max(tmax, t);
+      sum += r;
+      lo = i == 0? r: std::min(lo, r);
+      hi = std::max(hi, r);
+    } //for
+
+    const double total = nThreads*bytes/double(tmax); //aggregate throughput
+    if(nThreads == 1)base = total;
+
+    printf("%7u %12.3f %11.3f %11.3f %11.3f %11.2f\n", nThreads, total,
+      sum/nThreads, lo, hi, total/(nThreads*base));
+  } //for
+} //ScalingBenchmark
+
+#pragma endregion scaling
+
+///////////////////////////////////////////////////////////////////////////////
+//Baseline comparison
+
+#pragma region baselines
+
+/// \brief Time single-word generation.
+///
+/// Measure the wall clock time per call of a PRNG's rand() function. The
+/// outputs are combined so that the calls cannot be optimized away.
+/// \param rng A PRNG.
+/// \param n Number of 64-bit words to generate.
+/// \return Number of nanoseconds per 64-bit word.
+
+template<class rng_t> static double TimeRand(rng_t& rng, uint64_t n){
+  uint64_t x = 0; //combined outputs
+  const uint64_t t0 = WallTimeInNanoseconds(); //start time
+
+  for(uint64_t i=0; i<n; i++)
+    x ^= rng.rand();
+
+  const uint64_t t = WallTimeInNanoseconds() - t0; //elapsed time
+
+  volatile uint64_t sink = x; //keep the compiler honest
+  (void)sink;
+
+  return double(t)/double(n);
+} //TimeRand
+
+/// \brief Time bulk generation.
+///
+/// Measure the throughput of a PRNG's fill() function into a buffer that
+/// fits in L1 cache, so that memory bandwidth is not being measured.
+/// \param rng A PRNG.
+/// \param n Number of 64-bit words to generate.
+/// \return Throughput in GB/s.
+
+template<class rng_t> static double TimeFill(rng_t& rng, uint64_t n){
+  const uint64_t nBufSize = 2048; //buffer size in 64-bit words
+  uint64_t buffer[nBufSize]; //buffer for pseudo-random numbers
+  const uint64_t nBufs = std::max(n/nBufSize, uint64_t(1)); //number of fills
+
+  const uint64_t t0 = WallTimeInNanoseconds(); //start time
+
+  for(uint64_t i=0; i<nBufs; i++)
+    rng.fill(buffer, nBufSize);
+
+  const uint64_t t = WallTimeInNanoseconds() - t0; //elapsed time
+
+  volatile uint64_t sink = buffer[nBufSize - 1]; //keep the compiler honest
+  (void)sink;
+
+  return double(nBufs*nBufSize*sizeof(uint64_t))/double(std::max(t, uint64_t(1)));
+} //TimeFill
+
+/// \brief Time reseeding.
+///
+/// Measure the wall clock time taken to reseed a PRNG with distinct seeds.
+/// \param reseed Function that reseeds the PRNG from a 64-bit value.
+/// \param n Number of reseeds.
+/// \return Number of nanoseconds per reseed.
+
+template<class f_t> static double TimeSeed(const f_t& reseed, uint64_t n){
+  const uint64_t t0 = WallTimeInNanoseconds(); //start time
+
+  for(uint64_t i=0; i<n; i++)
+    reseed(i);
+
+  return double(WallTimeInNanoseconds() - t0)/double(n);
+} //TimeSeed
+
+/// \brief Time one PRNG and print a row of the baseline table.
+///
+/// \param name Name of the PRNG.
+/// \param rng A PRNG that has been seeded.
+/// \param reseed Function that reseeds rng from a 64-bit value.
+/// \param n Number of 64-bit words to generate.
+/// \param nSeeds Number of reseeds to time.
+/// \param base Fill throughput of Cayley32 in GB/s, or 0 if this is Cayley32.
+/// \return Fill throughput in GB/s.
+
+template<class rng_t, class f_t> static double BaselineRow(const char* name,
+  rng_t& rng, const f_t& reseed, uint64_t n, uint64_t nSeeds, double base)
+{
+  const double ns = TimeRand(rng, n); //latency of rand()
+  const double gbs = TimeFill(rng, n); //throughput of fill()
+  const double seed = TimeSeed(reseed, nSeeds); //latency of reseeding
+
+  printf("%-18s %10.2f %10.3f %10.3f %12.1f %9.1fx\n", name, ns,
+    sizeof(uint64_t)/ns, gbs, seed, base == 0? 1.0: gbs/base);
+
+  return gbs;
+} //BaselineRow
+
+/// \brief Baseline comparison benchmark.
+///
+/// Time Cayley32, Cayley32e, Cayley32a, the packed Cayley PRNG over
+/// \f$S_{16}\f$, and a selection of other PRNGs on the same harness, on a
+/// single thread, and print a table of the mean latency of rand() in
+/// nanoseconds, the corresponding throughput, the throughput of fill() into a
+/// buffer in L1 cache, the mean time to reseed, and the fill throughput
+/// relative to Cayley32. Cayley32 and Cayley32a are reseeded without
+/// rebuilding their power tables. Cayley32e is reseeded from a Mersenne
+/// Twister, which chooses new generators and so rebuilds its power tables,
+/// which is slow enough that only a few reseeds are timed. The packed Cayley
+/// PRNG is reseeded the same way, but its tables are tiny.
+/// \param seed Seed for all of the PRNGs, of which only the low 64 bits are
+///   used by the baselines.
+/// \param n Number of 64-bit words to generate per PRNG and measurement.
+
+void BaselineBenchmark(const uintx_t& seed, uint64_t n){
+  const uint64_t s = (uint64_t)seed; //seed for the baselines
+
+  printf("Comparison of Cayley32 with other PRNGs, ");
+  printf("%" PRIu64 " Megabits per measurement.\n", (8*n*sizeof(uint64_t))/1048576);
+  printf("Using %s kernels.\n", GetISAName(GetISA()));
+  printf("PRNG               rand() ns  rand GB/s  fill GB/s  srand() ns  vs Cayley32\n");
+
+  Cayley32 cayley32; //new PRNG with fixed generators
+  uintx_t x(seed); //srand() wants a mutable seed
+  cayley32.srand(x);
+
+  const double base = BaselineRow("Cayley32", cayley32,
+    [&](uint64_t i){cayley32.srand(uint128w_t(s + i));}, n, 1024, 0);
+
+  CMersenneTwister mt(s); //seeds Cayley32e
+  Cayley32e cayley32e; //new PRNG with pseudorandom generators
+  cayley32e.srand(mt);
+
+  BaselineRow("Cayley32e", cayley32e,
+    [&](uint64_t /*i*/){cayley32e.srand(mt);}, n, 4, base);
+
+  Cayley32a cayley32a; //new PRNG with AES finalizer
+  cayley32a.ShareTables(cayley32);
+  cayley32a.srand(x);
+
+  BaselineRow(UsingAESNI()? "Cayley32a AES-NI": "Cayley32a soft AES",
+    cayley32a, [&](uint64_t i){cayley32a.srand(uint128w_t(s + i));}, n,
+    1024, base);
+
+  CCayleyPacked packed(16); //new PRNG over S_16
+  packed.srand(mt);
+
+  BaselineRow("Cayley packed S16", packed,
+    [&](uint64_t /*i*/){packed.srand(mt);}, n, 1024, base);
+
+  BaselineRow("Mersenne Twister", mt,
+    [&](uint64_t i){mt.srand(s + i);}, n, 1024, base);
+
+  CSplitMix64 splitmix(s); //SplitMix64
+  BaselineRow("SplitMix64", splitmix,
+    [&](uint64_t i){splitmix.srand(s + i);}, n, 1024, base);
+
+  CXoshiro256 xoshiro(s); //xoshiro256**
+  BaselineRow("xoshiro256**", xoshiro,
+    [&](uint64_t i){xoshiro.srand(s + i);}, n, 1024, base);
+
+  CPCG64 pcg(s); //PCG64
+  BaselineRow("PCG64", pcg,
+    [&](uint64_t i){pcg.srand(s + i);}, n, 1024, base);
+
+  CPhilox4x64 philox(s); //Philox4x64-10
+  BaselineRow("Philox4x64-10", philox,
+    [&](uint64_t i){philox.srand(s + i);}, n, 1024, base);
+
+  CChaCha20 chacha(s); //ChaCha20
+  BaselineRow("ChaCha20", chacha,
+    [&](uint64_t i){chacha.srand(s + i);}, n, 1024, base);
+} //BaselineBenchmark
+
+#pragma endregion baselines
+
+///////////////////////////////////////////////////////////////////////////////
+//Latency
+
+#pragma region latency
+
+/// \brief Measure the overhead of reading the clock.
+///
+/// Read the clock back-to-back many times and take the smallest difference,
+/// which is the part of every measured interval that is due to the clock.
+/// \return Clock overhead in nanoseconds.
+
+static uint64_t ClockOverhead(){
+  uint64_t result = UINT64_MAX; //return result
+
+  for(int i=0; i<65536; i++){
+    const uint64_t t0 = WallTimeInNanoseconds(); //start time
+    result = std::min(result, WallTimeInNanoseconds() - t0);
+  } //for
+
+  return result;
+} //ClockOverhead
+
+/// \brief Record the latency of calls to a function.
+///
+/// Time each call of a function individually with the monotonic clock and
+/// record the time, less the clock overhead, in a histogram.
+/// \param f Function to be timed.
+/// \param n Number of calls.
+/// \param overhead Clock overhead in nanoseconds.
+/// \param h [OUT] Histogram of latencies in nanoseconds.
+
+template<class f_t> static void RecordLatency(const f_t& f, uint64_t n,
+  uint64_t overhead, CHistogram& h)
+{
+  h.Clear();
+
+  for(uint64_t i=0; i<n; i++){
+    const uint64_t t0 = WallTimeInNanoseconds(); //start time
+    f();
+    const uint64_t t = WallTimeInNanoseconds() - t0; //elapsed time
+    h.Record(t > overhead? t - overhead: 0);
+  } //for
+} //RecordLatency
+
+/// \brief Print a row of the latency table.
+///
+/// \param name Name of the operation.
+/// \param h Histogram of latencies in nanoseconds.
+
+static void PrintLatency(const char* name, const CHistogram& h){
+  printf("%-28s %9" PRIu64 " %9" PRIu64 " %9" PRIu64 " %9" PRIu64 " %9" PRIu64
+    " %11" PRIu64 " %11.1f\n", name, h.GetCount(), h.GetMin(),
+    h.GetPercentile(50), h.GetPercentile(99), h.GetPercentile(99.9),
+    h.GetMax(), h.GetMean());
+} //PrintLatency
+
+/// \brief Latency benchmark.
+///
+/// Time individual calls of Cayley32::rand(), Cayley32e::rand(),
+/// Cayley32e::fill() on a batch of words, reseeding Cayley32 from a 128-bit
+/// integer, and reseeding Cayley32e with CCayley::srand(), and print the
+/// minimum, median, 99th and 99.9th percentiles, maximum, and mean latency
+/// of each in nanoseconds. Unlike the averages reported elsewhere, the tail
+/// percentiles show outliers such as cache misses on cold power-table
+/// entries and the rejection loop in CCayley::ChooseGenerators(). Each call
+/// is timed with the monotonic wall clock and the clock overhead, measured
+/// beforehand, is subtracted.
+/// \param seed Seed.
+/// \param n Number of calls of rand() to time.
+
+void LatencyBenchmark(const uintx_t& seed, uint64_t n){
+  const uint64_t overhead = ClockOverhead(); //clock overhead in nanoseconds
+  const uint64_t nBatch = 512; //words per batch for fill()
+  const uint64_t nFills = std::max(n/nBatch, uint64_t(1)); //number of batches
+  const uint64_t nSeeds = 16; //number of calls of CCayley::srand()
+
+  std::vector<uint64_t> buffer(nBatch); //buffer for fill()
+  uint64_t x = 0; //combined outputs, to keep the compiler honest
+  CHistogram h; //histogram of latencies
+
+  printf("Latency of Cayley32 in nanoseconds on a single thread, ");
+  printf("clock overhead of %" PRIu64 " ns subtracted.\n", overhead);
+  printf("Using %s kernels.\n", GetISAName(GetISA()));
+  printf("Operation                        Count       Min       p50       p99");
+  printf("     p99.9         Max        Mean\n");
+
+  Cayley32 cayley32; //new PRNG with fixed generators
+  uintx_t s(seed); //srand() wants a mutable seed
+  cayley32.srand(s);
+
+  RecordLatency([&](){x ^= cayley32.rand();}, n, overhead, h);
+  PrintLatency("Cayley32::rand()", h);
+
+  const uint64_t s64 = (uint64_t)seed; //low 64 bits of seed
+  uint64_t i = 0; //reseed counter
+
+  RecordLatency([&](){cayley32.srand(uint128w_t(s64 + ++i));}, nFills,
+    overhead, h);
+  PrintLatency("Cayley32::srand(uint128w_t)", h);
+
+  CMersenneTwister mt(s64); //seeds Cayley32e
+  Cayley32e cayley32e; //new PRNG with pseudorandom generators
+  cayley32e.srand(mt);
+
+  RecordLatency([&](){x ^= cayley32e.rand();}, n, overhead, h);
+  PrintLatency("Cayley32e::rand()", h);
+
+  RecordLatency([&](){cayley32e.fill(buffer.data(), nBatch);}, nFills,
+    overhead, h);
+  PrintLatency("Cayley32e::fill(), 512 words", h);
+
+  RecordLatency([&](){cayley32e.srand(mt);}, nSeeds, overhead, h);
+  PrintLatency("CCayley::srand()", h);
+
+  volatile uint64_t sink = x ^ buffer[0]; //keep the compiler honest
+  (void)sink;
+} //LatencyBenchmark
+
+#pragma endregion latency
+
+///////////////////////////////////////////////////////////////////////////////
+//Block-parallel generation
+
+#pragma region blocks
+
+/// \brief Generate blocks of Cayley32c on one thread.
+///
+/// Pin the current thread to a core and generate every block whose index is
+/// congruent to the thread index modulo the number of threads, each directly
+/// into its place in a shared buffer, using an instance of Cayley32c that
+/// borrows the power tables of a warm instance.
+/// \param i Thread index, which is also the core to be pinned to.
+/// \param nThreads Number of threads.
+/// \param warm Warm instance whose tables are to be shared.
+/// \param key Key.
+/// \param nBlocks Number of blocks.
+/// \param p [OUT] Buffer of nBlocks blocks.
+
+static void BlockThread(uint32_t i, uint32_t nThreads, const Cayley32c* warm,
+  uint128w_t key, uint64_t nBlocks, uint64_t* p)
+{
+  PinThread(i);
+
+  Cayley32c cayley32c; //new counter-based PRNG
+  cayley32c.ShareTables(*warm);
+  cayley32c.srand(key);
+
+  for(uint64_t b=i; b<nBlocks; b+=nThreads)
+    cayley32c.GetBlock(b, p + b*Cayley32c::m_nBlockSize);
+} //BlockThread
+
+/// \brief Block-parallel generation benchmark.
+///
+/// Generate a stream of Cayley32c into a buffer on a single thread, then
+/// generate it again block-parallel on \f$N\f$ pinned threads for
+/// \f$1 \leq N \leq c\f$, where \f$c\f$ is the number of logical cores,
+/// and print a table of the throughput and whether the result is identical
+/// to the single-threaded one. Also time Cayley32 on the same number of
+/// words for comparison, since each block of Cayley32c costs some extra
+/// steps to set up.
+/// \param seed Seed, used as the key.
+/// \param n Number of 64-bit words to generate, rounded up to whole blocks.
+
+void BlockBenchmark(const uintx_t& seed, uint64_t n){
+  const uint32_t nCores = GetCoreCount(); //number of logical cores
+  const uint64_t nBlockSize = Cayley32c::m_nBlockSize; //words per block
+  const uint64_t nBlocks = (n + nBlockSize - 1)/nBlockSize; //number of blocks
+  const uint64_t nWords = nBlocks*nBlockSize; //number of words
+  const double bytes = double(nWords*sizeof(uint64_t)); //bytes generated
+
+  const uint128w_t key = uint128w_t((uint64_t)seed) |
+    (uint128w_t((uint64_t)(seed >> 64)) << 64); //low 128 bits of seed
+
+  std::vector<uint64_t> serial(nWords); //single-threaded stream
+  std::vector<uint64_t> parallel(nWords); //block-parallel stream
+
+  printf("Block-parallel Cayley32c on 1 to %u threads, ", nCores);
+  printf("%" PRIu64 " blocks of %" PRIu64 " words.\n", nBlocks, nBlockSize);
+
+  Cayley32 cayley32; //new PRNG with fixed generators, for comparison
+  cayley32.srand(key);
+
+  uint64_t t0 = WallTimeInNanoseconds(); //start time
+  cayley32.fill(serial.data(), nWords);
+  printf("Cayley32 fill(), 1 thread: %0.3f GB/s\n",
+    bytes/double(std::max(WallTimeInNanoseconds() - t0, uint64_t(1))));
+
+  Cayley32c warm; //owner of the power tables
+  warm.srand(key);
+
+  t0 = WallTimeInNanoseconds();
+  warm.fill(serial.data(), nWords);
+  printf("Cayley32c fill(), 1 thread: %0.3f GB/s\n",
+    bytes/double(std::max(WallTimeInNanoseconds() - t0, uint64_t(1))));
+
+  printf("Threads   Total GB/s  Efficiency  Identical\n");
+  double base = 0; //single-thread throughput
+
+  for(uint32_t nThreads=1; nThreads<=nCores; nThreads++){
+    std::fill(parallel.begin(), parallel.end(), 0);
+    std::vector<std::thread> threads; //the threads
+
+    t0 = WallTimeInNanoseconds();
+
+    for(uint32_t i=0; i<nThreads; i++)
+      threads.push_back(std::thread(BlockThread, i, nThreads, &warm, key,
+        nBlocks, parallel.data()));
+
+    for(auto& t: threads)
+      t.join();
+
+    const uint64_t t = std::max(WallTimeInNanoseconds() - t0, uint64_t(1));
+    const double total = bytes/double(t); //throughput
+    if(nThreads == 1)base = total;
+
+    printf("%7u %12.3f %11.2f  %s\n", nThreads, total, total/(nThreads*base),
+      parallel == serial? "yes": "NO");
+  } //for
+} //BlockBenchmark
+
+#pragma endregion blocks
+
+///////////////////////////////////////////////////////////////////////////////
+//Bank of streams
+
+#pragma region bank
+
+/// \brief Bank of streams benchmark.
+///
+/// Compare a CCayleyBank of \f$2^{17}\f$ streams, about as many as the
+/// entities of a large agent-based simulation, with one Cayley32 object
+/// per stream on the heap, all sharing one set of power tables and seeded
+/// alike, first taking a word from every stream in order, then from a
+/// pseudorandom quarter of them. Print a table of the time per word and
+/// whether the two give the same words, and the memory used per stream.
+/// \param seed Seed for the bank, of which the low 128 bits are used.
+/// \param n Number of 64-bit words to generate for each measurement.
+
+void BankBenchmark(const uintx_t& seed, uint64_t n){
+  const size_t nStreams = 131072; //number of streams
+  const uint64_t nRounds = std::max(n/nStreams, uint64_t(1)); //rounds
+
+  const uint128w_t key = uint128w_t((uint64_t)seed) |
+    (uint128w_t((uint64_t)(seed >> 64)) << 64); //low 128 bits of seed
+
+  Cayley32 owner; //owner of the power tables
+  owner.BuildTables();
+
+  CCayleyBank bank(nStreams); //the bank
+  bank.ShareTables(owner);
+  bank.srand(key);
+
+  std::vector<Cayley32*> object(nStreams); //one Cayley32 per stream
+
+  for(size_t i=0; i<nStreams; i++){
+    object[i] = new Cayley32;
+    object[i]->ShareTables(owner);
+    object[i]->srand(CCayleyBank::GetSeed(key, i));
+  } //for
+
+  CMersenneTwister mt((uint64_t)seed); //for the subset
+  std::vector<uint32_t> index(nStreams/4); //pseudorandom quarter, with repeats
+  for(auto& i: index)
+    i = uint32_t(mt()%nStreams);
+
+  std::vector<uint64_t> buffer(nStreams); //output of a round
+
+  printf("Bank of %zu Cayley32 streams, %" PRIu64 " rounds ", nStreams, nRounds);
+  printf("per measurement.\n");
+  printf("Bytes per stream: bank %zu, Cayley32 object at least %zu.\n",
+    bank.GetBytes()/nStreams, sizeof(Cayley32) + sizeof(CPerm) + 32);
+  printf("Streams           Objects ns  Bank ns  Speedup  Identical\n");
+
+  for(int subset=0; subset<2; subset++){
+    const size_t m = subset? index.size(): nStreams; //words per round
+    uint64_t h0 = 0, h1 = 0; //hashes of the output of each
+
+    uint64_t t0 = WallTimeInNanoseconds(); //start time
+
+    for(uint64_t r=0; r<nRounds; r++){
+      if(subset)
+        for(size_t j=0; j<m; j++)
+          buffer[j] = object[index[j]]->rand();
+
+      else for(size_t j=0; j<m; j++)
+        buffer[j] = object[j]->rand();
+
+      for(size_t j=0; j<m; j++)
+        h0 = (h0 ^ buffer[j])*0x100000001B3ULL;
+    } //for
+
+    const uint64_t t1 = WallTimeInNanoseconds(); //end of objects
+
+    for(uint64_t r=0; r<nRounds; r++){
+      if(subset)bank.fill(index.data(), m, buffer.data());
+      else bank.fill(buffer.data());
+
+      for(size_t j=0; j<m; j++)
+        h1 = (h1 ^ buffer[j])*0x100000001B3ULL;
+    } //for
+
+    const uint64_t t2 = WallTimeInNanoseconds(); //end of bank
+
+    const double words = double(m*nRounds); //words generated by each
+    const double ns0 = double(t1 - t0)/words; //objects
+    const double ns1 = double(std::max(t2 - t1, uint64_t(1)))/words; //bank
+
+    printf("%-16s %11.2f %8.2f %7.2fx  %s\n", subset? "random quarter":
+      "all, in order", ns0, ns1, ns0/ns1, h0 == h1? "yes": "NO");
+  } //for
+
+  for(auto p: object)
+    delete p;
+} //BankBenchmark
+
+#pragma endregion bank
+
+///////////////////////////////////////////////////////////////////////////////
+//Parallel shuffle
+
+#pragma region shuffle
+
+/// \brief Parallel shuffle benchmark.
+///
+/// Shuffle an array of 32-bit elements with a serial Fisher-Yates shuffle
+/// that takes one Cayley32 word and one remainder per element, then with
+/// CShuffle on 1, 2, 3, ... threads, up to the number of logical cores,
+/// seeded alike each time. Print a table of the time per element, the
+/// speedup over the serial shuffle, whether the result is a permutation of
+/// the input, and whether CShuffle gives the same result on every number
+/// of threads.
+/// \param seed Seed, of which the low 128 bits are used.
+/// \param n Number of elements.
+
+void ShuffleBenchmark(const uintx_t& seed, uint64_t n){
+  const uint32_t nCores = GetCoreCount(); //number of logical cores
+  const uint128w_t key = uint128w_t((uint64_t)seed) |
+    (uint128w_t((uint64_t)(seed >> 64)) << 64); //low 128 bits of seed
+
+  std::vector<uint32_t> a(n); //array to shuffle
+  std::vector<uint32_t> first; //result on one thread
+  std::vector<uint8_t> seen(n); //for checking the result
+
+  //whether a is a permutation of 0, 1, ..., n - 1
+  auto valid = [&](){
+    std::fill(seen.begin(), seen.end(), 0);
+
+    for(uint32_t x: a)
+      if(x >= n || seen[x]++)return false;
+
+    return true;
+  }; //valid
+
+  printf("Shuffle of %" PRIu64 " 32-bit elements on 1 to %u threads.\n",
+    n, nCores);
+  printf("Method        Threads  ns/element  Speedup  Permutation  Identical\n");
+
+  Cayley32 cayley32; //for the serial shuffle
+  cayley32.srand(key);
+
+  for(uint64_t i=0; i<n; i++)
+    a[i] = uint32_t(i);
+
+  uint64_t t0 = WallTimeInNanoseconds(); //start time
+
+  for(uint64_t i=n-1; i>0; i--)
+    std::swap(a[i], a[cayley32.rand()%(i + 1)]);
+
+  const double base = double(std::max(WallTimeInNanoseconds() - t0,
+    uint64_t(1)))/n; //serial time per element
+
+  printf("Fisher-Yates  %7u %11.2f %7.2fx  %-11s  -\n", 1, base, 1.0,
+    valid()? "yes": "NO");
+
+  CShuffle shuffle; //parallel shuffle
+  shuffle.BuildTables();
+
+  for(uint32_t nThreads=1; nThreads<=nCores; nThreads++){
+    for(uint64_t i=0; i<n; i++)
+      a[i] = uint32_t(i);
+
+    shuffle.SetThreads(nThreads);
+    shuffle.srand(key);
+
+    t0 = WallTimeInNanoseconds();
+    shuffle.shuffle(a.data(), n);
+
+    const double t = double(std::max(WallTimeInNanoseconds() - t0,
+      uint64_t(1)))/n; //time per element
+
+    if(nThreads == 1)first = a;
+
+    printf("CShuffle      %7u %11.2f %7.2fx  %-11s  %s\n", nThreads, t,
+      base/t, valid()? "yes": "NO", a == first? "yes": "NO");
+  } //for
+} //ShuffleBenchmark
+
+#pragma endregion shuffle
+
+///////////////////////////////////////////////////////////////////////////////
+//Wide permutations
+
+#pragma region wide
+
+/// \brief Wide permutation benchmark.
+///
+/// Time composition, inversion, cycle decomposition, and powers of a pair
+/// of pseudo-random CWidePerm<uint32_t> on 1, 2, 3, ... threads, up to the
+/// number of logical cores, with and without blocking. The cycle
+/// decomposition is compared with a plain walk along each cycle in turn.
+/// Print a table of the time per map entry and whether the result is the
+/// same as on one thread without blocking. Then time the wide Cayley PRNG
+/// over \f$S_{256}\f$, \f$S_{4096}\f$, \f$S_{65536}\f$, and \f$S_n\f$.
+/// \param seed Seed, of which the low 64 bits are used.
+/// \param n Permutation size.
+
+void WideBenchmark(const uintx_t& seed, uint64_t n){
+  const uint32_t nCores = GetCoreCount(); //number of logical cores
+  const size_t block = CWidePerm<uint32_t>::GetBlockSize(); //default
+  CMersenneTwister mt((uint64_t)seed); //for the permutations
+
+  CWidePerm<uint32_t> p(n), q(n); //operands
+  p.Randomize(mt);
+  q.Randomize(mt);
+
+  CWidePerm<uint32_t> r; //result
+  CWideCycles<uint32_t> cycles; //cycles of p
+  std::vector<uint32_t> power(n); //map of a power of p
+  const uint64_t k = mt(); //exponent of the power
+
+  //time f once, in nanoseconds per entry
+  auto time = [&](const auto& f){
+    const uint64_t t0 = WallTimeInNanoseconds(); //start time
+    f();
+    return double(std::max(WallTimeInNanoseconds() - t0, uint64_t(1)))/n;
+  }; //time
+
+  printf("Wide permutations of size %" PRIu64 " on 1 to %u threads.\n",
+    n, nCores);
+  printf("Operation  Blocking  Threads  ns/entry  Identical\n");
+
+  //compose
+  std::vector<uint32_t> first; //result on one thread without blocking
+
+  for(uint32_t nThreads=1; nThreads<=nCores; nThreads++){
+    r = p;
+    const double t = time([&](){r.Compose(q.GetMap(), nThreads);});
+    const std::vector<uint32_t> v(r.GetMap(), r.GetMap() + n); //result
+    if(nThreads == 1)first = v;
+    printf("compose    %-8s %8u %9.2f  %s\n", "none", nThreads, t,
+      v == first? "yes": "NO");
+  } //for
+
+  //invert
+  for(size_t b: {size_t(0), block}){
+    CWidePerm<uint32_t>::SetBlockSize(b);
+
+    for(uint32_t nThreads=1; nThreads<=nCores; nThreads++){
+      const double t = time([&](){p.Invert(r, nThreads);});
+      const std::vector<uint32_t> v(r.GetMap(), r.GetMap() + n); //result
+      if(b == 0 && nThreads == 1)first = v;
+      printf("invert     %-8s %8u %9.2f  %s\n", b? "blocked": "none",
+        nThreads, t, v == first? "yes": "NO");
+    } //for
+  } //for
+
+  //cycles
+  std::vector<bool> seen(n); //for the plain walk
+  std::vector<uint32_t> walk(n); //elements in the order of the plain walk
+
+  const double tWalk = time([&](){
+    size_t j = 0; //next element
+    const uint32_t* m = p.GetMap(); //shorthand for the map
+
+    for(size_t i=0; i<n; i++)
+      for(size_t x=i; !seen[x]; x=m[x]){
+        seen[x] = true;
+        walk[j++] = uint32_t(x);
+      } //for
+  }); //time
+
+  first = walk;
+  printf("cycles     %-8s %8u %9.2f  %s\n", "walk", 1, tWalk, "yes");
+
+  for(uint32_t nThreads=1; nThreads<=nCores; nThreads++){
+    const double t = time([&](){cycles.Initialize(p, nThreads);});
+    std::vector<uint32_t> v; //elements of the cycles in order
+
+    for(size_t i=0; i<cycles.GetCount(); i++)
+      v.insert(v.end(), cycles.GetCycle(i),
+        cycles.GetCycle(i) + cycles.GetLength(i));
+
+    printf("cycles     %-8s %8u %9.2f  %s\n", "walkers", nThreads, t,
+      v == first? "yes": "NO");
+  } //for
+
+  //power
+  for(size_t b: {size_t(0), block}){
+    CWidePerm<uint32_t>::SetBlockSize(b);
+
+    for(uint32_t nThreads=1; nThreads<=nCores; nThreads++){
+      const double t = time([&](){cycles.GetPower(k, power.data(), nThreads);});
+      if(b == 0 && nThreads == 1)first = power;
+      printf("power      %-8s %8u %9.2f  %s\n", b? "blocked": "none",
+        nThreads, t, power == first? "yes": "NO");
+    } //for
+  } //for
+
+  CWidePerm<uint32_t>::SetBlockSize(block);
+
+  //the wide Cayley PRNG, timed over enough words for about 2^24 entries
+  printf("\nWide Cayley PRNG\n");
+  printf("Size       Threads  ns/word  ns/entry\n");
+
+  for(uint64_t size: {uint64_t(256), uint64_t(4096), uint64_t(65536), n}){
+    const uint64_t words = std::max(uint64_t(16777216)/size, uint64_t(4));
+    double t = 0; //time per word
+    uint32_t nThreads = 1; //threads used
+
+    if(size <= 65536){ //16-bit maps
+      CCayleyWide<uint16_t> cayley(size_t(size), nCores);
+      cayley.srand(mt);
+      const uint64_t t0 = WallTimeInNanoseconds(); //start time
+      for(uint64_t i=0; i<words; i++)cayley.rand();
+      t = double(WallTimeInNanoseconds() - t0)/words;
+    } //if
+
+    else{ //32-bit maps
+      CCayleyWide<uint32_t> cayley(size_t(size), nCores);
+      cayley.srand(mt);
+      nThreads = size >= 262144? nCores: 1;
+      const uint64_t t0 = WallTimeInNanoseconds(); //start time
+      for(uint64_t i=0; i<words; i++)cayley.rand();
+      t = double(WallTimeInNanoseconds() - t0)/words;
+    } //else
+
+    printf("%-10" PRIu64 " %7u %8.0f %9.2f\n", size, nThreads, t, t/size);
+  } //for
+} //WideBenchmark
+
+#pragma endregion wide
@@ -0,0 +1,23 @@
+/// \file Benchmark.h
+/// \brief Declaration of the benchmarks.
+
+#ifndef __benchmark__
+#define __benchmark__
+
+#include "uintx_t.h"
+
+/// \brief Which threads get their own copy of the power tables.
+
+enum class TableMode{
+  Core, Node, Shared
+}; //TableMode
+
+void ScalingBenchmark(const uintx_t& seed, uint64_t n, TableMode mode); ///< Multi-core scaling.
+void BaselineBenchmark(const uintx_t& seed, uint64_t n); ///< Compare with other PRNGs.
+void LatencyBenchmark(const uintx_t& seed, uint64_t n); ///< Per-call latency.
+void BlockBenchmark(const uintx_t& seed, uint64_t n); ///< Block-parallel generation.
+void BankBenchmark(const uintx_t& seed, uint64_t n); ///< Bank of streams.
+void ShuffleBenchmark(const uintx_t& seed, uint64_t n); ///< Parallel shuffle.
+void WideBenchmark(const uintx_t& seed, uint64_t n); ///< Wide permutations.
+
+#endif
@@ -1,5 +1,5 @@
 /// \file CPUtime.cpp
-/// \brief Cross-platform code for getting CPU time.
+/// \brief Cross-platform code for getting CPU time and wall clock time.
 
 #include <cinttypes>
 
@@ -38,6 +38,25 @@ uint64_t CPUTimeInNanoseconds(){
   return 100LL*CPUTimeInCentiNanoseconds();
 } //CPUTimeInNanoseconds
 
+/// Get the time from a monotonic high-resolution clock in nanoseconds.
+/// Unlike CPU time, this is meaningful when several threads are running.
+/// \return Wall clock time in nanoseconds from an arbitrary starting point.
+
+uint64_t WallTimeInNanoseconds(){
+  static LARGE_INTEGER freq = {0}; //performance counter frequency
+
+  if(freq.QuadPart == 0)
+    QueryPerformanceFrequency(&freq);
+
+  LARGE_INTEGER t; //performance counter
+  QueryPerformanceCounter(&t);
+
+  const uint64_t sec = t.QuadPart/freq.QuadPart; //whole seconds
+  const uint64_t rem = t.QuadPart%freq.QuadPart; //remaining ticks
+
+  return 1000000000LL*sec + (1000000000LL*rem)/freq.QuadPart;
+} //WallTimeInNanoseconds
+
 #else//other OS
 
 #include <time.h>
@@ -49,4 +68,14 @@ uint64_t CPUTimeInNanoseconds(){
   return clock()*(1000000000LL/CLOCKS_PER_SEC);
 } //CPUTimeInNanoseconds
 
+/// Get the time from a monotonic high-resolution clock in nanoseconds.
+/// Unlike CPU time, this is meaningful when several threads are running.
+/// \return Wall clock time in nanoseconds from an arbitrary starting point.
+
+uint64_t WallTimeInNanoseconds(){
+  timespec t; //current time
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return 1000000000LL*t.tv_sec + t.tv_nsec;
+} //WallTimeInNanoseconds
+
 #endif
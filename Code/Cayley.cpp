@@ -3,6 +3,8 @@
 
 #include "Includes.h"
 #include "Cayley.h"
+#include "mt19937-64.h"
+#include "Metrics.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 //Useful constants
@@ -27,13 +29,34 @@ extern const uint32_t g_nLandau[] = {
  1021020, 1021020, 1141140, 1141140, 2042040  //g(60-64)
 }; //g_nLandau
 
+/// \brief Initial contents of the delay line.
+
+extern const uint64_t g_nDelayLineInit[32] = { 
+  0x57ea5e79bb7b58dc, 0x03198e239ff8ba7d,
+  0x7779bd2aeb666379, 0x5de2cf0e048781c3,
+  0x89faeceacabe7821, 0xbf5a9b43b4e550ae,
+  0x24e37a696814c67e, 0x45e199269f6ad385,
+  0xf1df54ec42d8fba8, 0x089f41735277a11d,
+  0x602c3888033edae0, 0xc71fee188d41a646,
+  0x379121f47085af73, 0x9419d15d410b8eeb,
+  0x760744f26b4c05b0, 0x3c68c1fb83c9a47e,
+  0xa10d29f01e2f225e, 0x39792d6f9700f5cb,
+  0xf5016c43b32d066c, 0x692d0a2cbcc083c0,
+  0x229bfc31ea3beeff, 0xe9e6fd8bbf4033b8,
+  0x74e8c4ad7bd95bd0, 0xeedb9cede270c79b,
+  0x9abd1906822b22ac, 0x3b57c6458e330f89,
+  0x7fc8519dfd26353d, 0x2874406cd5a54ba0,
+  0x9fe7daf93fe577a2, 0x83d1c7bb3d29cd1f,
+  0xbb2d2cbb68483f3d, 0x39af233d402946ec
+}; //g_nDelayLineInit
+
 #pragma endregion constants
 
 ///////////////////////////////////////////////////////////////////////////////
 //CCayley functions
 
-/// Construct the current permutation and set the order of the generators using
-/// the Landau table.
+/// Construct the current permutation and the power tables, and set the order
+/// of the generators using the Landau table.
 /// \param n The permutation size.
 
 CCayley::CCayley(uint32_t n):
@@ -42,67 +65,255 @@ CCayley::CCayley(uint32_t n):
   assert(n < 64); //for safety: this is the size of our Landau table.
   m_nOrder = g_nLandau[n];
   m_pCurPerm = new CPerm(n);
+  m_pPower = new CPowerTable[2];
+  ResetDelayLine();
+  METRIC_ADD(Streams, 1);
 } //constructor
 
-/// The destructor.
+/// The destructor. The power tables are deleted only if they are our own.
 
 CCayley::~CCayley(){
+  #ifdef CAYLEY_METRICS
+    METRIC_ADD(StreamWords, m_nWords);
+  #endif
+
+  METRIC_SUB(Streams, 1);
   delete m_pCurPerm;
+
+  if(!m_bSharedTables)
+    delete [] m_pPower;
 } //destructor
 
+/// Put the delay line, its tail, and the generator parity back into their
+/// initial states, so that reseeding gives the same stream as seeding
+/// a new instance.
+
+void CCayley::ResetDelayLine(){
+  static_assert(sizeof(g_nDelayLineInit) == sizeof(m_nDelayLine),
+    "Delay line initializer has the wrong size");
+
+  memcpy(m_nDelayLine, g_nDelayLineInit, sizeof(m_nDelayLine));
+  m_nTail = 0;
+  m_nParity = 0;
+} //ResetDelayLine
+
+/// Update the metrics when the generator is reseeded, adding the number of
+/// words generated since the last reseed to the total for all streams.
+/// This compiles to nothing unless metrics or tracing are enabled.
+
+void CCayley::Reseeded(){
+  METRIC_ADD(SrandCalls, 1);
+  TRACE1(srand, m_nSize);
+
+  #ifdef CAYLEY_METRICS
+    METRIC_ADD(StreamWords, m_nWords);
+    m_nWords = 0;
+  #endif
+} //Reseeded
+
+/// Get the number of steps of the walk taken since the generator was last
+/// seeded, which is the number of words generated plus any discarded.
+/// \return Number of steps, or 0 if metrics are not compiled in.
+
+uint64_t CCayley::GetWordCount() const{
+  #ifdef CAYLEY_METRICS
+    return m_nWords;
+  #else
+    return 0;
+  #endif
+} //GetWordCount
+
+/// Use the generators and power tables of another instance instead of our
+/// own, so that many instances can share a single copy of the tables. The
+/// other instance must have the same permutation size, must already have
+/// been seeded, and must outlive this one. Neither instance should choose
+/// new generators after this.
+/// \param c The instance whose power tables are to be shared.
+
+void CCayley::ShareTables(const CCayley& c){
+  assert(c.m_nSize == m_nSize); //safety
+  assert(c.m_pPower[0].GetOrder() > 0); //safety
+
+  if(!m_bSharedTables)
+    delete [] m_pPower;
+
+  m_pPower = c.m_pPower;
+  m_bSharedTables = true;
+} //ShareTables
+
+/// Set the number of steps ahead for which the power-table entry is to be
+/// prefetched by NextPerm(). The exponent of each step is in the delay line
+/// \f$d\f$ places after the tail, where it was put \f$32 - d\f$ steps ago,
+/// so the entries needed by the next 31 steps are always known.
+/// Prefetching does not change the output.
+/// \param d Prefetch distance in steps, \f$0 \leq d < 32\f$, 0 to disable.
+
+void CCayley::SetPrefetch(int d){
+  m_nPrefetch = std::max(0, std::min(d, m_nDelay - 1));
+} //SetPrefetch
+
+/// Reader function for the prefetch distance.
+/// \return Number of steps ahead that power-table entries are prefetched.
+
+int CCayley::GetPrefetch() const{
+  return m_nPrefetch;
+} //GetPrefetch
+
 /// Reader function for the generators.
 /// \param i Generator number, either 0 or 1.
 /// \return Hex string of generator reverse lexicographic number.
 
 CPerm CCayley::GetGenerator(int i) const{
   assert(i == 0 || i == 1);
-  return CPerm(m_nPower[i][1]);
+  return CPerm(m_pPower[i][1]);
 } //Generator
 
+/// Reader function for the power tables, so that other code can walk with
+/// the same generators without copying the tables.
+/// \param i Generator number, either 0 or 1.
+/// \return Power table of that generator.
+
+const CPowerTable& CCayley::GetPowerTable(int i) const{
+  assert(i == 0 || i == 1);
+  return m_pPower[i];
+} //GetPowerTable
+
 /// Choose a pair of pseudorandom odd permutations of maximal order that have
 /// no common fixed point. It is unlikely that a pair of random permutations
 /// will have the same fixed point but it is possible. Build tables of powers
 /// of these generators to speed up the computation.
-/// \param rnd An external PRNG for seeding.
+/// \param rnd An external PRNG for seeding, either a function or an instance
+/// of a class with operator().
 
-void CCayley::ChooseGenerators(uint64_t (*rnd)(void)){
-  assert(rnd != nullptr); //safety
+template<class rng_t> void CCayley::ChooseGenerators(rng_t& rnd){
+  assert(!m_bSharedTables); //safety
 
   CPerm p(m_nSize); //current permutation
   bool ok = false; //whether chosen permutations are ok
 
+  #if defined(CAYLEY_METRICS) || defined(CAYLEY_USDT)
+    const uint64_t t0 = MetricClock(); //start time
+    uint64_t nCandidates = 0; //number of candidate generators
+  #endif
+
+  METRIC_ADD(ChooseCalls, 1);
+  TRACE1(choose__start, m_nSize);
+
   while(!ok){
     do{ //choose the first generator; a max-order pseudo-random permutation
       p.Randomize(rnd); //choose a pseudorandom permutation 
-      m_nPower[0].Initialize(p); //initialize its power table and its order
-    }while(m_nPower[0].GetOrder() < m_nOrder); //insist on max order
+      m_pPower[0].Initialize(p); //initialize its power table and its order
+
+      #if defined(CAYLEY_METRICS) || defined(CAYLEY_USDT)
+        nCandidates++;
+      #endif
+
+      if(m_pPower[0].GetOrder() < m_nOrder)
+        METRIC_ADD(ChooseRejectedOrder, 1);
+    }while(m_pPower[0].GetOrder() < m_nOrder); //insist on max order
 
     do{ //choose the second generator; a max-order pseudo-random odd permutation
       p.RandomizeOdd(rnd); //choose a pseudorandom odd permutation
-      m_nPower[1].Initialize(p); //initialize its power table and its order
-    }while(m_nPower[1].GetOrder() < m_nOrder); //insist on max order
+      m_pPower[1].Initialize(p); //initialize its power table and its order
+
+      #if defined(CAYLEY_METRICS) || defined(CAYLEY_USDT)
+        nCandidates++;
+      #endif
+
+      if(m_pPower[1].GetOrder() < m_nOrder)
+        METRIC_ADD(ChooseRejectedOrder, 1);
+    }while(m_pPower[1].GetOrder() < m_nOrder); //insist on max order
 
     //reject the generators if they have a common fixed point
 
     ok = true; //ok so far
 
-    const CPerm& p0 = m_nPower[0][1]; //shorthand for first generator
-    const CPerm& q0 = m_nPower[1][1]; //shorthand for second generator
+    const CPerm& p0 = m_pPower[0][1]; //shorthand for first generator
+    const CPerm& q0 = m_pPower[1][1]; //shorthand for second generator
 
     for(uint32_t i=0; i<m_nSize; i++)
       ok = ok && !(p0[i] == i && q0[i] == i);
+
+    if(!ok)
+      METRIC_ADD(ChooseRejectedFixed, 1);
   } //while
+
+  #if defined(CAYLEY_METRICS) || defined(CAYLEY_USDT)
+    const uint64_t t = MetricClock() - t0; //elapsed time
+    METRIC_ADD(ChooseCandidates, nCandidates);
+    METRIC_ADD(ChooseNanoseconds, t);
+    TRACE2(choose__done, nCandidates, t);
+  #endif
 } //ChooseGenerators
 
 /// Initialize the pseudo-random number generator by choosing the generators
 /// and the initial permutation.
-/// \param rand An external random number generator to use as a seed.
+/// \param rand An external random number generator to use as a seed, either
+/// a function or an instance of a class with operator().
 
-void CCayley::srand(uint64_t (*rand)(void)){
+template<class rng_t> void CCayley::srand(rng_t& rand){
+  Reseeded();
+  ResetDelayLine(); //same stream as a new instance
   ChooseGenerators(rand); //random generators
   m_pCurPerm->Randomize(rand); //random permutations
 } //Initialize
 
+/// Get the number of bytes needed by SaveState().
+/// \return Size of the saved state in bytes.
+
+size_t CCayley::GetStateSize() const{
+  return m_nSize + m_nDelay*sizeof(uint64_t) + 2;
+} //GetStateSize
+
+/// Save the state of the generator, that is, the current permutation, the
+/// delay line, the index of its tail, and the generator parity, in a
+/// portable byte order. The generators are not part of the state. 
+/// \param p [OUT] Buffer of at least GetStateSize() bytes.
+
+void CCayley::SaveState(uint8_t* p) const{
+  for(uint32_t i=0; i<m_nSize; i++)
+    *p++ = (*m_pCurPerm)[i];
+
+  for(int i=0; i<m_nDelay; i++) //delay line, little-endian
+    for(int j=0; j<8; j++)
+      *p++ = uint8_t(m_nDelayLine[i] >> (8*j));
+
+  *p++ = uint8_t(m_nTail);
+  *p++ = uint8_t(m_nParity);
+} //SaveState
+
+/// Load a state saved by SaveState() from an instance with the same
+/// permutation size and generators. 
+/// \param p Buffer of GetStateSize() bytes.
+/// \return true If the state is valid, otherwise it is not loaded.
+
+bool CCayley::LoadState(const uint8_t* p){
+  std::vector<bool> seen(m_nSize, false); //to check for a permutation
+
+  for(uint32_t i=0; i<m_nSize; i++){
+    if(p[i] >= m_nSize || seen[p[i]])return false; //not a permutation
+    seen[p[i]] = true;
+  } //for
+
+  const uint8_t* q = p + m_nSize + m_nDelay*sizeof(uint64_t); //tail and parity
+  if(q[0] >= m_nDelay || q[1] > 1)return false; //out of range
+
+  *m_pCurPerm = CPerm(m_nSize, (uint8_t*)p);
+  p += m_nSize;
+
+  for(int i=0; i<m_nDelay; i++){ //delay line, little-endian
+    m_nDelayLine[i] = 0;
+
+    for(int j=0; j<8; j++)
+      m_nDelayLine[i] |= uint64_t(*p++) << (8*j);
+  } //for
+
+  m_nTail = q[0];
+  m_nParity = q[1];
+
+  return true;
+} //LoadState
+
 /// Reader function for the current permutation.
 /// \return Const reference to the current permutation.
 
@@ -121,16 +332,32 @@ const uint32_t CCayley::GetSize() const{
 /// Generate the next pseudo-random permutation as follows.
 /// Get the exponent \f$k\f$ from the delay line and multiply the current
 /// permutation \f$\phi\f$ by the current generator \f$\sigma_i\f$ to the power
-/// \f$k\f$.
+/// \f$k\f$. If the prefetch distance \f$d\f$ is not zero, first start
+/// loading the power that will be needed \f$d\f$ steps from now, so that
+/// its cache misses overlap this step instead of stalling that one.
 ///
 /// \image html before.jpg
 
 void CCayley::NextPerm(){
-  static unsigned int i = 0; //generator parity; determines current generator 
+  if(m_nPrefetch > 0){ //prefetch a future power
+    const uint64_t e = m_nDelayLine[(m_nTail + m_nPrefetch)%m_nDelay];
+    m_pPower[m_nParity ^ (m_nPrefetch & 1)].Prefetch(int(e%m_nOrder));
+  } //if
+
+  #ifdef CAYLEY_METRICS
+    m_nWords++;
+  #endif
+
   CPerm& perm = *m_pCurPerm; //shorthand for the current permutation
   const uint32_t k = m_nDelayLine[m_nTail]%m_nOrder; //exponent
 
-  perm *= m_nPower[i][k]; //multiply by generator i to the power k
-  i ^= 1; //flip generator parity
-  assert(i < 2); //safety
+  perm *= m_pPower[m_nParity].GetMap(k); //multiply by generator to the power k
+  m_nParity ^= 1; //flip generator parity
+  assert(m_nParity < 2); //safety
 } //NextPerm
+
+/////////////////////////////////////////////////////////////////////////////
+//explicit template instantiations
+
+template void CCayley::srand<uint64_t(void)>(uint64_t (&)(void));
+template void CCayley::srand<CMersenneTwister>(CMersenneTwister&);
@@ -26,42 +26,43 @@ class CCayley{
     uint32_t m_nSize = 0; ///< Size of permutations.
 
     uint32_t m_nOrder = 0; ///< Order of generators.
-    CPowerTable m_nPower[2]; ///< Power tables for a pair of generators.
+    CPowerTable* m_pPower = nullptr; ///< Power tables for a pair of generators.
+    bool m_bSharedTables = false; ///< Whether the power tables are borrowed.
     CPerm* m_pCurPerm = nullptr; ///< Current permutation.
     
     static const int m_nDelay = 32; ///< Delay size.
 
-    uint64_t m_nDelayLine[m_nDelay] = { 
-      0x57ea5e79bb7b58dc, 0x03198e239ff8ba7d,
-      0x7779bd2aeb666379, 0x5de2cf0e048781c3,
-      0x89faeceacabe7821, 0xbf5a9b43b4e550ae,
-      0x24e37a696814c67e, 0x45e199269f6ad385,
-      0xf1df54ec42d8fba8, 0x089f41735277a11d,
-      0x602c3888033edae0, 0xc71fee188d41a646,
-      0x379121f47085af73, 0x9419d15d410b8eeb,
-      0x760744f26b4c05b0, 0x3c68c1fb83c9a47e,
-      0xa10d29f01e2f225e, 0x39792d6f9700f5cb,
-      0xf5016c43b32d066c, 0x692d0a2cbcc083c0,
-      0x229bfc31ea3beeff, 0xe9e6fd8bbf4033b8,
-      0x74e8c4ad7bd95bd0, 0xeedb9cede270c79b,
-      0x9abd1906822b22ac, 0x3b57c6458e330f89,
-      0x7fc8519dfd26353d, 0x2874406cd5a54ba0,
-      0x9fe7daf93fe577a2, 0x83d1c7bb3d29cd1f,
-      0xbb2d2cbb68483f3d, 0x39af233d402946ec
-    }; ///< Delay line.
+    uint64_t m_nDelayLine[m_nDelay]; ///< Delay line.
 
     int m_nTail = 0; ///< Index of last element in delay line.
+    uint32_t m_nParity = 0; ///< Generator parity; determines current generator.
+    int m_nPrefetch = 0; ///< How many steps ahead to prefetch, 0 for none.
 
-    void ChooseGenerators(uint64_t (*rnd)(void)); ///< Choose generators.
+    #ifdef CAYLEY_METRICS
+      uint64_t m_nWords = 0; ///< Steps taken since the last reseed.
+    #endif
+
+    void ResetDelayLine(); ///< Reset the delay line to its initial state.
+    void Reseeded(); ///< Update the metrics for a reseed.
+    template<class rng_t> void ChooseGenerators(rng_t& rnd); ///< Choose generators.
     void NextPerm(); ///< Compute next permutation.
 
   public:
     CCayley(uint32_t n); ///< Constructor.
     ~CCayley(); ///< Destructor.
 
-    virtual void srand(uint64_t (*rnd)(void)); ///< Seed the generator.
+    template<class rng_t> void srand(rng_t& rnd); ///< Seed the generator.
+    void ShareTables(const CCayley& c); ///< Share another instance's tables.
+    void SetPrefetch(int d); ///< Set the prefetch distance.
+    int GetPrefetch() const; ///< Get the prefetch distance.
+    uint64_t GetWordCount() const; ///< Get the number of steps since seeding.
+
+    size_t GetStateSize() const; ///< Get size of saved state.
+    void SaveState(uint8_t* p) const; ///< Save state.
+    bool LoadState(const uint8_t* p); ///< Load state.
 
     CPerm GetGenerator(int i) const; ///< Get generator.
+    const CPowerTable& GetPowerTable(int i) const; ///< Get power table.
     const CPerm& GetPerm() const; ///< Get current permutation.
     const uint32_t GetSize() const; ///< Get permutation size.
 }; //CCayley
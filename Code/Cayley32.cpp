@@ -3,6 +3,9 @@
 
 #include "Includes.h"
 #include "Cayley32.h"
+#include "Kernels.h"
+#include "Metrics.h"
+#include "Baselines.h"
 
 //////////////////////////////////////////////////////////////////////////////
 //Cayley32e functions
@@ -10,34 +13,31 @@
 Cayley32e::Cayley32e(): CCayley(32){
 } //constructor
 
-/// Generate a pseudo-random permutation and map it to a 64-bit unsigned int,
-/// as follows. Update the current permutation, then exclusive-or together
-/// the product of the permutation map entries times 32 random strings.
+/// \brief Multipliers for the output hash.
+///
 /// These strings are fixed in this implementation but they should be replaced
 /// and not be made public to protect against reverse engineering.
+
+extern const uint64_t g_nHashKey[32] = {
+  0x0d7e11b44d8e8161, 0x3d43a82e494a9972, 0x71b941e4c1557ec7, 0x56bf34559248d37c,
+  0x445db48764d3c5c8, 0xd2b96a4ba16b5c56, 0xb2bbaa127223e3da, 0x3232fd669cd2918e,
+  0x331d3d1bd619e971, 0x74b3680644295539, 0xb491addfb1af0f5b, 0xa3caa6455b313d54,
+  0xb6257e45a726fa52, 0xd413cd54747f43b1, 0x706873eeb3583e05, 0x3fd0d37b7f24589c,
+  0xc04cb886d76abce0, 0x3ecfdec3d519aedd, 0xbb4f1bccb25c3e51, 0xb1b80c550732d50f,
+  0x7c5015c795b5c8c2, 0xb2d8190706c770a8, 0x0d7e11b44d8e8161, 0x3d43a82e494a9972,
+  0x71b941e4c1557ec7, 0x56bf34559248d37c, 0x445db48764d3c5c8, 0xd2b96a4ba16b5c56,
+  0xb2bbaa127223e3da, 0x3232fd669cd2918e, 0x331d3d1bd619e971, 0x74b3680644295539
+}; //g_nHashKey
+
+/// Generate a pseudo-random permutation and map it to a 64-bit unsigned int,
+/// as follows. Update the current permutation, then exclusive-or together
+/// the product of the permutation map entries times 32 random strings,
+/// using the hash kernel selected for this CPU.
 /// \return A pseudo-random 64-bit unsigned integer.
 
 uint64_t Cayley32e::rand(){
   NextPerm(); //update current permutation
-  CPerm& perm = *m_pCurPerm; //shorthand for the current permutation
-  
-  uint64_t num = 
-    (perm[ 0]*0x0d7e11b44d8e8161) ^ (perm[ 1]*0x3d43a82e494a9972) ^ 
-    (perm[ 2]*0x71b941e4c1557ec7) ^ (perm[ 3]*0x56bf34559248d37c) ^ 
-    (perm[ 4]*0x445db48764d3c5c8) ^ (perm[ 5]*0xd2b96a4ba16b5c56) ^ 
-    (perm[ 6]*0xb2bbaa127223e3da) ^ (perm[ 7]*0x3232fd669cd2918e) ^ 
-    (perm[ 8]*0x331d3d1bd619e971) ^ (perm[ 9]*0x74b3680644295539) ^ 
-    (perm[10]*0xb491addfb1af0f5b) ^ (perm[11]*0xa3caa6455b313d54) ^ 
-    (perm[12]*0xb6257e45a726fa52) ^ (perm[13]*0xd413cd54747f43b1) ^ 
-    (perm[14]*0x706873eeb3583e05) ^ (perm[15]*0x3fd0d37b7f24589c) ^ 
-    (perm[16]*0xc04cb886d76abce0) ^ (perm[17]*0x3ecfdec3d519aedd) ^ 
-    (perm[18]*0xbb4f1bccb25c3e51) ^ (perm[19]*0xb1b80c550732d50f) ^ 
-    (perm[20]*0x7c5015c795b5c8c2) ^ (perm[21]*0xb2d8190706c770a8) ^
-    (perm[22]*0x0d7e11b44d8e8161) ^ (perm[23]*0x3d43a82e494a9972) ^ 
-    (perm[24]*0x71b941e4c1557ec7) ^ (perm[25]*0x56bf34559248d37c) ^
-    (perm[26]*0x445db48764d3c5c8) ^ (perm[27]*0xd2b96a4ba16b5c56) ^
-    (perm[28]*0xb2bbaa127223e3da) ^ (perm[29]*0x3232fd669cd2918e) ^
-    (perm[30]*0x331d3d1bd619e971) ^ (perm[31]*0x74b3680644295539); 
+  const uint64_t num = Hash32(m_pCurPerm->GetMap(), g_nHashKey); //hash it
         
   m_nDelayLine[m_nTail] = num; //enter into delay line
   m_nTail = (m_nTail + 1)%m_nDelay; //advance delay line
@@ -45,6 +45,17 @@ uint64_t Cayley32e::rand(){
   return num^m_nDelayLine[m_nTail]; //strengthen pseudo-random number
 } //rand
 
+/// Fill a buffer with pseudo-random 64-bit unsigned integers. This produces
+/// the same numbers as calling rand() repeatedly, but avoids the cost of a
+/// function call per number.
+/// \param p [OUT] Buffer.
+/// \param n Number of 64-bit words to generate.
+
+void Cayley32e::fill(uint64_t* p, size_t n){
+  for(size_t i=0; i<n; i++)
+    p[i] = rand();
+} //fill
+
 //////////////////////////////////////////////////////////////////////////////
 //Cayley32 functions
 
@@ -58,24 +69,309 @@ Cayley32::Cayley32(){
 /// A pair of fixed generators is used here, but they should be replaced
 /// and not be made public to protect against reverse engineering.
 /// CCayley::ChooseGenerators() will find generators that have a high
-/// probability of being strong.
+/// probability of being strong. Since the generators are fixed, the power
+/// tables are built only once, which also leaves shared tables alone.
 
 void Cayley32::ChooseGenerators(){ 
+  if(m_pPower[0].GetOrder() > 0)return; //already built
+
   uintx_t gen0("350F1C2036E12600512A8400920E");
   uintx_t gen1("EEDC82EE2D472B430D13E5066CD5B");
   
-  m_nPower[0].Initialize(CPerm(32, gen0)); 
-  m_nPower[1].Initialize(CPerm(32, gen1)); 
+  m_pPower[0].Initialize(CPerm(32, gen0)); 
+  m_pPower[1].Initialize(CPerm(32, gen1)); 
   
-  assert(m_nPower[0].GetOrder() == m_nOrder);
-  assert(m_nPower[1].GetOrder() == m_nOrder);
+  assert(m_pPower[0].GetOrder() == m_nOrder);
+  assert(m_pPower[1].GetOrder() == m_nOrder);
 } //ChooseGenerators
 
+/// Build the power tables, which srand() would otherwise do the first time
+/// that it is called. This lets the cost of building them be paid, or
+/// measured, separately from seeding.
+
+void Cayley32::BuildTables(){
+  ChooseGenerators();
+} //BuildTables
+
 /// Initialize the pseudorandom number generator by choosing the generators
 /// and choosing a pseudorandom initial permutation.
 /// \param seed Seed value.
 
 void Cayley32::srand(uintx_t& seed){
+  Reseeded();
+  ResetDelayLine(); //same stream as a new instance
   ChooseGenerators();
   *m_pCurPerm = CPerm(32, seed); //pseudorandom initial permutation
 } //srand
+
+/// Initialize the pseudorandom number generator from a 128-bit seed, which
+/// is enough to reach any permutation of size 32. This gives the same stream
+/// as srand(uintx_t&) with the same seed, but entirely without allocation.
+/// \param seed Seed value.
+
+void Cayley32::srand(const uint128w_t& seed){
+  Reseeded();
+  ResetDelayLine(); //same stream as a new instance
+  ChooseGenerators();
+  m_pCurPerm->SetNum(seed); //pseudorandom initial permutation
+} //srand
+
+//////////////////////////////////////////////////////////////////////////////
+//Cayley32c functions
+
+/// The default constructor. As with Cayley32, the power tables are not
+/// built until srand() is called, so that ShareTables() can be called
+/// first. The buffer starts used up, so that the first call to rand() or
+/// fill() generates block 0, which must not happen before srand().
+
+Cayley32c::Cayley32c(): m_cKeyPerm(32){
+} //constructor
+
+/// Set the key and go to the start of the stream. The key chooses the
+/// permutation that every block starts from, as srand() does for Cayley32,
+/// and all 128 bits of it are used to derive the delay line of each block.
+/// The first block is not generated until it is needed.
+/// \param key Key.
+
+void Cayley32c::srand(const uint128w_t& key){
+  Reseeded();
+  ChooseGenerators();
+
+  m_nKey[0] = (uint64_t)key;
+  m_nKey[1] = (uint64_t)(key >> 64);
+  m_cKeyPerm.SetNum(key);
+
+  m_nBlock = UINT64_MAX; //the block before block 0
+  m_nIndex = m_nBlockSize; //which is used up
+} //srand
+
+/// Set the key from the low 128 bits of an integer of any size.
+/// \param key Key.
+
+void Cayley32c::srand(const uintx_t& key){
+  srand(uint128w_t((uint64_t)key) |
+    (uint128w_t((uint64_t)(key >> 64)) << 64));
+} //srand
+
+/// Set the state of the walk for the start of a block, as follows. Seed
+/// SplitMix64 from the key and the block index, whose output function is a
+/// bijection so that different blocks get different seeds, fill the delay
+/// line from it, start from the key's permutation times both generators raised to
+/// pseudorandom powers, then take m_nWarmup steps so that the first output
+/// depends on the whole delay line.
+/// \param b Block index.
+
+void Cayley32c::StartBlock(uint64_t b){
+  CSplitMix64 sm(b ^ m_nKey[1]); //block index under the key
+  sm.srand(sm.rand() ^ m_nKey[0]); //SplitMix64 seed for this block
+
+  for(int i=0; i<m_nDelay; i++)
+    m_nDelayLine[i] = sm.rand();
+
+  m_nTail = 0;
+  m_nParity = 0;
+
+  *m_pCurPerm = m_cKeyPerm;
+  *m_pCurPerm *= m_pPower[0].GetMap(int(sm.rand()%m_nOrder));
+  *m_pCurPerm *= m_pPower[1].GetMap(int(sm.rand()%m_nOrder));
+
+  for(int i=0; i<m_nWarmup; i++)
+    Cayley32e::rand();
+} //StartBlock
+
+/// Generate a block of the stream. This does not change the position of
+/// rand() and fill() in the stream.
+/// \param b Block index.
+/// \param p [OUT] Buffer of at least m_nBlockSize words.
+
+void Cayley32c::GetBlock(uint64_t b, uint64_t* p){
+  assert(m_pPower[0].GetOrder() > 0); //safety: srand() has been called
+  StartBlock(b);
+  Cayley32e::fill(p, m_nBlockSize);
+} //GetBlock
+
+/// Go to a word of the stream, which takes the time to generate at most one
+/// block, wherever that word is.
+/// \param n Index of the word to be returned next by rand().
+
+void Cayley32c::seek(uint64_t n){
+  m_nBlock = n/m_nBlockSize;
+  GetBlock(m_nBlock, m_nBuffer);
+  m_nIndex = int(n%m_nBlockSize);
+} //seek
+
+/// Generate the next 64 pseudo-random bits of the stream.
+/// \return A pseudo-random 64-bit unsigned integer.
+
+uint64_t Cayley32c::rand(){
+  if(m_nIndex == m_nBlockSize){ //need the next block
+    GetBlock(++m_nBlock, m_nBuffer);
+    m_nIndex = 0;
+  } //if
+
+  return m_nBuffer[m_nIndex++];
+} //rand
+
+/// Fill a buffer with the next words of the stream. This produces the same
+/// numbers as calling rand() repeatedly, but whole blocks are generated
+/// directly into the buffer.
+/// \param p [OUT] Buffer.
+/// \param n Number of 64-bit words to generate.
+
+void Cayley32c::fill(uint64_t* p, size_t n){
+  for(; n > 0 && m_nIndex < m_nBlockSize; n--) //use up the current block
+    *p++ = m_nBuffer[m_nIndex++];
+
+  for(; n >= m_nBlockSize; n-=m_nBlockSize, p+=m_nBlockSize) //whole blocks
+    GetBlock(++m_nBlock, p);
+
+  for(; n > 0; n--) //part of one more block
+    *p++ = rand();
+} //fill
+
+//////////////////////////////////////////////////////////////////////////////
+//Cayley32a functions
+
+/// The default constructor. As with Cayley32, the power tables are not
+/// built until srand() is called.
+
+Cayley32a::Cayley32a(){
+} //constructor
+
+/// Derive the AES keys from 128 bits of the seed with SplitMix64.
+/// \param lo Low 64 bits of the seed.
+/// \param hi High 64 bits of the seed.
+
+void Cayley32a::SetKey(uint64_t lo, uint64_t hi){
+  CSplitMix64 sm(hi); //SplitMix64 seeded from the seed
+  sm.srand(sm.rand() ^ lo);
+
+  for(int i=0; i<6; i++)
+    m_nKey[i] = sm.rand();
+
+  m_bNext = false;
+} //SetKey
+
+/// Initialize the pseudorandom number generator as Cayley32 does, and
+/// derive the AES keys from the low 128 bits of the seed.
+/// \param seed Seed value.
+
+void Cayley32a::srand(uintx_t& seed){
+  Cayley32::srand(seed);
+  SetKey((uint64_t)seed, (uint64_t)(seed >> 64));
+} //srand
+
+/// Initialize the pseudorandom number generator as Cayley32 does, and
+/// derive the AES keys from the seed, without allocation.
+/// \param seed Seed value.
+
+void Cayley32a::srand(const uint128w_t& seed){
+  Cayley32::srand(seed);
+  SetKey(uint64_t(seed), uint64_t(seed >> 64));
+} //srand
+
+/// Update the current permutation and map it to 128 bits with the AES
+/// finalizer kernel selected for this CPU. The low word goes through the
+/// delay line, exactly as the output of the hash does in Cayley32e, so
+/// that it chooses the exponents of later steps.
+/// \param p [OUT] Two 64-bit words.
+
+inline void Cayley32a::Step(uint64_t* p){
+  NextPerm(); //update current permutation
+
+  uint64_t x[2]; //finalizer output
+  AES32(m_pCurPerm->GetMap(), m_nKey, x);
+
+  m_nDelayLine[m_nTail] = x[0]; //enter into delay line
+  m_nTail = (m_nTail + 1)%m_nDelay; //advance delay line
+
+  p[0] = x[0]^m_nDelayLine[m_nTail]; //strengthen pseudo-random number
+  p[1] = x[1];
+} //Step
+
+/// Generate 64 pseudo-random bits. Each step generates 128, so only every
+/// other call takes a step.
+/// \return A pseudo-random 64-bit unsigned integer.
+
+uint64_t Cayley32a::rand(){
+  if(m_bNext){ //high word of the last step
+    m_bNext = false;
+    return m_nNext;
+  } //if
+
+  uint64_t x[2]; //next two words
+  Step(x);
+
+  m_nNext = x[1];
+  m_bNext = true;
+
+  return x[0];
+} //rand
+
+/// Fill a buffer with pseudo-random 64-bit unsigned integers. This produces
+/// the same numbers as calling rand() repeatedly, but two words at a time.
+/// \param p [OUT] Buffer.
+/// \param n Number of 64-bit words to generate.
+
+void Cayley32a::fill(uint64_t* p, size_t n){
+  if(n > 0 && m_bNext){ //high word of the last step
+    *p++ = rand();
+    n--;
+  } //if
+
+  for(; n >= 2; n-=2, p+=2)
+    Step(p);
+
+  if(n > 0)
+    *p = rand();
+} //fill
+
+/// Get the number of bytes needed by SaveState().
+/// \return Size of the saved state in bytes.
+
+size_t Cayley32a::GetStateSize() const{
+  return Cayley32::GetStateSize() + 7*sizeof(uint64_t) + 1;
+} //GetStateSize
+
+/// Save the state of the generator, that is, the state saved by Cayley32,
+/// then the six AES keys, the high word of the last step, and whether that
+/// word has yet to be returned, in a portable byte order.
+/// \param p [OUT] Buffer of at least GetStateSize() bytes.
+
+void Cayley32a::SaveState(uint8_t* p) const{
+  Cayley32::SaveState(p);
+  p += Cayley32::GetStateSize();
+
+  for(int i=0; i<7; i++){ //keys then high word, little-endian
+    const uint64_t x = i < 6? m_nKey[i]: m_nNext; //word to save
+
+    for(int j=0; j<8; j++)
+      *p++ = uint8_t(x >> (8*j));
+  } //for
+
+  *p = uint8_t(m_bNext);
+} //SaveState
+
+/// Load a state saved by SaveState() from an instance with the same
+/// generators.
+/// \param p Buffer of GetStateSize() bytes.
+/// \return true If the state is valid, otherwise it is not loaded.
+
+bool Cayley32a::LoadState(const uint8_t* p){
+  const uint8_t* q = p + Cayley32::GetStateSize(); //keys, high word, and flag
+  if(q[7*sizeof(uint64_t)] > 1 || !Cayley32::LoadState(p))return false;
+
+  for(int i=0; i<7; i++){ //keys then high word, little-endian
+    uint64_t x = 0; //word loaded
+
+    for(int j=0; j<8; j++)
+      x |= uint64_t(*q++) << (8*j);
+
+    if(i < 6)m_nKey[i] = x;
+    else m_nNext = x;
+  } //for
+
+  m_bNext = *q != 0;
+
+  return true;
+} //LoadState
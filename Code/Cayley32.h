@@ -15,6 +15,7 @@ class Cayley32e: public CCayley{
   public:
     Cayley32e(); ///< Constructor.
     uint64_t rand(); ///< Generate 64 pseudo-random bits.
+    void fill(uint64_t* p, size_t n); ///< Generate many pseudo-random words.
 }; //Cayley32e
 
 //////////////////////////////////////////////////////////////////////////////
@@ -24,12 +25,91 @@ class Cayley32e: public CCayley{
 /// A 64-bit Cayley PRNG with permutation size 32 and fixed generators.
 
 class Cayley32: public Cayley32e{
-  private:
+  protected:
     void ChooseGenerators(); ///< Choose generators.
 
   public:
     Cayley32(); ///< Constructor.
+    void BuildTables(); ///< Build the power tables now.
     void srand(uintx_t& seed); ///< Seed the generator.
+    void srand(const uint128w_t& seed); ///< Seed the generator.
 }; //Cayley32
 
+//////////////////////////////////////////////////////////////////////////////
+
+/// \brief The Cayley PRNG over \f$S_{32}\f$ with an AES finalizer.
+///
+/// A variant of Cayley32 that maps each permutation to 128 bits with a few
+/// AES rounds keyed from the seed instead of to 64 bits with the
+/// multiply-exclusive-or hash, so it generates twice as many bits per
+/// composition. It uses the AES instructions if the CPU has them, and an
+/// identical software AES otherwise. This is a different stream from
+/// Cayley32 with the same seed. Its saved state is that of Cayley32 followed
+/// by the AES keys and the high word of the last step that is yet to be
+/// returned, if any.
+
+class Cayley32a: public Cayley32{
+  private:
+    uint64_t m_nKey[6] = {0}; ///< AES keys, low word first.
+    uint64_t m_nNext = 0; ///< High word of the last step.
+    bool m_bNext = false; ///< Whether m_nNext has yet to be returned.
+
+    void SetKey(uint64_t lo, uint64_t hi); ///< Set the AES keys.
+    void Step(uint64_t* p); ///< Generate 128 pseudo-random bits.
+
+  public:
+    Cayley32a(); ///< Constructor.
+
+    void srand(uintx_t& seed); ///< Seed the generator.
+    void srand(const uint128w_t& seed); ///< Seed the generator.
+
+    uint64_t rand(); ///< Generate 64 pseudo-random bits.
+    void fill(uint64_t* p, size_t n); ///< Generate many pseudo-random words.
+
+    size_t GetStateSize() const; ///< Get size of saved state.
+    void SaveState(uint8_t* p) const; ///< Save state.
+    bool LoadState(const uint8_t* p); ///< Load state.
+}; //Cayley32a
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// \brief The counter-based Cayley PRNG over \f$S_{32}\f$.
+///
+/// A counter-based variant of Cayley32 whose stream is a sequence of blocks
+/// of m_nBlockSize words. The state at the start of block \f$b\f$ is derived
+/// from the key and \f$b\f$ alone, so any block can be generated without
+/// generating the ones before it, and blocks can be generated in parallel
+/// by different instances, which may share power tables, with the same
+/// result as generating them in order. This is a different stream from
+/// Cayley32 with the same seed.
+
+class Cayley32c: public Cayley32{
+  public:
+    static const int m_nBlockSize = 512; ///< Words per block.
+
+  private:
+    static const int m_nWarmup = 32; ///< Steps discarded at block start.
+
+    uint64_t m_nKey[2] = {0, 0}; ///< Key, low word first.
+    CPerm m_cKeyPerm; ///< Permutation chosen by the key.
+
+    uint64_t m_nBlock = UINT64_MAX; ///< Index of the block in m_nBuffer.
+    uint64_t m_nBuffer[m_nBlockSize] = {0}; ///< Current block.
+    int m_nIndex = m_nBlockSize; ///< Index of next word in m_nBuffer.
+
+    void StartBlock(uint64_t b); ///< Set the state for the start of a block.
+
+  public:
+    Cayley32c(); ///< Constructor.
+
+    void srand(const uint128w_t& key); ///< Set the key.
+    void srand(const uintx_t& key); ///< Set the key.
+    void seek(uint64_t n); ///< Go to a word of the stream.
+
+    void GetBlock(uint64_t b, uint64_t* p); ///< Generate a block.
+
+    uint64_t rand(); ///< Generate 64 pseudo-random bits.
+    void fill(uint64_t* p, size_t n); ///< Generate many pseudo-random words.
+}; //Cayley32c
+
 #endif
\ No newline at end of file
@@ -0,0 +1,238 @@
+/// \file CayleyBank.cpp
+/// \brief Implementation of the bank of Cayley32 streams CCayleyBank.
+
+#include "Includes.h"
+#include "CayleyBank.h"
+#include "Baselines.h"
+#include "Kernels.h"
+
+extern const uint64_t g_nHashKey[32]; ///< Multipliers for the output hash.
+extern const uint64_t g_nDelayLineInit[32]; ///< Initial delay line.
+
+/// Prefetch the cache line that holds an address.
+/// \param p An address.
+
+static inline void Prefetch(const void* p){
+  #if defined(__GNUC__) //gcc and clang
+    __builtin_prefetch(p, 1, 3);
+  #elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch((const char*)p, _MM_HINT_T0);
+  #endif
+} //Prefetch
+
+///////////////////////////////////////////////////////////////////////////////
+//CCayleyBank functions
+
+#pragma region bank
+
+/// Construct a bank of streams, each of which is in the state of a new
+/// Cayley32 until it is seeded. As with Cayley32, the power tables are not
+/// built until srand() is called, so that ShareTables() can be called first.
+/// \param n Number of streams.
+
+CCayleyBank::CCayleyBank(size_t n): m_nStreams(n){
+  const size_t line = 64; //cache line size in bytes
+  m_stdPermBlock.assign(32*n + line - 1, 0);
+
+  const uintptr_t base = uintptr_t(m_stdPermBlock.data()); //unaligned start
+  m_pPerm = m_stdPermBlock.data() + (line - base%line)%line; //aligned start
+
+  m_stdDelay.resize(32*n);
+  m_stdPhase.assign(n, 0);
+
+  for(size_t i=0; i<n; i++){
+    for(int j=0; j<32; j++){
+      m_pPerm[32*i + j] = uint8_t(j); //identity
+      m_stdDelay[j*n + i] = g_nDelayLineInit[j];
+    } //for
+  } //for
+} //constructor
+
+/// The destructor deletes the power tables only if they are our own.
+
+CCayleyBank::~CCayleyBank(){
+  delete m_pOwner;
+} //destructor
+
+/// Build our own power tables if we have none.
+
+void CCayleyBank::Prepare(){
+  if(m_pTables == nullptr){
+    m_pOwner = new Cayley32;
+    m_pOwner->BuildTables();
+    m_pTables = m_pOwner;
+    m_nOrder = m_pTables->GetPowerTable(0).GetOrder();
+  } //if
+} //Prepare
+
+/// Use the power tables of an instance of Cayley32 instead of our own. The
+/// other instance must already have been seeded, or have had its tables
+/// built, and must outlive this bank.
+/// \param c The instance whose power tables are to be shared.
+
+void CCayleyBank::ShareTables(const CCayley& c){
+  assert(c.GetSize() == 32); //safety
+  assert(c.GetPowerTable(0).GetOrder() > 0); //safety
+
+  delete m_pOwner;
+  m_pOwner = nullptr;
+  m_pTables = &c;
+  m_nOrder = m_pTables->GetPowerTable(0).GetOrder();
+} //ShareTables
+
+/// Put a stream into the state of a Cayley32 seeded with srand(seed).
+/// \param i Stream index.
+/// \param seed Seed value.
+/// \param p A permutation of size 32, for scratch.
+
+void CCayleyBank::Seed(size_t i, const uint128w_t& seed, CPerm& p){
+  p.SetNum(seed); //pseudorandom initial permutation
+  memcpy(m_pPerm + 32*i, p.GetMap(), 32);
+
+  for(int j=0; j<32; j++)
+    m_stdDelay[j*m_nStreams + i] = g_nDelayLineInit[j];
+
+  m_stdPhase[i] = 0;
+} //Seed
+
+/// Seed one stream, which then gives the same stream as a Cayley32 seeded
+/// with srand(seed).
+/// \param i Stream index.
+/// \param seed Seed value.
+
+void CCayleyBank::srand(size_t i, const uint128w_t& seed){
+  assert(i < m_nStreams); //safety
+  Prepare();
+
+  CPerm p(32); //for scratch
+  Seed(i, seed, p);
+} //srand
+
+/// Seed every stream, stream \f$i\f$ with GetSeed(seed, i).
+/// \param seed Seed value.
+
+void CCayleyBank::srand(const uint128w_t& seed){
+  Prepare();
+
+  CPerm p(32); //for scratch
+
+  for(size_t i=0; i<m_nStreams; i++)
+    Seed(i, GetSeed(seed, i), p);
+} //srand
+
+/// Get the seed of one stream when every stream is seeded at once. It is
+/// two outputs of SplitMix64 seeded with the low 64 bits of the seed and
+/// the stream index, with the high 64 bits of the seed added in, so that
+/// different streams get different seeds.
+/// \param seed Seed value of the bank.
+/// \param i Stream index.
+/// \return Seed value of stream \f$i\f$.
+
+uint128w_t CCayleyBank::GetSeed(const uint128w_t& seed, size_t i){
+  CSplitMix64 sm((uint64_t)seed ^ (uint64_t(i)*0xD1B54A32D192ED03ULL));
+  const uint64_t hi = sm.rand() ^ (uint64_t)(seed >> 64); //high word
+  const uint64_t lo = sm.rand(); //low word
+
+  return (uint128w_t(hi) << 64) | uint128w_t(lo);
+} //GetSeed
+
+/// Advance one stream as Cayley32e::rand() does, with the delay line read
+/// across the structure of arrays and the tail and generator parity both
+/// taken from the number of steps modulo 32.
+/// \param i Stream index.
+/// \return A pseudo-random 64-bit unsigned integer.
+
+inline uint64_t CCayleyBank::Step(size_t i){
+  uint8_t* perm = m_pPerm + 32*i; //current permutation
+  uint64_t* delay = m_stdDelay.data() + i; //word j is at delay[j*N]
+  const size_t n = m_nStreams; //shorthand
+
+  const uint32_t t = m_stdPhase[i]; //tail and, in its low bit, parity
+  const uint32_t k = delay[t*n]%m_nOrder; //exponent
+  Compose32(perm, m_pTables->GetPowerTable(t & 1).GetMap(k));
+
+  const uint64_t num = Hash32(perm, g_nHashKey); //hash it
+  delay[t*n] = num; //enter into delay line
+
+  const uint32_t t1 = (t + 1)%32; //advance delay line
+  m_stdPhase[i] = uint8_t(t1);
+
+  return num^delay[t1*n]; //strengthen pseudo-random number
+} //Step
+
+/// Advance streams in batches. For each batch, first prefetch the
+/// power-table entries, permutations, and delay-line words that it needs,
+/// then advance each stream in it. A stream may appear more than once, since
+/// the prefetches are only hints and each step reads its own exponent.
+/// \param index Function that gives the index of the \f$j\f$th stream.
+/// \param n Number of streams to advance.
+/// \param p [OUT] Buffer of at least n words, one from each.
+
+template<class index_t> void CCayleyBank::Advance(index_t index, size_t n,
+  uint64_t* p)
+{
+  assert(m_pTables != nullptr); //safety
+
+  for(size_t b=0; b<n; b+=m_nBatch){
+    const size_t e = std::min(n, b + m_nBatch); //end of batch
+
+    for(size_t j=b; j<e; j++){ //prefetch
+      const size_t i = index(j); //stream index
+      const uint32_t t = m_stdPhase[i]; //its tail
+      const uint64_t* delay = m_stdDelay.data() + i; //its delay line
+
+      m_pTables->GetPowerTable(t & 1).Prefetch(
+        int(delay[t*m_nStreams]%m_nOrder));
+      Prefetch(m_pPerm + 32*i);
+      Prefetch(delay + ((t + 1)%32)*m_nStreams);
+    } //for
+
+    for(size_t j=b; j<e; j++) //advance
+      p[j] = Step(index(j));
+  } //for
+} //Advance
+
+/// Generate 64 pseudo-random bits from one stream. 
+/// \param i Stream index.
+/// \return A pseudo-random 64-bit unsigned integer.
+
+uint64_t CCayleyBank::rand(size_t i){
+  assert(m_pTables != nullptr && i < m_nStreams); //safety
+  return Step(i);
+} //rand
+
+/// Generate a word from every stream.
+/// \param p [OUT] Buffer of at least GetSize() words, the word from stream
+///   \f$i\f$ in p[i].
+
+void CCayleyBank::fill(uint64_t* p){
+  Advance([](size_t j){return j;}, m_nStreams, p);
+} //fill
+
+/// Generate a word from each of some streams, in order.
+/// \param index Indices of the streams, which may repeat.
+/// \param n Number of indices.
+/// \param p [OUT] Buffer of at least n words, the word from stream
+///   index[j] in p[j].
+
+void CCayleyBank::fill(const uint32_t* index, size_t n, uint64_t* p){
+  Advance([=](size_t j){return size_t(index[j]);}, n, p);
+} //fill
+
+/// Reader function for the number of streams.
+/// \return Number of streams.
+
+size_t CCayleyBank::GetSize() const{
+  return m_nStreams;
+} //GetSize
+
+/// Get the memory used by the state of the streams, not counting the power
+/// tables, which are shared.
+/// \return Size in bytes.
+
+size_t CCayleyBank::GetBytes() const{
+  return m_stdPermBlock.size() + m_stdDelay.size()*sizeof(uint64_t) +
+    m_stdPhase.size();
+} //GetBytes
+
+#pragma endregion bank
@@ -0,0 +1,72 @@
+/// \file CayleyBank.h
+/// \brief Declaration of the bank of Cayley32 streams CCayleyBank.
+
+#ifndef __CayleyBank__
+#define __CayleyBank__
+
+#include <vector>
+
+#include "Cayley32.h"
+
+/// \brief A bank of many Cayley32 streams.
+///
+/// Each stream is the stream of a Cayley32 with its own seed, but instead
+/// of an object per stream with its permutation and delay line on the heap,
+/// the bank keeps the current permutations of all of its streams in one
+/// block, 32 bytes each, and their delay lines in another, as a structure
+/// of arrays in which word \f$j\f$ of the delay line of stream \f$i\f$ is
+/// at \f$jN + i\f$ for \f$N\f$ streams. Each stream also has a byte for
+/// the number of steps that it has taken modulo 32, which is the tail of
+/// its delay line and, since 32 is even, its generator parity. That is 289
+/// bytes per stream, and all streams share the power tables of a single
+/// Cayley32.
+///
+/// Any subset of the streams can be advanced at once. The streams are taken
+/// in batches, and the power-table entries, permutations, and delay-line
+/// words that a batch needs are prefetched before any of them is used, so
+/// that the cache misses of the streams in a batch overlap instead of
+/// stalling each step in turn.
+
+class CCayleyBank{
+  private:
+    size_t m_nStreams = 0; ///< Number of streams.
+
+    Cayley32* m_pOwner = nullptr; ///< Owner of the power tables, if ours.
+    const CCayley* m_pTables = nullptr; ///< Owner of the power tables.
+    uint32_t m_nOrder = 0; ///< Order of the generators.
+
+    std::vector<uint8_t> m_stdPermBlock; ///< Current permutations, unaligned.
+    uint8_t* m_pPerm = nullptr; ///< Current permutations, aligned to a cache line.
+    std::vector<uint64_t> m_stdDelay; ///< Delay lines, word by word.
+    std::vector<uint8_t> m_stdPhase; ///< Steps taken by each stream modulo 32.
+
+    static const size_t m_nBatch = 16; ///< Streams per batch.
+
+    void Prepare(); ///< Get the power tables.
+    void Seed(size_t i, const uint128w_t& seed, CPerm& p); ///< Seed one stream.
+    inline uint64_t Step(size_t i); ///< Advance one stream.
+    template<class index_t> void Advance(index_t index, size_t n,
+      uint64_t* p); ///< Advance streams in batches.
+
+  public:
+    CCayleyBank(size_t n); ///< Constructor.
+    CCayleyBank(const CCayleyBank&) = delete; ///< No copy constructor.
+    ~CCayleyBank(); ///< Destructor.
+
+    CCayleyBank& operator=(const CCayleyBank&) = delete; ///< No assignment.
+
+    void ShareTables(const CCayley& c); ///< Share another instance's tables.
+
+    void srand(size_t i, const uint128w_t& seed); ///< Seed one stream.
+    void srand(const uint128w_t& seed); ///< Seed every stream.
+    static uint128w_t GetSeed(const uint128w_t& seed, size_t i); ///< Get seed of a stream.
+
+    uint64_t rand(size_t i); ///< Generate 64 pseudo-random bits from one stream.
+    void fill(uint64_t* p); ///< Generate a word from every stream.
+    void fill(const uint32_t* index, size_t n, uint64_t* p); ///< Generate a word from some streams.
+
+    size_t GetSize() const; ///< Get number of streams.
+    size_t GetBytes() const; ///< Get memory used by the streams.
+}; //CCayleyBank
+
+#endif
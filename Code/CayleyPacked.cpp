@@ -0,0 +1,137 @@
+/// \file CayleyPacked.cpp
+/// \brief Implementation of the packed Cayley pseudo-random number generator.
+
+#include "Includes.h"
+#include "CayleyPacked.h"
+#include "mt19937-64.h"
+
+extern const uint32_t g_nLandau[]; ///< Landau's function.
+
+/// \brief Largest order of an odd permutation of size \f$n\f$ for
+/// \f$0 \leq n \leq 16\f$, which is 0 if there are none.
+
+static const uint32_t g_nLandauOdd[] = {
+    0,   0,   2,   2,   4, //n = 0-4
+    6,   6,  12,  12,  20, //n = 5-9
+   30,  30,  60,  60,  84, //n = 10-14
+   84, 140                 //n = 15-16
+}; //g_nLandauOdd
+
+/// Constructor.
+/// \param n Size of permutations, \f$8 \leq n \leq 16\f$.
+
+CCayleyPacked::CCayleyPacked(uint32_t n):
+  m_nSize(n), m_cCurPerm(uint8_t(n))
+{
+  assert(8 <= n && n <= 16); //safety
+} //constructor
+
+/// Choose a pair of pseudo-random generators, the first of maximal order and
+/// the second odd and of maximal order for an odd permutation, that have no
+/// common fixed point, and build their power tables.
+/// \param rnd An external random number generator.
+
+template<class rng_t> void CCayleyPacked::ChooseGenerators(rng_t& rnd){
+  const uint32_t order[2] = {g_nLandau[m_nSize], g_nLandauOdd[m_nSize]};
+  CPerm p((uint8_t)m_nSize); //current permutation
+  bool ok = false; //whether chosen permutations are ok
+
+  while(!ok){
+    for(int i=0; i<2; i++)
+      do{ //choose a generator of the right order
+        if(i == 0)p.Randomize(rnd);
+        else p.RandomizeOdd(rnd);
+
+        m_cGenerator[i] = CPackedPerm(p);
+        m_cPower[i].Initialize(m_cGenerator[i]);
+      }while(m_cPower[i].GetOrder() < order[i]);
+
+    ok = true; //reject the generators if they have a common fixed point
+
+    for(uint8_t i=0; i<m_nSize && ok; i++)
+      ok = m_cGenerator[0][i] != i || m_cGenerator[1][i] != i;
+  } //while
+} //ChooseGenerators
+
+/// Initialize the pseudo-random number generator by choosing the generators,
+/// the initial permutation, and the contents of the delay line.
+/// \param rnd An external random number generator to use as a seed, either
+/// a function or an instance of a class with operator().
+
+template<class rng_t> void CCayleyPacked::srand(rng_t& rnd){
+  ChooseGenerators(rnd);
+
+  CPerm p((uint8_t)m_nSize); //initial permutation
+  p.Randomize(rnd);
+  m_cCurPerm = CPackedPerm(p);
+
+  for(int i=0; i<m_nDelay; i++)
+    m_nDelayLine[i] = rnd();
+
+  m_nTail = 0;
+  m_nParity = 0;
+} //srand
+
+/// Generate a pseudo-random permutation and map it to a 64-bit unsigned int,
+/// as follows. Multiply the current permutation by a power of the current
+/// generator, chosen by the oldest word in the delay line, then mix the
+/// packed map with a multiply-xorshift function. The exponent is reduced
+/// to the order with a multiplication instead of a division, since the
+/// order is not a compile-time constant.
+/// \return A pseudo-random 64-bit unsigned integer.
+
+uint64_t CCayleyPacked::rand(){
+  const CPackedPowerTable& table = m_cPower[m_nParity]; //current generator
+  const uint64_t e = m_nDelayLine[m_nTail] >> 32; //32 random bits
+  const uint32_t k = uint32_t((e*table.GetOrder()) >> 32); //exponent
+
+  m_cCurPerm *= table.GetMap(k); //multiply by generator to the power k
+  m_nParity ^= 1; //flip generator parity
+
+  uint64_t num = m_cCurPerm.GetMap(); //mix the packed map
+  num = (num ^ (num >> 31))*0x7FB5D329728EA185ULL;
+  num = (num ^ (num >> 27))*0x81DADEF4BC2DD44DULL;
+  num ^= num >> 33;
+
+  m_nDelayLine[m_nTail] = num; //enter into delay line
+  m_nTail = (m_nTail + 1)%m_nDelay; //advance delay line
+
+  return num^m_nDelayLine[m_nTail]; //strengthen pseudo-random number
+} //rand
+
+/// Fill a buffer with pseudo-random 64-bit unsigned integers. This produces
+/// the same numbers as calling rand() repeatedly.
+/// \param p [OUT] Buffer.
+/// \param n Number of 64-bit words to generate.
+
+void CCayleyPacked::fill(uint64_t* p, size_t n){
+  for(size_t i=0; i<n; i++)
+    p[i] = rand();
+} //fill
+
+/// Reader function for a generator.
+/// \param i Index of generator, 0 or 1.
+/// \return The generator.
+
+const CPackedPerm& CCayleyPacked::GetGenerator(int i) const{
+  return m_cGenerator[i];
+} //GetGenerator
+
+/// Reader function for the current permutation.
+/// \return The current permutation.
+
+const CPackedPerm& CCayleyPacked::GetPerm() const{
+  return m_cCurPerm;
+} //GetPerm
+
+/// Reader function for the permutation size.
+/// \return The permutation size.
+
+const uint32_t CCayleyPacked::GetSize() const{
+  return m_nSize;
+} //GetSize
+
+//////////////////////////////////////////////////////////////////////////////
+//explicit template instantiations
+
+template void CCayleyPacked::srand<CMersenneTwister>(CMersenneTwister&);
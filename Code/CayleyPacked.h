@@ -0,0 +1,52 @@
+/// \file CayleyPacked.h
+/// \brief Declaration of the packed Cayley pseudo-random number generator.
+
+#ifndef __CayleyPacked__
+#define __CayleyPacked__
+
+#include "PackedPerm.h"
+
+/// \brief The Cayley PRNG over \f$S_8\f$ to \f$S_{16}\f$ with packed
+/// permutations.
+///
+/// A Cayley PRNG with pseudo-random generators, like Cayley32e, over a
+/// symmetric group small enough that each permutation fits in a 64-bit word.
+/// The power tables take 8 bytes per entry and stay in L1 cache, and each
+/// step is a single packed composition and a 64-bit mixing function, so it
+/// is much faster than Cayley32, at the cost of a much smaller state space.
+/// The first generator has maximal order \f$g(n)\f$. The second is odd, so
+/// that the two generate \f$S_n\f$ rather than the alternating group, and
+/// has the largest order of any odd permutation, which is less than
+/// \f$g(n)\f$ for \f$n\f$ = 8 and 15.
+
+class CCayleyPacked{
+  private:
+    uint32_t m_nSize = 0; ///< Size of permutations.
+
+    CPackedPerm m_cGenerator[2]; ///< A pair of generators.
+    CPackedPowerTable m_cPower[2]; ///< Their power tables.
+    CPackedPerm m_cCurPerm; ///< Current permutation.
+
+    static const int m_nDelay = 32; ///< Delay size.
+
+    uint64_t m_nDelayLine[m_nDelay] = {0}; ///< Delay line.
+
+    int m_nTail = 0; ///< Index of last element in delay line.
+    uint32_t m_nParity = 0; ///< Generator parity; determines current generator.
+
+    template<class rng_t> void ChooseGenerators(rng_t& rnd); ///< Choose generators.
+
+  public:
+    CCayleyPacked(uint32_t n); ///< Constructor.
+
+    template<class rng_t> void srand(rng_t& rnd); ///< Seed the generator.
+
+    uint64_t rand(); ///< Generate 64 pseudo-random bits.
+    void fill(uint64_t* p, size_t n); ///< Generate many pseudo-random words.
+
+    const CPackedPerm& GetGenerator(int i) const; ///< Get generator.
+    const CPackedPerm& GetPerm() const; ///< Get current permutation.
+    const uint32_t GetSize() const; ///< Get permutation size.
+}; //CCayleyPacked
+
+#endif
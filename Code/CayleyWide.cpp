@@ -0,0 +1,189 @@
+/// \file CayleyWide.cpp
+/// \brief Implementation of the wide Cayley pseudo-random number generator.
+
+#include "Includes.h"
+#include "CayleyWide.h"
+#include "mt19937-64.h"
+
+extern const uint64_t g_nHashKey[32]; ///< Multipliers for the output hash.
+
+/// Constructor. Threads are used only for permutations of size at least
+/// \f$2^{18}\f$, below which a step takes less time than starting them.
+/// \param n Size of permutations, at least 256 and at most one more than
+///   the largest index_t.
+/// \param nThreads Number of threads for each step.
+
+template<class index_t> CCayleyWide<index_t>::CCayleyWide(size_t n,
+  uint32_t nThreads):
+  m_nSize(n), m_nThreads(n >= 262144? std::max(nThreads, 1U): 1),
+  m_cCurPerm(n), m_stdPower(n)
+{
+  assert(n >= 256 && n - 1 <= size_t(index_t(~index_t(0)))); //safety
+} //constructor
+
+/// Choose a pair of pseudo-random generators, the second odd, so that the
+/// two generate \f$S_n\f$, with no common fixed point and orders of at
+/// least \f$2^{32}\f$, which is more powers than a power table could hold.
+/// Unlike CCayley, this does not insist on maximal order, since generators
+/// of maximal order would be too rare to find by chance, but the order of
+/// a pseudo-random permutation grows quickly with its size.
+/// \param rnd An external random number generator.
+
+template<class index_t> template<class rng_t>
+  void CCayleyWide<index_t>::ChooseGenerators(rng_t& rnd)
+{
+  const uintx_t least = uintx_t("100000000"); //least order, 2^32
+  bool ok = false; //whether chosen permutations are ok
+
+  while(!ok){
+    for(int i=0; i<2; i++)
+      do{ //choose a generator of large order
+        m_cGenerator[i] = CWidePerm<index_t>(m_nSize);
+
+        if(i == 0)m_cGenerator[i].Randomize(rnd);
+        else m_cGenerator[i].RandomizeOdd(rnd);
+
+        m_cCycles[i].Initialize(m_cGenerator[i], m_nThreads);
+      }while(m_cCycles[i].GetOrder() < least);
+
+    ok = true; //reject the generators if they have a common fixed point
+
+    for(size_t i=0; i<m_nSize && ok; i++)
+      ok = m_cGenerator[0][i] != i || m_cGenerator[1][i] != i;
+  } //while
+} //ChooseGenerators
+
+/// Initialize the pseudo-random number generator by choosing the generators,
+/// the initial permutation, and the contents of the delay line.
+/// \param rnd An external random number generator to use as a seed, either
+/// a function or an instance of a class with operator().
+
+template<class index_t> template<class rng_t>
+  void CCayleyWide<index_t>::srand(rng_t& rnd)
+{
+  ChooseGenerators(rnd);
+
+  m_cCurPerm = CWidePerm<index_t>(m_nSize);
+  m_cCurPerm.Randomize(rnd);
+
+  for(int i=0; i<m_nDelay; i++)
+    m_nDelayLine[i] = rnd();
+
+  m_nTail = 0;
+  m_nParity = 0;
+} //srand
+
+/// Mix 64 bits with a multiply-xorshift function, which is a bijection.
+/// \param h 64 bits.
+/// \return h mixed.
+
+static inline uint64_t Mix(uint64_t h){
+  h = (h ^ (h >> 31))*0x7FB5D329728EA185ULL;
+  h = (h ^ (h >> 27))*0x81DADEF4BC2DD44DULL;
+  return h ^ (h >> 33);
+} //Mix
+
+/// Hash the current permutation to 64 bits by exclusive-oring together the
+/// products of the words of its map and odd multipliers, then mixing the
+/// result. The multiplier of word \f$j\f$ is made from \f$j\f$ and a key of
+/// Cayley32 with Mix(), so that the multipliers do not repeat every 32
+/// words and exchanging two words that are 32 apart changes the hash.
+/// \return Hash of the current permutation.
+
+template<class index_t> uint64_t CCayleyWide<index_t>::Hash() const{
+  const size_t per = sizeof(uint64_t)/sizeof(index_t); //entries per word
+  const size_t nWords = m_nSize/per; //number of whole words
+  const index_t* m = m_cCurPerm.GetMap(); //shorthand for the map
+  uint64_t h = 0; //return result
+
+  for(size_t j=0; j<nWords; j++){
+    uint64_t w; //word j of the map
+    memcpy(&w, m + j*per, sizeof(w));
+    h ^= w*(Mix(g_nHashKey[j%32] + j) | 1);
+  } //for
+
+  if(nWords*per < m_nSize){ //the rest of the map
+    uint64_t w = 0; //last word of the map, padded with zeros
+    memcpy(&w, m + nWords*per, (m_nSize - nWords*per)*sizeof(index_t));
+    h ^= w*(Mix(g_nHashKey[nWords%32] + nWords) | 1);
+  } //if
+
+  return Mix(h);
+} //Hash
+
+/// Generate a pseudo-random permutation and map it to a 64-bit unsigned int,
+/// as follows. Multiply the current permutation by the power of the current
+/// generator whose exponent is the oldest word in the delay line, made from
+/// its cycles, then hash the map.
+/// \return A pseudo-random 64-bit unsigned integer.
+
+template<class index_t> uint64_t CCayleyWide<index_t>::rand(){
+  m_cCycles[m_nParity].GetPower(m_nDelayLine[m_nTail], m_stdPower.data(),
+    m_nThreads); //power of the current generator
+  m_cCurPerm.Compose(m_stdPower.data(), m_nThreads); //multiply by it
+  m_nParity ^= 1; //flip generator parity
+
+  const uint64_t num = Hash(); //hash the current permutation
+
+  m_nDelayLine[m_nTail] = num; //enter into delay line
+  m_nTail = (m_nTail + 1)%m_nDelay; //advance delay line
+
+  return num^m_nDelayLine[m_nTail]; //strengthen pseudo-random number
+} //rand
+
+/// Fill a buffer with pseudo-random 64-bit unsigned integers. This produces
+/// the same numbers as calling rand() repeatedly.
+/// \param p [OUT] Buffer.
+/// \param n Number of 64-bit words to generate.
+
+template<class index_t> void CCayleyWide<index_t>::fill(uint64_t* p,
+  size_t n)
+{
+  for(size_t i=0; i<n; i++)
+    p[i] = rand();
+} //fill
+
+/// Reader function for a generator.
+/// \param i Index of generator, 0 or 1.
+/// \return The generator.
+
+template<class index_t>
+  const CWidePerm<index_t>& CCayleyWide<index_t>::GetGenerator(int i) const
+{
+  return m_cGenerator[i];
+} //GetGenerator
+
+/// Reader function for the cycles of a generator.
+/// \param i Index of generator, 0 or 1.
+/// \return The cycles of the generator.
+
+template<class index_t>
+  const CWideCycles<index_t>& CCayleyWide<index_t>::GetCycles(int i) const
+{
+  return m_cCycles[i];
+} //GetCycles
+
+/// Reader function for the current permutation.
+/// \return The current permutation.
+
+template<class index_t>
+  const CWidePerm<index_t>& CCayleyWide<index_t>::GetPerm() const
+{
+  return m_cCurPerm;
+} //GetPerm
+
+/// Reader function for the permutation size.
+/// \return The permutation size.
+
+template<class index_t> const size_t CCayleyWide<index_t>::GetSize() const{
+  return m_nSize;
+} //GetSize
+
+//////////////////////////////////////////////////////////////////////////////
+//explicit template instantiations
+
+template class CCayleyWide<uint16_t>;
+template class CCayleyWide<uint32_t>;
+
+template void CCayleyWide<uint16_t>::srand<CMersenneTwister>(CMersenneTwister&);
+template void CCayleyWide<uint32_t>::srand<CMersenneTwister>(CMersenneTwister&);
@@ -0,0 +1,56 @@
+/// \file CayleyWide.h
+/// \brief Declaration of the wide Cayley pseudo-random number generator.
+
+#ifndef __CayleyWide__
+#define __CayleyWide__
+
+#include "WidePerm.h"
+
+/// \brief The Cayley PRNG over very large symmetric groups.
+///
+/// A Cayley PRNG with pseudo-random generators, like Cayley32e, over
+/// \f$S_n\f$ for \f$n\f$ from 256 up to \f$2^{16}\f$ with CWidePerm<uint16_t>,
+/// or more with CWidePerm<uint32_t>. The generators have such large orders
+/// that their power tables could not be built, so instead the power needed
+/// at each step is made from their cycles with CWideCycles::GetPower(),
+/// with the exponent taken from the delay line without reducing it modulo
+/// the order. Each step takes time proportional to \f$n\f$, so this is
+/// meant for experiments rather than speed. For permutations big enough
+/// that a step takes long enough to pay for starting threads, the power
+/// and the composition are split over threads.
+
+template<class index_t> class CCayleyWide{
+  private:
+    size_t m_nSize = 0; ///< Size of permutations.
+    uint32_t m_nThreads = 1; ///< Number of threads for each step.
+
+    CWidePerm<index_t> m_cGenerator[2]; ///< A pair of generators.
+    CWideCycles<index_t> m_cCycles[2]; ///< Their cycles, for their powers.
+    CWidePerm<index_t> m_cCurPerm; ///< Current permutation.
+    std::vector<index_t> m_stdPower; ///< Map of the power for the next step.
+
+    static const int m_nDelay = 32; ///< Delay size.
+
+    uint64_t m_nDelayLine[m_nDelay] = {0}; ///< Delay line.
+
+    int m_nTail = 0; ///< Index of last element in delay line.
+    uint32_t m_nParity = 0; ///< Generator parity; determines current generator.
+
+    template<class rng_t> void ChooseGenerators(rng_t& rnd); ///< Choose generators.
+    uint64_t Hash() const; ///< Hash the current permutation.
+
+  public:
+    CCayleyWide(size_t n, uint32_t nThreads=1); ///< Constructor.
+
+    template<class rng_t> void srand(rng_t& rnd); ///< Seed the generator.
+
+    uint64_t rand(); ///< Generate 64 pseudo-random bits.
+    void fill(uint64_t* p, size_t n); ///< Generate many pseudo-random words.
+
+    const CWidePerm<index_t>& GetGenerator(int i) const; ///< Get generator.
+    const CWideCycles<index_t>& GetCycles(int i) const; ///< Get cycles of generator.
+    const CWidePerm<index_t>& GetPerm() const; ///< Get current permutation.
+    const size_t GetSize() const; ///< Get permutation size.
+}; //CCayleyWide
+
+#endif
@@ -0,0 +1,1352 @@
+/// \file Check.cpp
+/// \brief Implementation of the self-check.
+///
+/// The self-check has two parts. The known-answer checks compare the output
+/// of Cayley32, Cayley32e, Cayley32a, and the packed Cayley PRNG, the
+/// ranking and unranking of permutations, and uintx_t arithmetic with values
+/// recorded from the reference implementation, so that any change to the
+/// output stream is caught. The differential checks compare each optimized
+/// code path, such as the SIMD kernels at every instruction set level that
+/// the CPU supports, bulk fill, prefetching, and wide integers, with a slow
+/// but obviously correct reference on pseudorandom inputs.
+
+#include <random>
+
+#include "Includes.h"
+#include "Check.h"
+#include "Cayley32.h"
+#include "CayleyPacked.h"
+#include "CayleyBank.h"
+#include "Shuffle.h"
+#include "CayleyWide.h"
+#include "Kernels.h"
+#include "mt19937-64.h"
+#include "Baselines.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//Helper functions
+
+#pragma region helpers
+
+/// Print the result of a check.
+/// \param name Name of the check.
+/// \param failures Number of failures.
+/// \return Number of failures.
+
+static uint64_t Report(const char* name, uint64_t failures){
+  if(failures == 0)printf("  %-44s ok\n", name);
+  else printf("  %-44s FAILED (%" PRIu64 ")\n", name, failures);
+
+  return failures;
+} //Report
+
+/// Add a word to an FNV-1a style hash of a stream of words.
+/// \param h Hash of the stream so far.
+/// \param x Next word of the stream.
+/// \return Hash of the stream including x.
+
+static inline uint64_t HashWord(uint64_t h, uint64_t x){
+  return (h ^ x)*0x100000001B3ULL;
+} //HashWord
+
+const uint64_t g_nHashStart = 0xCBF29CE484222325ULL; ///< Empty stream hash.
+
+/// Make a uintx_t from a 64-bit value, since uintx_t has no constructor
+/// for one.
+/// \param x A 64-bit value.
+/// \return x as a uintx_t.
+
+static uintx_t ToUintx(uint64_t x){
+  return (uintx_t(int(uint32_t(x >> 32))) << 32) + uintx_t(int(uint32_t(x)));
+} //ToUintx
+
+/// Choose a pseudorandom permutation map of size 32 with Fisher-Yates.
+/// \param m [OUT] Map of 32 bytes.
+/// \param rng Mersenne Twister.
+
+static void RandomMap32(uint8_t* m, CMersenneTwister& rng){
+  for(int i=0; i<32; i++)
+    m[i] = uint8_t(i);
+
+  for(int i=31; i>0; i--)
+    std::swap(m[i], m[rng()%(i + 1)]);
+} //RandomMap32
+
+/// Pack a permutation of size 16 taken from a permutation map of size 32,
+/// namely the elements less than 16 in the order that they appear in it.
+/// \param m Map of 32 bytes.
+/// \return Packed map of size 16.
+
+static uint64_t Pack16(const uint8_t m[32]){
+  uint64_t x = 0; //return result
+  int j = 0; //number of nibbles so far
+
+  for(int i=0; i<32; i++)
+    if(m[i] < 16)
+      x |= uint64_t(m[i]) << 4*j++;
+
+  return x;
+} //Pack16
+
+/// Get the words of a uintx_t, least significant first, without leading
+/// zero words, by way of its hexadecimal string so as not to depend on the
+/// code under test.
+/// \param x An extensible unsigned integer.
+/// \return Its words, none for zero.
+
+static std::vector<uint32_t> ToWords(const uintx_t& x){
+  const std::string s = x.GetString(); //hexadecimal
+  std::vector<uint32_t> w; //return result
+
+  for(int end=int(s.size()); end>0; end-=8){ //8 digits to a word
+    const int begin = std::max(end - 8, 0); //start of word
+    w.push_back(uint32_t(strtoul(s.substr(begin, end - begin).c_str(),
+      nullptr, 16)));
+  } //for
+
+  while(!w.empty() && w.back() == 0)w.pop_back();
+  return w;
+} //ToWords
+
+/// Make a uintx_t from words, by way of a hexadecimal string.
+/// \param w Words, least significant first.
+/// \return w as a uintx_t.
+
+static uintx_t FromWords(const std::vector<uint32_t>& w){
+  std::string s = "0"; //hexadecimal
+  char buf[9]; //one word
+
+  for(size_t i=w.size(); i>0; i--){
+    snprintf(buf, sizeof(buf), "%08X", w[i - 1]);
+    s += buf;
+  } //for
+
+  return uintx_t(s.c_str());
+} //FromWords
+
+/// Choose pseudorandom words with a nonzero most significant word, a quarter
+/// of them all zeros or all ones so that carries and borrows run far.
+/// \param n Number of words, at least 1.
+/// \param rng Mersenne Twister.
+/// \return Words, least significant first.
+
+static std::vector<uint32_t> RandomWords(size_t n, CMersenneTwister& rng){
+  std::vector<uint32_t> w(n); //return result
+
+  for(uint32_t& x: w){
+    const uint64_t r = rng(); //random bits
+    x = (r & 7) == 0? 0: (r & 7) == 1? 0xFFFFFFFF: uint32_t(r >> 32);
+  } //for
+
+  while(w.back() == 0)w.back() = uint32_t(rng());
+  return w;
+} //RandomWords
+
+/// Multiply words by schoolbook multiplication, as a reference.
+/// \param a Words, least significant first.
+/// \param b Words, least significant first.
+/// \return a*b, without leading zero words.
+
+static std::vector<uint32_t> MulReference(const std::vector<uint32_t>& a,
+  const std::vector<uint32_t>& b)
+{
+  std::vector<uint32_t> r(a.size() + b.size(), 0); //return result
+
+  for(size_t j=0; j<b.size(); j++){
+    uint64_t carry = 0; //carry word
+
+    for(size_t i=0; i<a.size(); i++){
+      const uint64_t t = uint64_t(a[i])*b[j] + r[i + j] + carry;
+      r[i + j] = uint32_t(t);
+      carry = t >> 32;
+    } //for
+
+    r[j + a.size()] = uint32_t(carry);
+  } //for
+
+  while(!r.empty() && r.back() == 0)r.pop_back();
+  return r;
+} //MulReference
+
+/// Compare a generator under test with a reference, either one word from
+/// rand() or a bufferful of pseudorandom size from fill().
+/// \param test [in, out] Generator under test.
+/// \param ref [in, out] Reference, a function object returning a word.
+/// \param bulk Whether to compare a bufferful instead of one word.
+/// \param rng [in, out] PRNG for the buffer size.
+/// \param buffer [in, out] Buffer for bulk generation.
+/// \param failures [in, out] Number of failures.
+/// \return Number of words compared.
+
+template<class test_t, class ref_t> static uint64_t CompareWords(
+  test_t& test, ref_t&& ref, bool bulk, CMersenneTwister& rng,
+  std::vector<uint64_t>& buffer, uint64_t& failures)
+{
+  if(!bulk){ //one word
+    if(test.rand() != ref())failures++;
+    return 1;
+  } //if
+
+  const size_t m = size_t(rng()%buffer.size()) + 1; //words
+  test.fill(buffer.data(), m);
+
+  for(size_t k=0; k<m; k++)
+    if(buffer[k] != ref())failures++;
+
+  return m;
+} //CompareWords
+
+#pragma endregion helpers
+
+///////////////////////////////////////////////////////////////////////////////
+//Known-answer checks
+
+#pragma region known
+
+/// \brief Known answers for a stream.
+///
+/// Hashes of the first g_nLength[i] words of a stream, one for each length
+/// in g_nLength, recorded from the original scalar implementation.
+
+struct CStreamVector{
+  const char* m_szSeed; ///< Seed in hexadecimal.
+  uint64_t m_nHash[4]; ///< Hashes of prefixes of the stream.
+}; //CStreamVector
+
+/// Lengths of the prefixes of the streams that are hashed. 131072 words is
+/// the 1MB that the golden output files hold.
+
+static const uint64_t g_nLength[4] = {1, 1000, 131072, 1000000};
+
+/// Known answers for Cayley32 seeded with srand(uintx_t&).
+
+static const CStreamVector g_cCayley32Vector[] = {
+  {"1", {
+    0x4058091EC03C0240ULL, 0x5DB5E7DA50A41CA5ULL,
+    0x5FD0FF64BBD9818EULL, 0x9448005A4B08E69AULL}},
+  {"99999", {
+    0xCCBF5975A62CBA09ULL, 0xE965C9A72E5082A4ULL,
+    0x200E66A97AC77463ULL, 0x5879567C727F7C3BULL}},
+  {"999999", {
+    0xDFC4A5654B015D9CULL, 0xAAB2C9E4A7F4AE0FULL,
+    0xE15992D4D220BEC0ULL, 0x678174AA9FA3B23FULL}},
+  {"ABCDEF0123456789ABCDEF", {
+    0xE56B4B0DEF8861B2ULL, 0xB7968C9671FD5A3FULL,
+    0xBA2BF20375CBFF14ULL, 0x591B544775F6C25AULL}},
+}; //g_cCayley32Vector
+
+/// Known answers for Cayley32e seeded from a Mersenne Twister seeded with
+/// the low 64 bits of the seed, which is what -ge does.
+
+static const CStreamVector g_cCayley32eVector[] = {
+  {"1", {
+    0x811DB25C89278D0EULL, 0x4C829A87281C801CULL,
+    0xA6729F020290BC44ULL, 0x2887F19262B1ED04ULL}},
+  {"99999", {
+    0x61C51968C766F808ULL, 0x1E0DDCA31C49B441ULL,
+    0x9B72B5D6E0893E8FULL, 0x59F74308BD077A66ULL}},
+  {"999999", {
+    0xF00388EB96201482ULL, 0xB575E223940583CAULL,
+    0x657C56EEEDCCA679ULL, 0x5DA7383AB724D790ULL}},
+  {"ABCDEF0123456789ABCDEF", {
+    0xDF0EE5056B2C8BFAULL, 0xCED2FAD3459E0361ULL,
+    0x07D3D22BF98F6F6DULL, 0x1F13B9FCDF1FECFCULL}},
+}; //g_cCayley32eVector
+
+/// Known answers for Cayley32a seeded with srand(uintx_t&).
+
+static const CStreamVector g_cCayley32aVector[] = {
+  {"1", {
+    0x7829B2E8F4F13B23ULL, 0x357FB4FE70653FF8ULL,
+    0x288FE94DDA8D148BULL, 0x5ABB2193516D7386ULL}},
+  {"99999", {
+    0x8B410013EC13B107ULL, 0x8B8E30444B03EF5FULL,
+    0x89443956E07EAF95ULL, 0x932A92BF7925BCABULL}},
+  {"999999", {
+    0x7DE05A2F129DCBB7ULL, 0x6F7F9846E0F1328EULL,
+    0x482445750847DE28ULL, 0xC42285AC1BAB68F0ULL}},
+  {"ABCDEF0123456789ABCDEF", {
+    0x400B7ECE757A170AULL, 0xB4E3688F3AA0D937ULL,
+    0xA6707F365B7D43E6ULL, 0xBA335907AE727B1DULL}},
+}; //g_cCayley32aVector
+
+/// Known answers for the packed Cayley PRNG over \f$S_{16}\f$ seeded from a
+/// Mersenne Twister seeded with the low 64 bits of the seed, which is what
+/// -gp 16 does.
+
+static const CStreamVector g_cPackedVector[] = {
+  {"1", {
+    0xE96792BEF6AB5F35ULL, 0x37466BA9F0BABDF2ULL,
+    0x5C4883BF2C7FDDB5ULL, 0xB01977EC0E5904ECULL}},
+  {"99999", {
+    0x1B9CA2511DE9EC41ULL, 0x5FB64213CA1E0CF8ULL,
+    0xDE6E4C3FB1A7472EULL, 0xC156A866602CE3B2ULL}},
+  {"999999", {
+    0x35BA18FFE9DC0709ULL, 0xCEC9DF01DAB3F59DULL,
+    0x1FB325C91DB8C2BBULL, 0x93513E2F8DB4035DULL}},
+  {"ABCDEF0123456789ABCDEF", {
+    0xB3F2F5E07A8D66DCULL, 0xF108196F2BCA953BULL,
+    0x8E2F7D544A09A4FCULL, 0xCA8935423E95C159ULL}},
+}; //g_cPackedVector
+
+/// Check a stream against its known answers.
+/// \param v Known answers.
+/// \param rnd Function that returns the next word of the stream.
+/// \return Number of failures.
+
+template<typename t> static uint64_t CheckStream(const CStreamVector& v,
+  const t& rnd)
+{
+  uint64_t failures = 0; //return result
+  uint64_t h = g_nHashStart; //hash of stream so far
+  uint64_t n = 0; //number of words hashed
+
+  for(int i=0; i<4; i++){
+    for(; n<g_nLength[i]; n++)
+      h = HashWord(h, rnd());
+
+    if(h != v.m_nHash[i]){
+      printf("    seed %s, %" PRIu64 " words: hash 0x%016" PRIX64
+        ", expected 0x%016" PRIX64 "\n", v.m_szSeed, n, h, v.m_nHash[i]);
+      failures++;
+    } //if
+  } //for
+
+  return failures;
+} //CheckStream
+
+/// Check the Cayley32, Cayley32e, Cayley32a, and packed Cayley streams
+/// against their known answers.
+/// \return Number of failures.
+
+static uint64_t CheckKnownStreams(){
+  uint64_t failures = 0; //number of failures
+
+  for(auto& v: g_cCayley32Vector){
+    uintx_t seed(v.m_szSeed); //seed
+    Cayley32 cayley32; //new PRNG with fixed generators
+    cayley32.srand(seed);
+    failures += CheckStream(v, [&](){return cayley32.rand();});
+  } //for
+
+  Report("known answers: Cayley32 stream", failures);
+
+  uint64_t failures2 = 0; //number of failures for Cayley32e
+
+  for(auto& v: g_cCayley32eVector){
+    CMersenneTwister mt((uint64_t)uintx_t(v.m_szSeed)); //for seeding
+    Cayley32e cayley32e; //new PRNG with pseudorandom generators
+    cayley32e.srand(mt);
+    failures2 += CheckStream(v, [&](){return cayley32e.rand();});
+  } //for
+
+  failures += Report("known answers: Cayley32e stream", failures2);
+
+  uint64_t failures3 = 0; //number of failures for Cayley32a
+
+  for(auto& v: g_cCayley32aVector){
+    uintx_t seed(v.m_szSeed); //seed
+    Cayley32a cayley32a; //new PRNG with AES finalizer
+    cayley32a.srand(seed);
+    failures3 += CheckStream(v, [&](){return cayley32a.rand();});
+  } //for
+
+  failures += Report("known answers: Cayley32a stream", failures3);
+
+  uint64_t failures4 = 0; //number of failures for the packed Cayley PRNG
+
+  for(auto& v: g_cPackedVector){
+    CMersenneTwister mt((uint64_t)uintx_t(v.m_szSeed)); //for seeding
+    CCayleyPacked packed(16); //new PRNG over S_16
+    packed.srand(mt);
+    failures4 += CheckStream(v, [&](){return packed.rand();});
+  } //for
+
+  return failures + Report("known answers: packed Cayley stream", failures4);
+} //CheckKnownStreams
+
+/// \brief Known answer for ranking a permutation.
+
+struct CRankVector{
+  const char* m_szRank; ///< Reverse lexicographic number in hexadecimal.
+  uint8_t m_nMap[32]; ///< Map of the permutation.
+}; //CRankVector
+
+/// Known answers for ranking. The middle two are the generators of
+/// Cayley32, and the first and last are the ends of the reverse
+/// lexicographic order.
+
+static const CRankVector g_cRankVector[] = {
+  {"0", {
+    31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16,
+    15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0}},
+  {"350F1C2036E12600512A8400920E", {
+    24, 4, 15, 21, 29, 16, 11, 12, 7, 8, 19, 13, 18, 6, 28, 1,
+    27, 25, 31, 17, 3, 14, 9, 26, 30, 10, 20, 22, 23, 2, 5, 0}},
+  {"EEDC82EE2D472B430D13E5066CD5B", {
+    4, 10, 1, 22, 16, 8, 12, 27, 20, 19, 3, 24, 28, 25, 23, 26,
+    7, 0, 17, 21, 5, 30, 2, 31, 13, 18, 11, 15, 29, 6, 14, 9}},
+  {"32AD5A155C6748AC18B9A57FFFFFFF", {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31}},
+}; //g_cRankVector
+
+/// Check unranking and ranking of permutations of size 32 against their
+/// known answers, using both uintx_t and uint128w_t.
+/// \return Number of failures.
+
+static uint64_t CheckKnownRanks(){
+  uint64_t failures = 0; //return result
+
+  for(auto& v: g_cRankVector){
+    const uintx_t rank(v.m_szRank); //rank
+    const CPerm p(32, rank); //unrank with uintx_t
+
+    CPerm q(32); //unrank with uint128w_t
+    q.SetNum(uint128w_t(v.m_szRank));
+
+    if(memcmp(p.GetMap(), v.m_nMap, 32) != 0){
+      printf("    rank %s: map", v.m_szRank);
+      for(int i=0; i<32; i++)printf(" %u", p[i]);
+      printf("\n");
+      failures++;
+    } //if
+
+    if(!(p == q))failures++;
+    if(p.GetNum<uintx_t>() != rank)failures++;
+    if(!(p.GetNum<uint128w_t>() == uint128w_t(v.m_szRank)))failures++;
+  } //for
+
+  return Report("known answers: rank and unrank", failures);
+} //CheckKnownRanks
+
+/// \brief Known answer for uintx_t arithmetic.
+
+struct CArithmeticVector{
+  const char* m_szOp; ///< Operation.
+  const char* m_szResult; ///< Result in hexadecimal.
+}; //CArithmeticVector
+
+/// Known answers for uintx_t arithmetic on a and b below, computed with
+/// Python's arbitrary precision integers.
+
+static const CArithmeticVector g_cArithmeticVector[] = {
+  {"+", "FEDCBA9876543210FEDCBBBBBBBBBBBCCCCBBBBBBBBBBB"},
+  {"-", "FEDCBA9876543210FEDCB97530ECA86530EDB97530ECA9"},
+  {"*", "121FA00AD77D742247ACC913FA630FEF15C4FCBCFA630FED"
+    "E05FF5287717ACCBAAD2CC2"},
+  {"/", "E0000000000000D2F00000"},
+  {"%", "96551310FEDCBB26065432"},
+  {"<<", "1FDB97530ECA86421FDB97530ECA86421FDB97530ECA864000000000"},
+  {">>", "7F6E5D4C3B2A19087F6E5D4C3B2A19087F6E5"},
+  {"&", "44440000CCCC0000444400"},
+  {"|", "FEDCBA9876543210FEDCBBBB7777BBBBFFFFBBBB7777BB"},
+  {"b|a", "FEDCBA9876543210FEDCBBBB7777BBBBFFFFBBBB7777BB"},
+  {"32!", "32AD5A155C6748AC18B9A580000000"},
+}; //g_cArithmeticVector
+
+/// Check uintx_t arithmetic against its known answers.
+/// \return Number of failures.
+
+static uint64_t CheckKnownArithmetic(){
+  const uintx_t a("FEDCBA9876543210FEDCBA9876543210FEDCBA98765432");
+  const uintx_t b("123456789ABCDEF0123456789");
+
+  uintx_t factorial = 1; //32!
+  for(int i=2; i<=32; i++)
+    factorial = factorial*i;
+
+  uint64_t failures = 0; //return result
+
+  for(auto& v: g_cArithmeticVector){
+    const std::string op = v.m_szOp; //operation
+    uintx_t r; //result
+
+    if(op == "+")r = a + b;
+    else if(op == "-")r = a - b;
+    else if(op == "*")r = a*b;
+    else if(op == "/")r = a/b;
+    else if(op == "%")r = a%b;
+    else if(op == "<<")r = a << 37;
+    else if(op == ">>")r = a >> 37;
+    else if(op == "&")r = a & b;
+    else if(op == "|")r = a | b;
+    else if(op == "b|a")r = b | a;
+    else if(op == "32!")r = factorial;
+
+    if(r.GetString() != v.m_szResult){
+      printf("    %s: %s, expected %s\n", v.m_szOp, r.GetString().c_str(),
+        v.m_szResult);
+      failures++;
+    } //if
+  } //for
+
+  return Report("known answers: uintx_t arithmetic", failures);
+} //CheckKnownArithmetic
+
+/// \brief Known answers for a baseline PRNG.
+
+struct CBaselineVector{
+  const char* m_szName; ///< Name of the PRNG.
+  uint64_t m_nSeed; ///< Seed.
+  uint64_t m_nWord[4]; ///< Words 0, 1, 2, and 999 of the stream.
+}; //CBaselineVector
+
+/// Known answers for the baseline PRNGs seeded with srand(), computed with
+/// Python implementations of their authors' reference code. The first three
+/// words for SplitMix64 with seed 0, PCG64 with seed 42 and stream 54, and
+/// Philox4x64-10 with key 0 are the published ones.
+
+static const CBaselineVector g_cBaselineVector[] = {
+  {"SplitMix64", 0, {
+    0xE220A8397B1DCDAFULL, 0x6E789E6AA1B965F4ULL,
+    0x06C45D188009454FULL, 0x14E0ABB2BFCF7C3EULL}},
+  {"SplitMix64", 1234567, {
+    0x599ED017FB08FC85ULL, 0x2C73F08458540FA5ULL,
+    0x883EBCE5A3F27C77ULL, 0x8B33CC4945DD1C5FULL}},
+  {"xoshiro256**", 0, {
+    0x99EC5F36CB75F2B4ULL, 0xBF6E1F784956452AULL,
+    0x1A5F849D4933E6E0ULL, 0x7AAC8C483A2EDD2FULL}},
+  {"xoshiro256**", 1234567, {
+    0x30A3A1C363600467ULL, 0x19405F0F579929CAULL,
+    0x115BEAAC046DDBD9ULL, 0x3BE7F2876DF677C2ULL}},
+  {"PCG64", 42, { //stream 54
+    0x86B1DA1D72062B68ULL, 0x1304AA46C9853D39ULL,
+    0xA3670E9E0DD50358ULL, 0x214A2C5BC3284E81ULL}},
+  {"PCG64", 1234567, { //stream 0
+    0x960CEBC462E6A2B9ULL, 0x81240D93CDF907F5ULL,
+    0x8133ED742D6E5278ULL, 0x3E5DC5CE8B67A50BULL}},
+  {"Philox4x64-10", 0, {
+    0x16554D9ECA36314CULL, 0xDB20FE9D672D0FDCULL,
+    0xD7E772CEE186176BULL, 0xD6B6972E1C0F8FCBULL}},
+  {"Philox4x64-10", 1234567, {
+    0xD1C69756BFEF66E6ULL, 0xBC61AD13CDF107B9ULL,
+    0xAADFBC399033D673ULL, 0x2FB390DDB1146C2FULL}},
+  {"ChaCha20", 1234567, {
+    0x2DADAC1F6770CC12ULL, 0x1C25B13B1905D4E0ULL,
+    0x001FA5B945BDA91BULL, 0x53F09140AC8C1FB3ULL}},
+}; //g_cBaselineVector
+
+/// The first block of the published ChaCha20 keystream for the all-zero key
+/// and nonce, 76 b8 e0 ad a0 f1 3d 90 ..., as little-endian words.
+
+static const uint64_t g_nChaChaZeroKey[8] = {
+  0x903DF1A0ADE0B876ULL, 0x28BD8653E56A5D40ULL, 0x1AED8DA0B819D2BDULL,
+  0xC70D778BCCEF36A8ULL, 0x8D4857517C5941DAULL, 0x374AD8B83FE02477ULL,
+  0x1CA11815F4B8436AULL, 0x8665EEB269B687C3ULL,
+}; //g_nChaChaZeroKey
+
+/// Check the baseline PRNGs against their known answers, and ChaCha20 with
+/// a key set directly against its published keystream.
+/// \return Number of failures.
+
+static uint64_t CheckKnownBaselines(){
+  uint64_t failures = 0; //number of failures
+
+  for(auto& v: g_cBaselineVector){
+    const std::string name = v.m_szName; //name of PRNG
+    std::vector<uint64_t> w(1000); //first words of the stream
+
+    if(name == "SplitMix64")CSplitMix64(v.m_nSeed).fill(w.data(), w.size());
+    else if(name == "xoshiro256**")
+      CXoshiro256(v.m_nSeed).fill(w.data(), w.size());
+    else if(name == "PCG64"){
+      CPCG64 pcg; //seeded with a stream
+      pcg.srand(v.m_nSeed, v.m_nSeed == 42? 54: 0);
+      pcg.fill(w.data(), w.size());
+    } //else if
+    else if(name == "Philox4x64-10")
+      CPhilox4x64(v.m_nSeed).fill(w.data(), w.size());
+    else if(name == "ChaCha20")CChaCha20(v.m_nSeed).fill(w.data(), w.size());
+
+    const uint64_t got[4] = {w[0], w[1], w[2], w[999]}; //words checked
+
+    if(memcmp(got, v.m_nWord, sizeof(got)) != 0){
+      printf("    %s seed %" PRIu64 ": 0x%016" PRIX64 ", expected 0x%016"
+        PRIX64 "\n", v.m_szName, v.m_nSeed, got[0], v.m_nWord[0]);
+      failures++;
+    } //if
+  } //for
+
+  const uint32_t key[8] = {0}; //all-zero key
+  CChaCha20 chacha; //keyed directly
+  chacha.SetKey(key);
+
+  for(int i=0; i<8; i++)
+    if(chacha.rand() != g_nChaChaZeroKey[i])failures++;
+
+  return Report("known answers: baseline PRNGs", failures);
+} //CheckKnownBaselines
+
+#pragma endregion known
+
+///////////////////////////////////////////////////////////////////////////////
+//Differential checks
+
+#pragma region differential
+
+/// Check the composition, packed composition, hash, and AES finalizer
+/// kernels at every instruction set level that the CPU supports against the
+/// scalar kernels, on pseudorandom permutations and keys, which checks the
+/// AES instructions against the software AES where the CPU has them. The
+/// hash kernels are also given maps with arbitrary bytes in them.
+/// \param n Number of inputs.
+/// \return Number of failures.
+
+static uint64_t CheckKernels(uint64_t n){
+  const ISA saved = GetISA(); //to be restored
+
+  Compose32Fn compose[int(ISA::Count)] = {nullptr}; //kernels for each level
+  Hash32Fn hash[int(ISA::Count)] = {nullptr}; //kernels for each level
+  AES32Fn aes[int(ISA::Count)] = {nullptr}; //kernels for each level
+  Compose16Fn compose16[int(ISA::Count)] = {nullptr}; //kernels for each level
+
+  for(int i=0; i<int(ISA::Count); i++)
+    if(SetISA(ISA(i))){
+      compose[i] = Compose32;
+      hash[i] = Hash32;
+      aes[i] = AES32;
+      compose16[i] = Compose16;
+    } //if
+
+  SetISA(saved);
+
+  CMersenneTwister rng(1); //for inputs
+  uint64_t failures[int(ISA::Count)] = {0}; //failures at each level
+
+  for(uint64_t j=0; j<n; j++){
+    uint8_t m[32], p[32]; //maps
+    uint64_t key[32]; //hash key
+
+    RandomMap32(m, rng);
+    RandomMap32(p, rng);
+    rng.fill(key, 32);
+
+    uint8_t r[32]; //reference composition
+    memcpy(r, m, 32);
+    compose[0](r, p);
+    const uint64_t h = hash[0](m, key); //reference hash
+
+    uint8_t b[32]; //map with arbitrary bytes
+    for(int i=0; i<32; i++)
+      b[i] = uint8_t(key[i] >> 56);
+    const uint64_t hb = hash[0](b, key); //reference hash of b
+
+    uint64_t a[2]; //reference AES finalizer output
+    aes[0](m, key, a);
+
+    const uint64_t m16 = Pack16(m), p16 = Pack16(p); //packed maps
+    const uint64_t r16 = compose16[0](m16, p16); //reference composition
+
+    for(int i=1; i<int(ISA::Count); i++)
+      if(compose[i] != nullptr){
+        uint8_t x[32]; //composition at this level
+        memcpy(x, m, 32);
+        compose[i](x, p);
+
+        if(memcmp(x, r, 32) != 0)failures[i]++;
+        if(hash[i](m, key) != h)failures[i]++;
+        if(hash[i](b, key) != hb)failures[i]++;
+
+        uint64_t y[2]; //AES finalizer output at this level
+        aes[i](m, key, y);
+        if(y[0] != a[0] || y[1] != a[1])failures[i]++;
+
+        if(compose16[i](m16, p16) != r16)failures[i]++;
+      } //if
+  } //for
+
+  uint64_t total = 0; //total number of failures
+
+  for(int i=1; i<int(ISA::Count); i++){
+    const std::string name = std::string("kernels: ") + GetISAName(ISA(i)) +
+      " vs scalar";
+
+    if(compose[i] != nullptr)total += Report(name.c_str(), failures[i]);
+    else printf("  %-44s skipped\n", name.c_str());
+  } //for
+
+  return total;
+} //CheckKernels
+
+/// Check the Mersenne Twister at every instruction set level that the CPU
+/// supports, both one word at a time and in bulk with pseudorandom buffer
+/// sizes, against the standard library.
+/// \param n Number of words.
+/// \return Number of failures.
+
+static uint64_t CheckMersenneTwister(uint64_t n){
+  const ISA saved = GetISA(); //to be restored
+  uint64_t total = 0; //total number of failures
+
+  for(int i=0; i<int(ISA::Count); i++){
+    const std::string name = std::string("Mersenne Twister: ") +
+      GetISAName(ISA(i)) + " vs std";
+
+    if(!SetISA(ISA(i))){
+      printf("  %-44s skipped\n", name.c_str());
+      continue;
+    } //if
+
+    CMersenneTwister mt(5489ULL); //under test
+    std::mt19937_64 ref(5489ULL); //reference
+    CMersenneTwister rng(2); //for buffer sizes
+    std::vector<uint64_t> buffer(1024); //for bulk generation
+    uint64_t failures = 0; //number of failures
+
+    for(uint64_t j=0; j<n; )
+      j += CompareWords(mt, ref, rng()%2 == 1, rng, buffer, failures);
+
+    total += Report(name.c_str(), failures);
+  } //for
+
+  SetISA(saved);
+  return total;
+} //CheckMersenneTwister
+
+/// Check that the maps of the powers kept in the contiguous block of a power
+/// table match the permutations, and that each power is the previous one
+/// composed with the generator, for both generators of Cayley32.
+/// \return Number of failures.
+
+static uint64_t CheckPowerTables(){
+  Cayley32 cayley32; //for its generators
+  uintx_t seed = 1; //any seed
+  cayley32.srand(seed);
+
+  uint64_t failures = 0; //return result
+
+  for(int g=0; g<2; g++){
+    const CPerm p = cayley32.GetGenerator(g); //generator
+    CPowerTable table; //its power table
+    table.Initialize(p);
+
+    CPerm q(32); //p to the power i, computed the slow way
+
+    for(uint32_t i=0; i<table.GetOrder(); i++){
+      if(!(table[i] == q))failures++;
+      if(memcmp(table.GetMap(i), q.GetMap(), 32) != 0)failures++;
+
+      uint8_t r[32]; //q composed with p, computed the slowest way
+      for(int j=0; j<32; j++)
+        r[j] = p[q[j]];
+
+      q *= p;
+      if(memcmp(r, q.GetMap(), 32) != 0)failures++;
+    } //for
+
+    if(!q.IsIdentity())failures++;
+  } //for
+
+  return Report("power tables: block vs permutations", failures);
+} //CheckPowerTables
+
+/// Check packed permutations against CPerm for every size from 8 to 16: that
+/// the packed power tables of the generators of the packed Cayley PRNG
+/// match the powers computed with CPerm, that unpacking is the inverse of
+/// packing, and that the packed PRNG gives the same stream one word at a
+/// time and in bulk with pseudorandom buffer sizes.
+/// \param n Number of words for each size.
+/// \return Number of failures.
+
+static uint64_t CheckPacked(uint64_t n){
+  CMersenneTwister rng(6); //for seeding and choices
+  std::vector<uint64_t> buffer(1024); //for bulk generation
+  uint64_t failures = 0; //number of failures
+
+  for(uint32_t size=8; size<=16; size++){
+    CMersenneTwister seed(size); //for seeding
+    CCayleyPacked ref(size); //reference
+    ref.srand(seed);
+
+    for(int g=0; g<2; g++){
+      const CPackedPerm& p = ref.GetGenerator(g); //generator
+      const CPerm u = p.Unpack(); //unpacked
+      if(!(CPackedPerm(u) == p))failures++;
+
+      CPackedPowerTable table; //its packed power table
+      table.Initialize(p);
+      CPowerTable reference; //its power table
+      reference.Initialize(u);
+      if(table.GetOrder() != reference.GetOrder())failures++;
+
+      for(uint32_t i=0; i<std::min(table.GetOrder(), reference.GetOrder());
+        i++)
+        if(table.GetMap(i) != CPackedPerm(reference[i]).GetMap())failures++;
+    } //for
+
+    CMersenneTwister seed2(size); //for seeding the same way
+    CCayleyPacked test(size); //under test
+    test.srand(seed2);
+
+    for(uint64_t j=0; j<n; )
+      j += CompareWords(test, [&]{return ref.rand();}, rng()%2 == 1, rng,
+        buffer, failures);
+  } //for
+
+  return Report("packed: powers vs CPerm, rand vs fill", failures);
+} //CheckPacked
+
+/// Check that Cayley32 or Cayley32a gives the same stream one word at a
+/// time, in bulk with pseudorandom buffer sizes, at several prefetch
+/// distances, and after saving its state and loading it into another
+/// instance with a different seed, which then carries on in its place.
+/// \param name Name of the check.
+/// \param n Number of words.
+/// \return Number of failures.
+
+template<class cayley_t> static uint64_t CheckCayley32(const char* name,
+  uint64_t n)
+{
+  uintx_t seed("ABCDEF0123456789ABCDEF"); //any seed
+
+  cayley_t ref; //reference
+  ref.srand(seed);
+
+  cayley_t test[2]; //under test, share tables with the reference
+  uintx_t other("123456789ABCDEF"); //seed for the second one
+
+  for(int i=0; i<2; i++){
+    test[i].ShareTables(ref);
+    test[i].srand(i == 0? seed: other);
+  } //for
+
+  CMersenneTwister rng(3); //for choices
+  std::vector<uint64_t> buffer(1024); //for bulk generation
+  std::vector<uint8_t> state(ref.GetStateSize()); //saved state
+  const int distance[] = {0, 1, 4, 7, 16, 31}; //prefetch distances
+  int cur = 0; //index of the instance that is carrying on the stream
+  uint64_t failures = 0; //number of failures
+
+  for(uint64_t j=0; j<n; ){
+    const uint64_t choice = rng()%4; //what to do next
+
+    if(choice < 2) //one word or a bufferful
+      j += CompareWords(test[cur], [&]{return ref.rand();}, choice == 1,
+        rng, buffer, failures);
+
+    else if(choice == 2) //change prefetch distance
+      test[cur].SetPrefetch(distance[rng()%6]);
+
+    else{ //save state and load it into the other instance
+      test[cur].SaveState(state.data());
+      cur ^= 1;
+      if(!test[cur].LoadState(state.data()))failures++;
+    } //else
+  } //for
+
+  return Report(name, failures);
+} //CheckCayley32
+
+/// Check that Cayley32c gives the same stream one word at a time, in bulk
+/// with pseudorandom buffer sizes, block by block, and after seeking.
+/// \param n Number of words.
+/// \return Number of failures.
+
+static uint64_t CheckCayley32c(uint64_t n){
+  const uintx_t seed("ABCDEF0123456789ABCDEF"); //any seed
+  const uint64_t nBlocks = (n + Cayley32c::m_nBlockSize - 1)/
+    Cayley32c::m_nBlockSize; //number of blocks
+
+  Cayley32c ref; //reference, one word at a time
+  ref.srand(seed);
+
+  std::vector<uint64_t> stream(nBlocks*Cayley32c::m_nBlockSize); //all of it
+
+  for(auto& x: stream)
+    x = ref.rand();
+
+  Cayley32c test; //under test
+  test.ShareTables(ref);
+  test.srand(seed);
+
+  CMersenneTwister rng(4); //for choices
+  std::vector<uint64_t> buffer(4*Cayley32c::m_nBlockSize); //for bulk
+  uint64_t failures = 0; //number of failures
+
+  for(uint64_t b=0; b<nBlocks; b++){ //block by block, in reverse order
+    const uint64_t c = nBlocks - 1 - b; //block index
+    test.GetBlock(c, buffer.data());
+
+    if(memcmp(buffer.data(), &stream[c*Cayley32c::m_nBlockSize],
+      Cayley32c::m_nBlockSize*sizeof(uint64_t)) != 0)failures++;
+  } //for
+
+  for(uint64_t j=0; j<n; ){ //seek and read a bit
+    const uint64_t pos = rng()%stream.size(); //position
+    test.seek(pos);
+
+    const size_t m = std::min(size_t(rng()%buffer.size()) + 1,
+      size_t(stream.size() - pos)); //words
+    if(rng()%2 == 0)test.fill(buffer.data(), m);
+    else for(size_t k=0; k<m; k++)buffer[k] = test.rand();
+
+    if(memcmp(buffer.data(), &stream[pos], m*sizeof(uint64_t)) != 0)
+      failures++;
+
+    j += m;
+  } //for
+
+  return Report("Cayley32c: rand vs fill, blocks, seek", failures);
+} //CheckCayley32c
+
+/// Check that each stream of a bank gives the same stream as a Cayley32
+/// seeded with its seed, with streams advanced one at a time, all at once,
+/// and in pseudorandom subsets with repeats, and after some are reseeded.
+/// The number of streams is not a multiple of the batch size.
+/// \param n Number of words.
+/// \return Number of failures.
+
+static uint64_t CheckBank(uint64_t n){
+  const size_t streams = 257; //number of streams
+  const uint128w_t seed = uint128w_t("ABCDEF0123456789ABCDEF"); //any seed
+
+  Cayley32 owner; //owner of the power tables
+  owner.BuildTables();
+
+  CCayleyBank bank(streams); //under test
+  bank.ShareTables(owner);
+  bank.srand(seed);
+
+  std::vector<Cayley32> ref(streams); //reference, one for each stream
+
+  for(size_t i=0; i<streams; i++){
+    ref[i].ShareTables(owner);
+    ref[i].srand(CCayleyBank::GetSeed(seed, i));
+  } //for
+
+  CMersenneTwister rng(7); //for choices
+  std::vector<uint64_t> buffer(streams); //for bulk generation
+  std::vector<uint32_t> index(64); //for subsets
+  uint64_t failures = 0; //number of failures
+
+  for(uint64_t j=0; j<n; ){
+    switch(rng()%4){
+      case 0:{ //one word from one stream
+        const size_t i = size_t(rng()%streams); //stream index
+        if(bank.rand(i) != ref[i].rand())failures++;
+        j++;
+      } //case
+      break;
+
+      case 1: //a word from every stream
+        bank.fill(buffer.data());
+
+        for(size_t i=0; i<streams; i++)
+          if(buffer[i] != ref[i].rand())failures++;
+
+        j += streams;
+      break;
+
+      case 2:{ //a word from each of a subset, with repeats
+        const size_t m = size_t(rng()%index.size()) + 1; //number of words
+
+        for(size_t k=0; k<m; k++)
+          index[k] = uint32_t(rng()%(k%4 == 3? 4: streams));
+
+        bank.fill(index.data(), m, buffer.data());
+
+        for(size_t k=0; k<m; k++)
+          if(buffer[k] != ref[index[k]].rand())failures++;
+
+        j += m;
+      } //case
+      break;
+
+      case 3:{ //reseed a stream
+        const size_t i = size_t(rng()%streams); //stream index
+        const uint64_t hi = rng(), lo = rng(); //random 128 bits
+        const uint128w_t s = (uint128w_t(hi) << 64) | uint128w_t(lo);
+
+        bank.srand(i, s);
+        ref[i].srand(s);
+      } //case
+      break;
+    } //switch
+  } //for
+
+  return Report("Cayley bank: streams vs Cayley32", failures);
+} //CheckBank
+
+/// Check that CShuffle gives uniform permutations of 5 elements, both when
+/// shuffling in place and when scattering to buckets, by a chi-squared test
+/// with a threshold that a correct shuffle exceeds with probability about
+/// \f$10^{-6}\f$. Then check that it gives a permutation, the same one for
+/// 32-bit and 64-bit elements on any number of threads after reseeding
+/// alike, and a different one for the second shuffle after seeding.
+/// \param n Number of elements for the second part.
+/// \return Number of failures.
+
+static uint64_t CheckShuffle(uint64_t n){
+  const uint128w_t seed = uint128w_t("0123456789ABCDEF01234567"); //any seed
+  uint64_t failures = 0; //number of failures
+
+  CShuffle shuffle(1); //under test
+  shuffle.BuildTables();
+
+  for(size_t bucket: {size_t(16384), size_t(2)}){ //in place, scattered
+    const int trials = 200*120; //number of shuffles
+    std::vector<int> count(120, 0); //count of each permutation
+
+    shuffle.SetBlocking(2, bucket);
+    shuffle.srand(seed);
+
+    for(int t=0; t<trials; t++){
+      uint32_t a[5] = {0, 1, 2, 3, 4}; //to shuffle
+      shuffle.shuffle(a, 5);
+      int rank = 0; //Lehmer code of a
+
+      for(int i=0; i<5; i++){
+        int smaller = 0; //number of later elements smaller than a[i]
+
+        for(int j=i + 1; j<5; j++)
+          if(a[j] < a[i])smaller++;
+
+        rank = rank*(5 - i) + smaller;
+      } //for
+
+      count[rank]++;
+    } //for
+
+    double chi2 = 0; //chi-squared statistic, 119 degrees of freedom
+
+    for(int x: count)
+      chi2 += (x - 200.0)*(x - 200.0)/200.0;
+
+    if(chi2 > 200)failures++;
+  } //for
+
+  shuffle.SetBlocking(4096, 1024);
+  std::vector<uint32_t> a(n), b(n), first; //shuffled 32-bit elements
+  std::vector<uint64_t> c(n); //shuffled 64-bit elements
+  std::vector<uint8_t> seen(n, 0); //for checking a permutation
+
+  for(int call=0; call<2; call++){
+    for(uint64_t i=0; i<n; i++)
+      a[i] = b[i] = uint32_t(i), c[i] = i;
+
+    shuffle.SetThreads(1);
+    shuffle.srand(seed);
+    for(int j=0; j<=call; j++)shuffle.shuffle(a.data(), n);
+
+    shuffle.SetThreads(3);
+    shuffle.srand(seed);
+    for(int j=0; j<=call; j++)shuffle.shuffle(b.data(), n);
+
+    shuffle.SetThreads(2);
+    shuffle.srand(seed);
+    for(int j=0; j<=call; j++)shuffle.shuffle(c.data(), n);
+
+    std::fill(seen.begin(), seen.end(), 0);
+
+    for(uint64_t i=0; i<n; i++){
+      if(a[i] >= n || seen[a[i]]++)failures++;
+      if(b[i] != a[i] || c[i] != a[i])failures++;
+    } //for
+
+    if(call == 0)first = a;
+    else if(a == first)failures++;
+  } //for
+
+  return Report("shuffle: uniform, permutation, any threads", failures);
+} //CheckShuffle
+
+/// Check that wide permutations compose like CPerm, that composition,
+/// inversion, cycle decomposition, and powers give the same results on any
+/// number of threads with blocks of any size as on one thread without
+/// blocking, that powers made from cycles match repeated composition, and
+/// that the wide Cayley PRNG gives the same stream on one and three threads.
+/// \param n Size of the largest permutation.
+/// \return Number of failures.
+
+static uint64_t CheckWide(uint64_t n){
+  const size_t block = CWidePerm<uint32_t>::GetBlockSize(); //default
+  CMersenneTwister rng(7); //for inputs
+  uint64_t failures = 0; //number of failures
+
+  for(int j=0; j<16; j++){ //composition vs CPerm
+    uint8_t m0[32], m1[32]; //maps
+    RandomMap32(m0, rng);
+    RandomMap32(m1, rng);
+    CPerm p(32, m0), q(32, m1); //narrow permutations
+    CWidePerm<uint16_t> wp(p), wq(q); //wide permutations
+    p *= q;
+    wp *= wq;
+    if(!(wp == CWidePerm<uint16_t>(p)))failures++;
+  } //for
+
+  for(size_t size: {size_t(1000), size_t(n)}){
+    CWidePerm<uint32_t> a(size), b(size); //operands
+    a.Randomize(rng);
+    b.Randomize(rng);
+
+    CWidePerm<uint32_t>::SetBlockSize(0);
+    CWidePerm<uint32_t> ab = a; //reference product
+    ab *= b;
+    CWidePerm<uint32_t> inverse; //reference inverse
+    a.Invert(inverse);
+    CWideCycles<uint32_t> ref; //reference cycles
+    ref.Initialize(a);
+
+    for(size_t bs: {size_t(0), size_t(16), size_t(1024)})
+      for(uint32_t nThreads: {1U, 3U}){
+        CWidePerm<uint32_t>::SetBlockSize(bs);
+
+        CWidePerm<uint32_t> c = a; //product
+        c.Compose(b.GetMap(), nThreads);
+        if(!(c == ab))failures++;
+
+        a.Invert(c, nThreads);
+        if(!(c == inverse))failures++;
+        c.Compose(a.GetMap(), nThreads);
+        if(!c.IsIdentity())failures++;
+
+        CWideCycles<uint32_t> cycles; //cycles under test
+        cycles.Initialize(a, nThreads);
+        if(cycles.GetCount() != ref.GetCount())failures++;
+
+        for(size_t i=0; i<std::min(cycles.GetCount(), ref.GetCount()); i++)
+          if(cycles.GetLength(i) != ref.GetLength(i) ||
+            !std::equal(ref.GetCycle(i), ref.GetCycle(i) + ref.GetLength(i),
+              cycles.GetCycle(i)))failures++;
+
+        std::vector<uint32_t> power(size); //map of a power
+        CWidePerm<uint32_t> p(size); //power by repeated composition
+
+        for(uint64_t k=0; k<4; k++){
+          cycles.GetPower(k, power.data(), nThreads);
+          if(!std::equal(power.begin(), power.end(), p.GetMap()))failures++;
+          p *= a;
+        } //for
+      } //for
+  } //for
+
+  CWidePerm<uint32_t>::SetBlockSize(block);
+
+  for(size_t bs: {block, size_t(1024)}){ //the PRNG, blocked or not
+    CWidePerm<uint32_t>::SetBlockSize(bs);
+    CMersenneTwister seed0(8), seed1(8); //for seeding alike
+    CCayleyWide<uint32_t> one(262144, 1), three(262144, 3); //under test
+    one.srand(seed0);
+    three.srand(seed1);
+
+    for(int j=0; j<4; j++)
+      if(one.rand() != three.rand())failures++;
+  } //for
+
+  CWidePerm<uint32_t>::SetBlockSize(block);
+
+  return Report("wide: blocked and threaded vs direct", failures);
+} //CheckWide
+
+/// Check unranking and ranking of pseudorandom permutations of size 32 with
+/// uintx_t against uint128w_t, and that ranking is the inverse of
+/// unranking.
+/// \param n Number of permutations.
+/// \return Number of failures.
+
+static uint64_t CheckRanks(uint64_t n){
+  const uint128w_t factorial("32AD5A155C6748AC18B9A580000000"); //32!
+  CMersenneTwister rng(5); //for inputs
+  uint64_t failures = 0; //number of failures
+
+  for(uint64_t j=0; j<n; j++){
+    const uint64_t hi = rng(), lo = rng(); //random 128 bits
+    const uint128w_t m = ((uint128w_t(hi) << 64) | uint128w_t(lo))%factorial;
+    const uintx_t mx = (ToUintx(uint64_t(m >> 64)) << 64) +
+      ToUintx(uint64_t(m)); //m as a uintx_t
+
+    CPerm p(32), q(32); //unranked both ways
+    p.SetNum(m);
+    q.SetNum(mx);
+
+    if(!(p == q))failures++;
+    if(!(p.GetNum<uint128w_t>() == m))failures++;
+    if(q.GetNum<uintx_t>() != mx)failures++;
+  } //for
+
+  return Report("rank and unrank: uintx_t vs uint128w_t", failures);
+} //CheckRanks
+
+/// Check uintx_t multiplication, division, remainder, and bitwise OR on
+/// pseudorandom operands of 1 to 200 words, in both operand orders, against
+/// schoolbook multiplication and word-by-word OR. Division is checked by
+/// making a dividend \f$qy + r\f$ from a pseudorandom quotient \f$q\f$ and
+/// remainder \f$r < y\f$, which reaches Algorithm D with divisors of any
+/// length.
+/// \param n Number of pairs of operands.
+/// \return Number of failures.
+
+static uint64_t CheckLongArithmetic(uint64_t n){
+  CMersenneTwister rng(10); //for operands
+  uint64_t failures = 0; //number of failures
+
+  //dividend q*y + r for remainder r < y, as words
+  auto dividend = [](const std::vector<uint32_t>& q,
+    const std::vector<uint32_t>& y, const std::vector<uint32_t>& r)
+  {
+    std::vector<uint32_t> x = MulReference(q, y); //return result
+    x.resize(std::max(x.size(), r.size()) + 1, 0);
+    uint64_t carry = 0; //carry word
+
+    for(size_t i=0; i<x.size(); i++){
+      carry += uint64_t(x[i]) + (i < r.size()? r[i]: 0);
+      x[i] = uint32_t(carry);
+      carry >>= 32;
+    } //for
+
+    while(!x.empty() && x.back() == 0)x.pop_back();
+    return x;
+  }; //dividend
+
+  for(uint64_t j=0; j<n; j++){
+    const size_t m = size_t(rng()%200) + 1; //length of a
+    const size_t k = size_t(rng()%200) + 1; //length of b
+    const std::vector<uint32_t> a = RandomWords(m, rng); //operand
+    const std::vector<uint32_t> b = RandomWords(k, rng); //operand
+    const uintx_t x = FromWords(a), y = FromWords(b); //as uintx_t
+
+    const std::vector<uint32_t> ab = MulReference(a, b); //product
+    if(ToWords(x*y) != ab || ToWords(y*x) != ab)failures++;
+
+    std::vector<uint32_t> o = m > k? a: b; //a OR b
+    for(size_t i=0; i<std::min(m, k); i++)o[i] = a[i] | b[i];
+    if(ToWords(x | y) != o || ToWords(y | x) != o)failures++;
+
+    for(int side=0; side<2; side++){ //divide by b, then by a
+      const std::vector<uint32_t>& d = side == 0? b: a; //divisor
+      std::vector<uint32_t> r = RandomWords(d.size(), rng); //remainder
+      r.back() = uint32_t(rng()%d.back()); //so that r < d
+
+      const std::vector<uint32_t> q = RandomWords(side == 0? m: k, rng);
+      const uintx_t u = FromWords(dividend(q, d, r)); //dividend
+      const uintx_t v = FromWords(d); //divisor
+      while(!r.empty() && r.back() == 0)r.pop_back();
+
+      if(ToWords(u/v) != q || ToWords(u%v) != r)failures++;
+    } //for
+  } //for
+
+  return Report("uintx_t: 1 to 200 words vs schoolbook", failures);
+} //CheckLongArithmetic
+
+/// Check uintx_t multiplication against schoolbook multiplication for
+/// operand lengths on both sides of the Karatsuba threshold of 48 words,
+/// with equal and unequal lengths, odd lengths so that the split is uneven,
+/// a shorter operand no longer than the upper half of the longer, and
+/// operands unbalanced enough to be multiplied by slices, in both orders
+/// and as part of muladd().
+/// \return Number of failures.
+
+static uint64_t CheckMultiplication(){
+  const int length[][2] = {
+    {47, 47}, {48, 48}, {49, 49}, {47, 48}, {48, 60}, {95, 96}, {96, 96},
+    {97, 97}, {97, 49}, {97, 50}, {97, 60}, {131, 130}, {150, 48},
+    {150, 75}, {199, 99}, {200, 200}, {1, 200}
+  }; //operand lengths in words
+
+  CMersenneTwister rng(9); //for operands
+  uint64_t failures = 0; //number of failures
+
+  for(auto& len: length)
+    for(int j=0; j<4; j++){
+      const std::vector<uint32_t> a = RandomWords(len[0], rng); //operand
+      const std::vector<uint32_t> b = RandomWords(len[1], rng); //operand
+      const std::vector<uint32_t> ab = MulReference(a, b); //product
+      const uintx_t x = FromWords(a), y = FromWords(b); //as uintx_t
+
+      if(ToWords(x*y) != ab)failures++;
+      if(ToWords(y*x) != ab)failures++;
+
+      uintx_t z = 1; //for muladd
+      muladd(z, x, y);
+      if(z != FromWords(ab) + uintx_t(1))failures++;
+    } //for
+
+  return Report("uintx_t: Karatsuba vs schoolbook", failures);
+} //CheckMultiplication
+
+/// Check uintx_t arithmetic on pseudorandom 64-bit operands against the
+/// compiler's 128-bit integers, where it has them.
+/// \param n Number of pairs of operands.
+/// \return Number of failures.
+
+static uint64_t CheckArithmetic(uint64_t n){
+  #if defined(__SIZEOF_INT128__) //gcc and clang
+    typedef unsigned __int128 u128; //reference
+    CMersenneTwister rng(6); //for inputs
+    uint64_t failures = 0; //number of failures
+
+    //whether a uintx_t has a 128-bit value
+    auto same = [](const uintx_t& x, u128 y){
+      return (uint64_t)x == uint64_t(y) &&
+        (uint64_t)(x >> 64) == uint64_t(y >> 64) && (x >> 128) == 0U;
+    }; //same
+
+    for(uint64_t j=0; j<n; j++){
+      const int s = int(rng()%64); //shift distance
+      const uint64_t a = rng() >> int(rng()%64); //operands of many sizes
+      const uint64_t b = (rng() >> int(rng()%64)) | 1; //nonzero
+      const uintx_t x = ToUintx(a), y = ToUintx(b); //operands as uintx_t
+
+      if(!same(x + y, u128(a) + b))failures++;
+      if(!same(x*y, u128(a)*b))failures++;
+      if(!same(x/y, a/b))failures++;
+      if(!same(x%y, a%b))failures++;
+      if(!same(x << s, u128(a) << s))failures++;
+      if(!same(x >> s, a >> s))failures++;
+      if(a >= b && !same(x - y, a - b))failures++;
+      if((x < y) != (a < b))failures++;
+      if((x == y) != (a == b))failures++;
+    } //for
+
+    return Report("uintx_t: vs 128-bit integers", failures);
+  #else
+    printf("  %-44s skipped\n", "uintx_t: vs 128-bit integers");
+    return 0;
+  #endif
+} //CheckArithmetic
+
+#pragma endregion differential
+
+///////////////////////////////////////////////////////////////////////////////
+//Self-check
+
+/// Run the known-answer checks, then the differential checks, printing the
+/// result of each to stdout.
+/// \param n Number of inputs for each differential check. The slower ones
+///   use fewer.
+/// \return true If every check passed.
+
+bool SelfCheck(uint64_t n){
+  printf("Self-check using %s kernels.\n", GetISAName(GetISA()));
+
+  uint64_t failures = 0; //number of failures
+
+  failures += CheckKnownStreams();
+  failures += CheckKnownRanks();
+  failures += CheckKnownArithmetic();
+  failures += CheckKnownBaselines();
+
+  failures += CheckKernels(n);
+  failures += CheckMersenneTwister(n);
+  failures += CheckPowerTables();
+  failures += CheckCayley32<Cayley32>(
+    "Cayley32: rand vs fill, prefetch, state", n);
+  failures += CheckCayley32<Cayley32a>(
+    "Cayley32a: rand vs fill, prefetch, state", n);
+  failures += CheckCayley32c(n/16);
+  failures += CheckPacked(n/16);
+  failures += CheckBank(n/4);
+  failures += CheckShuffle(n/16);
+  failures += CheckWide(n/4);
+  failures += CheckRanks(n/16);
+  failures += CheckArithmetic(n);
+  failures += CheckMultiplication();
+  failures += CheckLongArithmetic(n/1024);
+
+  if(failures == 0)printf("All checks passed.\n");
+  else printf("%" PRIu64 " checks failed.\n", failures);
+
+  return failures == 0;
+} //SelfCheck
@@ -0,0 +1,11 @@
+/// \file Check.h
+/// \brief Declaration of the self-check.
+
+#ifndef __check__
+#define __check__
+
+#include <cinttypes>
+
+bool SelfCheck(uint64_t n); ///< Known-answer and differential checks.
+
+#endif
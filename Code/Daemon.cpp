@@ -0,0 +1,332 @@
+/// \file Daemon.cpp
+/// \brief Implementation of the entropy-serving daemon.
+///
+/// The daemon listens on a Unix domain socket and serves pseudorandom bytes
+/// from Cayley32. Each client gets its own stream, seeded independently
+/// from the Mersenne Twister, but all streams share a single copy of the
+/// power tables. The protocol is as simple as it gets: a request is an
+/// 8-byte little-endian unsigned byte count, and the reply to a request
+/// is that many pseudorandom bytes. A client may send many requests in one
+/// write and the replies are sent back-to-back in order.
+
+#include "Includes.h"
+#include "Daemon.h"
+#include "Cayley32.h"
+#include "mt19937-64.h"
+
+#ifdef __linux__ //Linux epoll and Unix domain sockets
+
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+static volatile sig_atomic_t g_bQuit = 0; ///< Set by a signal to stop serving.
+
+/// \brief Signal handler.
+///
+/// Ask the daemon to shut down cleanly.
+
+static void OnSignal(int /*sig*/){
+  g_bQuit = 1;
+} //OnSignal
+
+/// \brief A client of the daemon.
+///
+/// A client consists of a connection, a warm Cayley32 stream sharing the
+/// daemon's power tables, and a reusable output buffer. Clients are recycled
+/// when their connection closes, so that a new connection costs only the
+/// reseeding of the current permutation.
+
+class CClient{
+  public:
+    static const size_t m_nBufSize = 8192; ///< Buffer size in 64-bit words.
+
+    int m_nFd = -1; ///< Socket file descriptor, -1 if not connected.
+    Cayley32 m_cStream; ///< Pseudorandom stream.
+
+    uint64_t m_nBuffer[m_nBufSize]; ///< Output buffer.
+    size_t m_nBegin = 0; ///< Index of first unsent byte in buffer.
+    size_t m_nEnd = 0; ///< Index one past last unsent byte in buffer.
+    uint64_t m_nPending = 0; ///< Bytes requested but not yet in the buffer.
+
+    uint8_t m_nRequest[sizeof(uint64_t)]; ///< Partially received request.
+    size_t m_nRequestBytes = 0; ///< Number of bytes in m_nRequest.
+
+    bool m_bWriting = false; ///< Whether we are waiting to be writable.
+    bool m_bClosed = false; ///< Whether the client has closed its end.
+
+    CClient(const Cayley32& warm); ///< Constructor.
+
+    void Connect(int fd, CMersenneTwister& mt); ///< Attach to a new connection.
+    bool Read(); ///< Read requests.
+    bool Write(); ///< Write replies.
+    bool HasOutput() const; ///< Whether there is output to be sent.
+    bool IsDone() const; ///< Whether the connection can be closed.
+}; //CClient
+
+/// Share the power tables of a warm instance of Cayley32.
+/// \param warm An instance of Cayley32 that has been seeded.
+
+CClient::CClient(const Cayley32& warm){
+  m_cStream.ShareTables(warm);
+} //constructor
+
+/// Attach to a new connection, reseed the stream, and forget any state
+/// left over from the previous connection.
+/// \param fd Socket file descriptor.
+/// \param mt Mersenne Twister used to seed the stream.
+
+void CClient::Connect(int fd, CMersenneTwister& mt){
+  m_nFd = fd;
+  m_nBegin = m_nEnd = 0;
+  m_nPending = 0;
+  m_nRequestBytes = 0;
+  m_bWriting = false;
+  m_bClosed = false;
+
+  const uint64_t hi = mt.rand(); //high word of seed, drawn first
+  const uint64_t lo = mt.rand(); //low word of seed
+  m_cStream.srand((uint128w_t(hi) << 64) | uint128w_t(lo));
+} //Connect
+
+/// Read as many requests as are available and add them to the number of
+/// pending bytes. If the client has closed its end, note it, so that the
+/// replies it has already asked for can still be sent.
+/// \return false If the connection failed.
+
+bool CClient::Read(){
+  uint8_t buf[4096]; //input buffer
+
+  while(true){
+    const ssize_t n = read(m_nFd, buf, sizeof(buf)); //bytes read
+
+    if(n == 0){ //client has closed its end
+      m_bClosed = true;
+      return true;
+    } //if
+
+    if(n < 0)return errno == EAGAIN || errno == EWOULDBLOCK;
+
+    for(ssize_t i=0; i<n; i++){ //for each byte read
+      m_nRequest[m_nRequestBytes++] = buf[i];
+
+      if(m_nRequestBytes == sizeof(uint64_t)){ //a complete request
+        uint64_t count = 0; //requested byte count
+
+        for(int j=sizeof(uint64_t) - 1; j>=0; j--) //little-endian
+          count = (count << 8) | m_nRequest[j];
+
+        m_nPending += count;
+        m_nRequestBytes = 0;
+      } //if
+    } //for
+  } //while
+} //Read
+
+/// Write as much output as the socket will accept, refilling the buffer from
+/// the stream as necessary. To be fair to other clients, at most a few
+/// bufferfuls are sent each time.
+/// \return false If the connection failed.
+
+bool CClient::Write(){
+  const uint8_t* p = (const uint8_t*)m_nBuffer; //buffer as bytes
+
+  for(int count=0; count<4 && HasOutput(); ){
+    if(m_nBegin == m_nEnd){ //refill buffer
+      const uint64_t bytes = std::min(m_nPending,
+        uint64_t(m_nBufSize*sizeof(uint64_t))); //bytes to generate
+      const uint64_t words = (bytes + sizeof(uint64_t) - 1)/sizeof(uint64_t);
+
+      for(uint64_t i=0; i<words; i++)
+        m_nBuffer[i] = m_cStream.rand();
+
+      m_nBegin = 0;
+      m_nEnd = (size_t)bytes;
+      m_nPending -= bytes;
+      count++;
+    } //if
+
+    const ssize_t n = send(m_nFd, p + m_nBegin, m_nEnd - m_nBegin,
+      MSG_NOSIGNAL | MSG_DONTWAIT); //bytes sent
+
+    if(n < 0)return errno == EAGAIN || errno == EWOULDBLOCK;
+    m_nBegin += n;
+  } //for
+
+  return true;
+} //Write
+
+/// Test whether there is output waiting to be generated or sent.
+/// \return true If there is output.
+
+bool CClient::HasOutput() const{
+  return m_nBegin < m_nEnd || m_nPending > 0;
+} //HasOutput
+
+/// Test whether the connection can be closed, which is when the client has
+/// closed its end and every reply that it asked for has been sent.
+/// \return true If the connection can be closed.
+
+bool CClient::IsDone() const{
+  return m_bClosed && !HasOutput();
+} //IsDone
+
+/// Register interest in a client's socket becoming writable exactly when
+/// it has output waiting, and in it becoming readable until the client
+/// closes its end.
+/// \param ep Epoll file descriptor.
+/// \param c A client.
+/// \param closed Whether the client had closed its end before this event.
+
+static void UpdateInterest(int ep, CClient* c, bool closed){
+  const bool writing = c->HasOutput(); //whether we want to write
+
+  if(writing != c->m_bWriting || closed != c->m_bClosed){
+    epoll_event e; //epoll event
+    e.events = (c->m_bClosed? 0U: uint32_t(EPOLLIN)) |
+      (writing? uint32_t(EPOLLOUT): 0U);
+    e.data.ptr = c;
+    epoll_ctl(ep, EPOLL_CTL_MOD, c->m_nFd, &e);
+    c->m_bWriting = writing;
+  } //if
+} //UpdateInterest
+
+/// Create a non-blocking Unix domain socket listening at a path. Any
+/// existing file at that path is removed first.
+/// \param path Path name of the socket.
+/// \return Socket file descriptor, or -1 on failure.
+
+static int Listen(const char* path){
+  sockaddr_un addr; //socket address
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+
+  if(strlen(path) >= sizeof(addr.sun_path))return -1; //path too long
+  strcpy(addr.sun_path, path);
+
+  const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  if(fd < 0)return -1;
+
+  unlink(path); //remove stale socket
+
+  if(bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, 64) < 0){
+    close(fd);
+    return -1;
+  } //if
+
+  return fd;
+} //Listen
+
+#endif
+
+/// Serve pseudorandom bytes from Cayley32 over a Unix domain socket until
+/// interrupted by SIGINT or SIGTERM. Clients are served by a single thread
+/// using epoll. Each client stream is seeded from a Mersenne Twister that
+/// is itself seeded from the low 64 bits of the seed. Requests that are not a multiple
+/// of 8 bytes are rounded up internally and the excess discarded.
+/// \param path Path name of the socket.
+/// \param seed Seed for the warm instance that owns the power tables.
+/// \return true If the daemon shut down cleanly.
+
+bool Serve(const char* path, const uintx_t& seed){
+  #ifdef __linux__
+    const int fd = Listen(path); //listening socket
+
+    if(fd < 0){
+      fprintf(stderr, "Cannot listen on %s\n", path);
+      return false;
+    } //if
+
+    const int ep = epoll_create1(0); //epoll file descriptor
+    epoll_event e; //epoll event
+    e.events = EPOLLIN;
+    e.data.ptr = nullptr; //the listening socket has no client
+    epoll_ctl(ep, EPOLL_CTL_ADD, fd, &e);
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+    signal(SIGPIPE, SIG_IGN);
+
+    Cayley32 warm; //owner of the power tables
+    uintx_t s(seed); //seed for the warm instance
+    warm.srand(s);
+
+    CMersenneTwister mt((uint64_t)seed); //seeds the client streams
+
+    std::vector<CClient*> clients; //all clients ever created
+    std::vector<CClient*> idle; //clients waiting for a connection
+
+    const int nEvents = 64; //maximum number of events per wait
+    epoll_event events[nEvents]; //events
+
+    fprintf(stderr, "Serving Cayley32 on %s\n", path);
+
+    while(!g_bQuit){
+      const int n = epoll_wait(ep, events, nEvents, -1); //number of events
+
+      for(int i=0; i<n; i++){
+        CClient* c = (CClient*)events[i].data.ptr; //client, if any
+
+        if(c == nullptr){ //new connections
+          int cfd; //client socket
+
+          while((cfd = accept4(fd, nullptr, nullptr, SOCK_NONBLOCK)) >= 0){
+            if(idle.empty()){ //need a new client
+              clients.push_back(new CClient(warm));
+              idle.push_back(clients.back());
+            } //if
+
+            c = idle.back();
+            idle.pop_back();
+            c->Connect(cfd, mt);
+
+            e.events = EPOLLIN;
+            e.data.ptr = c;
+            epoll_ctl(ep, EPOLL_CTL_ADD, cfd, &e);
+          } //while
+        } //if
+
+        else{ //existing connection
+          bool ok = true; //whether the connection is still good
+          const bool closed = c->m_bClosed; //whether closed before now
+
+          if(!closed && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+            ok = c->Read();
+
+          if(ok)ok = c->Write() && !c->IsDone();
+
+          if(ok)UpdateInterest(ep, c, closed);
+
+          else{ //done or failed, recycle the client
+            epoll_ctl(ep, EPOLL_CTL_DEL, c->m_nFd, nullptr);
+            close(c->m_nFd);
+            c->m_nFd = -1;
+            idle.push_back(c);
+          } //else
+        } //else
+      } //for
+    } //while
+
+    //clean up and exit
+
+    for(CClient* c: clients){
+      if(c->m_nFd >= 0)
+        close(c->m_nFd);
+      delete c;
+    } //for
+
+    close(ep);
+    close(fd);
+    unlink(path);
+
+    fprintf(stderr, "Stopped serving on %s\n", path);
+    return true;
+
+  #else //other OS
+    fprintf(stderr, "The daemon requires Linux\n");
+    return false;
+  #endif
+} //Serve
@@ -0,0 +1,11 @@
+/// \file Daemon.h
+/// \brief Declaration of the entropy-serving daemon.
+
+#ifndef __daemon__
+#define __daemon__
+
+#include "uintx_t.h"
+
+bool Serve(const char* path, const uintx_t& seed); ///< Serve pseudorandom bytes.
+
+#endif
@@ -0,0 +1,235 @@
+/// \file Engines.cpp
+/// \brief Implementation of the engine registry CEngines and the startup
+/// profile CStartupProfile.
+
+#include "Includes.h"
+#include "Engines.h"
+#include "Threads.h"
+
+uint64_t WallTimeInNanoseconds(); ///< Wall clock time in nanoseconds.
+
+///////////////////////////////////////////////////////////////////////////////
+//CStartupProfile functions
+
+#pragma region profile
+
+/// The constructor starts the clock for the first phase.
+
+CStartupProfile::CStartupProfile():
+  m_nStart(WallTimeInNanoseconds()), m_nLast(m_nStart){
+} //constructor
+
+/// Turn recording on or off. Nothing is recorded or printed until this
+/// is called with true, which is expected to be as soon as the command
+/// line has been parsed.
+/// \param b True to record phases.
+
+void CStartupProfile::Enable(bool b){
+  m_bEnabled = b;
+} //Enable
+
+/// End a phase and start the next one.
+/// \param name Name of the phase that has just ended.
+
+void CStartupProfile::Mark(const std::string& name){
+  if(!m_bEnabled)return;
+
+  const uint64_t t = WallTimeInNanoseconds(); //end of this phase
+  m_stdPhase.push_back(std::make_pair(name, t - m_nLast));
+  m_nLast = t;
+} //Mark
+
+/// Print the phases to stderr, so as not to get mixed up with pseudorandom
+/// bits on stdout, with the time spent in each in milliseconds and as a
+/// percentage of the total. This does nothing after the first call.
+
+void CStartupProfile::Print(){
+  if(!m_bEnabled || m_bPrinted)return;
+  m_bPrinted = true;
+
+  const uint64_t total = m_nLast - m_nStart; //total time in nanoseconds
+
+  fprintf(stderr, "Startup profile:\n");
+
+  for(auto& phase: m_stdPhase)
+    fprintf(stderr, "  %-20s %10.3f ms %5.1f%%\n", phase.first.c_str(),
+      phase.second/1e6, total == 0? 0.0: 100.0*phase.second/total);
+
+  fprintf(stderr, "  %-20s %10.3f ms\n", "total", total/1e6);
+} //Print
+
+#pragma endregion profile
+
+///////////////////////////////////////////////////////////////////////////////
+//CEngines functions
+
+#pragma region engines
+
+/// The constructor remembers the settings but does not construct any
+/// engines.
+/// \param seed Seed.
+/// \param prefetch Prefetch distance for the Cayley engines, 0 for none.
+/// \param profile Startup profile to record construction times in.
+
+CEngines::CEngines(const uintx_t& seed, int prefetch,
+  CStartupProfile& profile):
+  m_cSeed(seed), m_nPrefetch(prefetch), m_cProfile(profile){
+} //constructor
+
+/// The destructor deletes the engines that have been constructed, Cayley32c
+/// and Cayley32a before Cayley32, whose power tables they borrow.
+
+CEngines::~CEngines(){
+  delete m_pCayley32a;
+  delete m_pCayley32c;
+  delete m_pCayley32;
+  delete m_pCayley32e;
+  delete m_pPacked;
+  delete m_pWide16;
+  delete m_pWide32;
+  delete m_pMT;
+} //destructor
+
+/// Get the Mersenne Twister, seeded with the low 64 bits of the seed.
+/// \return Reference to the Mersenne Twister.
+
+CMersenneTwister& CEngines::GetMT(){
+  if(m_pMT == nullptr){
+    m_pMT = new CMersenneTwister((uint64_t)m_cSeed);
+    m_cProfile.Mark("mt19937-64 seed");
+  } //if
+
+  return *m_pMT;
+} //GetMT
+
+/// Get Cayley32, building its power tables and seeding it the first time.
+/// \return Reference to Cayley32.
+
+Cayley32& CEngines::GetCayley32(){
+  if(m_pCayley32 == nullptr){
+    m_pCayley32 = new Cayley32;
+    m_pCayley32->SetPrefetch(m_nPrefetch);
+    m_pCayley32->BuildTables();
+    m_cProfile.Mark("cayley32 tables");
+
+    m_pCayley32->srand(m_cSeed);
+    m_cProfile.Mark("cayley32 seed");
+  } //if
+
+  return *m_pCayley32;
+} //GetCayley32
+
+/// Get Cayley32e, seeding it the first time from a Mersenne Twister of its
+/// own that is seeded with the low 64 bits of the seed. Its power tables
+/// are built while its generators are being chosen, so they are timed
+/// together with seeding.
+/// \return Reference to Cayley32e.
+
+Cayley32e& CEngines::GetCayley32e(){
+  if(m_pCayley32e == nullptr){
+    CMersenneTwister mt((uint64_t)m_cSeed); //for seeding
+
+    m_pCayley32e = new Cayley32e;
+    m_pCayley32e->SetPrefetch(m_nPrefetch);
+    m_pCayley32e->srand(mt);
+    m_cProfile.Mark("cayley32e seed");
+  } //if
+
+  return *m_pCayley32e;
+} //GetCayley32e
+
+/// Get Cayley32c, keyed with the low 128 bits of the seed, sharing the power
+/// tables of Cayley32, which is constructed if need be.
+/// \return Reference to Cayley32c.
+
+Cayley32c& CEngines::GetCayley32c(){
+  if(m_pCayley32c == nullptr){
+    Cayley32& cayley32 = GetCayley32(); //for its tables
+
+    m_pCayley32c = new Cayley32c;
+    m_pCayley32c->SetPrefetch(m_nPrefetch);
+    m_pCayley32c->ShareTables(cayley32);
+    m_pCayley32c->srand(m_cSeed);
+    m_cProfile.Mark("cayley32c seed");
+  } //if
+
+  return *m_pCayley32c;
+} //GetCayley32c
+
+/// Get Cayley32a, seeded like Cayley32, sharing the power tables of
+/// Cayley32, which is constructed if need be.
+/// \return Reference to Cayley32a.
+
+Cayley32a& CEngines::GetCayley32a(){
+  if(m_pCayley32a == nullptr){
+    Cayley32& cayley32 = GetCayley32(); //for its tables
+
+    m_pCayley32a = new Cayley32a;
+    m_pCayley32a->SetPrefetch(m_nPrefetch);
+    m_pCayley32a->ShareTables(cayley32);
+    m_pCayley32a->srand(m_cSeed);
+    m_cProfile.Mark("cayley32a seed");
+  } //if
+
+  return *m_pCayley32a;
+} //GetCayley32a
+
+/// Get the packed Cayley PRNG, seeding it the first time from a Mersenne
+/// Twister of its own that is seeded with the low 64 bits of the seed,
+/// as for Cayley32e.
+/// \param n Permutation size, \f$8 \leq n \leq 16\f$, which is used only
+///   the first time.
+/// \return Reference to the packed Cayley PRNG.
+
+CCayleyPacked& CEngines::GetPacked(uint32_t n){
+  if(m_pPacked == nullptr){
+    CMersenneTwister mt((uint64_t)m_cSeed); //for seeding
+
+    m_pPacked = new CCayleyPacked(n);
+    m_pPacked->srand(mt);
+    m_cProfile.Mark("packed seed");
+  } //if
+
+  return *m_pPacked;
+} //GetPacked
+
+/// Get the wide Cayley PRNG with 16-bit maps, seeding it the first time
+/// from a Mersenne Twister of its own that is seeded with the low 64 bits
+/// of the seed, as for Cayley32e.
+/// \param n Permutation size, \f$256 \leq n \leq 2^{16}\f$, which is used
+///   only the first time.
+/// \return Reference to the wide Cayley PRNG.
+
+CCayleyWide<uint16_t>& CEngines::GetWide16(size_t n){
+  if(m_pWide16 == nullptr){
+    CMersenneTwister mt((uint64_t)m_cSeed); //for seeding
+
+    m_pWide16 = new CCayleyWide<uint16_t>(n);
+    m_pWide16->srand(mt);
+    m_cProfile.Mark("wide seed");
+  } //if
+
+  return *m_pWide16;
+} //GetWide16
+
+/// Get the wide Cayley PRNG with 32-bit maps, seeding it the first time
+/// from a Mersenne Twister of its own that is seeded with the low 64 bits
+/// of the seed, as for Cayley32e. It uses all of the logical cores for
+/// each step if the permutations are big enough.
+/// \param n Permutation size, at least 256, which is used only the first
+///   time.
+/// \return Reference to the wide Cayley PRNG.
+
+CCayleyWide<uint32_t>& CEngines::GetWide32(size_t n){
+  if(m_pWide32 == nullptr){
+    CMersenneTwister mt((uint64_t)m_cSeed); //for seeding
+
+    m_pWide32 = new CCayleyWide<uint32_t>(n, GetCoreCount());
+    m_pWide32->srand(mt);
+    m_cProfile.Mark("wide seed");
+  } //if
+
+  return *m_pWide32;
+} //GetWide32
+
+#pragma endregion engines
@@ -0,0 +1,82 @@
+/// \file Engines.h
+/// \brief Declaration of the engine registry CEngines and the startup
+/// profile CStartupProfile.
+
+#ifndef __engines__
+#define __engines__
+
+#include <string>
+#include <vector>
+
+#include "uintx_t.h"
+#include "Cayley32.h"
+#include "CayleyPacked.h"
+#include "CayleyWide.h"
+#include "mt19937-64.h"
+
+/// \brief Time spent in the phases of starting up.
+///
+/// A list of named phases and the wall clock time spent in each, in the
+/// order in which they finished. Phases are timed from the end of the
+/// previous one, or from construction for the first, so that the times
+/// add up to the time since construction.
+
+class CStartupProfile{
+  private:
+    bool m_bEnabled = false; ///< Whether to record anything.
+    bool m_bPrinted = false; ///< Whether Print() has been called.
+    uint64_t m_nStart = 0; ///< Time of construction in nanoseconds.
+    uint64_t m_nLast = 0; ///< Time that the last phase ended.
+    std::vector<std::pair<std::string, uint64_t>> m_stdPhase; ///< Phases.
+
+  public:
+    CStartupProfile(); ///< Constructor.
+
+    void Enable(bool b); ///< Turn recording on or off.
+    void Mark(const std::string& name); ///< End a phase.
+    void Print(); ///< Print the phases to stderr.
+}; //CStartupProfile
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// \brief Engines constructed on demand.
+///
+/// A registry of the PRNG engines that the tasks in Main.cpp use, each of
+/// which is constructed and seeded only the first time that it is asked
+/// for, so that a task pays only for the engines that it uses. Cayley32,
+/// Cayley32c, and Cayley32a share power tables. The time taken to construct
+/// each engine is recorded in a startup profile under its name.
+
+class CEngines{
+  private:
+    uintx_t m_cSeed; ///< Seed.
+    int m_nPrefetch = 0; ///< Prefetch distance.
+    CStartupProfile& m_cProfile; ///< Startup profile.
+
+    CMersenneTwister* m_pMT = nullptr; ///< Mersenne Twister.
+    Cayley32* m_pCayley32 = nullptr; ///< Cayley32.
+    Cayley32e* m_pCayley32e = nullptr; ///< Cayley32e.
+    Cayley32c* m_pCayley32c = nullptr; ///< Cayley32c.
+    Cayley32a* m_pCayley32a = nullptr; ///< Cayley32a.
+    CCayleyPacked* m_pPacked = nullptr; ///< Packed Cayley PRNG.
+    CCayleyWide<uint16_t>* m_pWide16 = nullptr; ///< Wide Cayley PRNG, 16-bit maps.
+    CCayleyWide<uint32_t>* m_pWide32 = nullptr; ///< Wide Cayley PRNG, 32-bit maps.
+
+  public:
+    CEngines(const uintx_t& seed, int prefetch, CStartupProfile& profile); ///< Constructor.
+    CEngines(const CEngines&) = delete; ///< No copy constructor.
+    ~CEngines(); ///< Destructor.
+
+    CEngines& operator=(const CEngines&) = delete; ///< No assignment.
+
+    CMersenneTwister& GetMT(); ///< Get the Mersenne Twister.
+    Cayley32& GetCayley32(); ///< Get Cayley32.
+    Cayley32e& GetCayley32e(); ///< Get Cayley32e.
+    Cayley32c& GetCayley32c(); ///< Get Cayley32c.
+    Cayley32a& GetCayley32a(); ///< Get Cayley32a.
+    CCayleyPacked& GetPacked(uint32_t n); ///< Get the packed Cayley PRNG.
+    CCayleyWide<uint16_t>& GetWide16(size_t n); ///< Get the wide Cayley PRNG, 16-bit maps.
+    CCayleyWide<uint32_t>& GetWide32(size_t n); ///< Get the wide Cayley PRNG, 32-bit maps.
+}; //CEngines
+
+#endif
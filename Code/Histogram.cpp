@@ -0,0 +1,128 @@
+/// \file Histogram.cpp
+/// \brief Implementation of the latency histogram CHistogram.
+
+#include "Includes.h"
+#include "Histogram.h"
+
+/// Number of bits needed to represent a value.
+/// \param x A value.
+/// \return Position of the most significant 1 bit plus one, or 0 if x is 0.
+
+static inline int BitLength(uint64_t x){
+  #if defined(__GNUC__) //gcc and clang
+    return x == 0? 0: 64 - __builtin_clzll(x);
+  #else //portable
+    int b = 0; //return result
+    for(; x; x>>=1)b++;
+    return b;
+  #endif
+} //BitLength
+
+/// Constructor.
+
+CHistogram::CHistogram(){
+  const int n = (1 << m_nSubBits) + (64 - m_nSubBits)*(1 << (m_nSubBits - 1));
+  m_nBucket.resize(n, 0);
+} //constructor
+
+/// Get the index of the bucket that a value is recorded in. Values less
+/// than \f$2^{S}\f$ have a bucket each. A larger value is shifted right until
+/// it has \f$S\f$ bits and the top bit is dropped, so that each power of 2
+/// above \f$2^{S}\f$ has \f$2^{S-1}\f$ buckets.
+/// \param x A value.
+/// \return Bucket index.
+
+int CHistogram::GetIndex(uint64_t x){
+  const int shift = BitLength(x) - m_nSubBits; //amount to shift right by
+
+  if(shift <= 0)return int(x); //small value, exact
+
+  const int half = 1 << (m_nSubBits - 1); //sub-buckets per power of 2
+  return 2*half + (shift - 1)*half + int(x >> shift) - half;
+} //GetIndex
+
+/// Get the largest value that is recorded in a bucket.
+/// \param i Bucket index.
+/// \return Largest value in bucket i.
+
+uint64_t CHistogram::GetUpper(int i){
+  const int half = 1 << (m_nSubBits - 1); //sub-buckets per power of 2
+
+  if(i < 2*half)return uint64_t(i); //small value, exact
+
+  const int shift = (i - 2*half)/half + 1; //amount shifted right by
+  const uint64_t top = uint64_t((i - 2*half)%half + half); //top bits
+
+  return ((top + 1) << shift) - 1;
+} //GetUpper
+
+/// Record a value.
+/// \param x A value.
+
+void CHistogram::Record(uint64_t x){
+  m_nBucket[GetIndex(x)]++;
+  m_nCount++;
+  m_nMin = std::min(m_nMin, x);
+  m_nMax = std::max(m_nMax, x);
+  m_dSum += double(x);
+} //Record
+
+/// Forget all of the values recorded so far.
+
+void CHistogram::Clear(){
+  std::fill(m_nBucket.begin(), m_nBucket.end(), 0);
+  m_nCount = 0;
+  m_nMin = UINT64_MAX;
+  m_nMax = 0;
+  m_dSum = 0;
+} //Clear
+
+/// Get the number of values recorded.
+/// \return Number of values recorded.
+
+uint64_t CHistogram::GetCount() const{
+  return m_nCount;
+} //GetCount
+
+/// Get the smallest value recorded.
+/// \return Smallest value recorded, or 0 if there are none.
+
+uint64_t CHistogram::GetMin() const{
+  return m_nCount == 0? 0: m_nMin;
+} //GetMin
+
+/// Get the largest value recorded.
+/// \return Largest value recorded, or 0 if there are none.
+
+uint64_t CHistogram::GetMax() const{
+  return m_nMax;
+} //GetMax
+
+/// Get the mean of the values recorded.
+/// \return Mean of values recorded, or 0 if there are none.
+
+double CHistogram::GetMean() const{
+  return m_nCount == 0? 0: m_dSum/double(m_nCount);
+} //GetMean
+
+/// Get the value at a percentile, that is, the smallest value such that
+/// the given percentage of the values recorded are no larger than it, to
+/// within the precision of the buckets. Like HDR histograms, the largest
+/// value in the bucket is reported, but never more than the maximum.
+/// \param p Percentile, \f$0 \leq p \leq 100\f$.
+/// \return Value at percentile p, or 0 if there are no values.
+
+uint64_t CHistogram::GetPercentile(double p) const{
+  if(m_nCount == 0)return 0;
+
+  const double target = std::ceil(double(m_nCount)*p/100.0); //rank wanted
+  const uint64_t rank = std::max(uint64_t(target), uint64_t(1)); //safety
+  uint64_t sum = 0; //number of values in buckets so far
+
+  for(int i=0; i<(int)m_nBucket.size(); i++){
+    sum += m_nBucket[i];
+    if(sum >= rank)return std::min(GetUpper(i), m_nMax);
+  } //for
+
+  return m_nMax;
+} //GetPercentile
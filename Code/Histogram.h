@@ -0,0 +1,45 @@
+/// \file Histogram.h
+/// \brief Declaration of the latency histogram CHistogram.
+
+#ifndef __histogram__
+#define __histogram__
+
+#include <cinttypes>
+#include <vector>
+
+/// \brief A log-linear histogram of 64-bit values.
+///
+/// An HDR-style histogram that records values exactly below
+/// \f$2^{S}\f$, where \f$S\f$ is the number of sub-bucket bits, and above
+/// that splits each power of 2 into \f$2^{S-1}\f$ equal buckets, so that
+/// every value is recorded with a relative error of less than
+/// \f$2^{1-S}\f$ in a fixed amount of memory. Recording a value takes
+/// constant time and does not allocate.
+
+class CHistogram{
+  private:
+    static const int m_nSubBits = 6; ///< Number of sub-bucket bits.
+
+    std::vector<uint64_t> m_nBucket; ///< Number of values in each bucket.
+    uint64_t m_nCount = 0; ///< Number of values recorded.
+    uint64_t m_nMin = UINT64_MAX; ///< Smallest value recorded.
+    uint64_t m_nMax = 0; ///< Largest value recorded.
+    double m_dSum = 0; ///< Sum of values recorded.
+
+    static int GetIndex(uint64_t x); ///< Bucket index of a value.
+    static uint64_t GetUpper(int i); ///< Largest value in a bucket.
+
+  public:
+    CHistogram(); ///< Constructor.
+
+    void Record(uint64_t x); ///< Record a value.
+    void Clear(); ///< Forget all values.
+
+    uint64_t GetCount() const; ///< Number of values recorded.
+    uint64_t GetMin() const; ///< Smallest value recorded.
+    uint64_t GetMax() const; ///< Largest value recorded.
+    double GetMean() const; ///< Mean of values recorded.
+    uint64_t GetPercentile(double p) const; ///< Value at a percentile.
+}; //CHistogram
+
+#endif
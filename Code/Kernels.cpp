@@ -0,0 +1,586 @@
+/// \file Kernels.cpp
+/// \brief Implementation of the runtime-dispatched permutation and hash kernels.
+///
+/// Each kernel is compiled for several instruction set levels using
+/// per-function target attributes, so the rest of the code can be compiled
+/// for baseline x86-64. The best level supported by the CPU is selected at
+/// startup using cpuid, unless it is overridden by setting the environment
+/// variable CAYLEY_ISA to one of scalar, sse4.2, avx2, or avx512, which is
+/// useful for testing each path. All levels produce identical results.
+
+#include <stdlib.h>
+
+#include "Includes.h"
+#include "Kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) //x86-64
+  #define CAYLEY_X86 ///< Define to compile the x86 kernels.
+  #include <immintrin.h>
+
+  #ifdef _MSC_VER //Windows Visual Studio
+    #include <intrin.h>
+    #define TARGET(s) ///< MSVC allows intrinsics anywhere.
+  #else
+    #define TARGET(s) __attribute__((target(s))) ///< Compile for ISA s.
+  #endif
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+//Scalar kernels
+
+#pragma region scalar
+
+/// Scalar composition kernel for permutations of size 32.
+/// \param m [IN, OUT] Permutation map to be updated.
+/// \param p Permutation map to apply.
+
+static void Compose32Scalar(uint8_t* m, const uint8_t* p){
+  for(int i=0; i<32; i++)
+    m[i] = p[m[i]];
+} //Compose32Scalar
+
+/// Scalar hash kernel for permutations of size 32.
+/// \param m Permutation map.
+/// \param key 32 64-bit multipliers.
+/// \return Exclusive-or of the products of the map entries and the key.
+
+static uint64_t Hash32Scalar(const uint8_t* m, const uint64_t* key){
+  uint64_t h = 0; //return result
+
+  for(int i=0; i<32; i++)
+    h ^= m[i]*key[i];
+
+  return h;
+} //Hash32Scalar
+
+/// Scalar composition kernel for packed permutations of size at most 16.
+/// \param m Packed permutation map to be updated.
+/// \param p Packed permutation map to apply.
+/// \return Updated map.
+
+static uint64_t Compose16Scalar(uint64_t m, uint64_t p){
+  uint64_t r = 0; //return result
+
+  for(int i=0; i<64; i+=4)
+    r |= ((p >> 4*((m >> i) & 0xF)) & 0xF) << i;
+
+  return r;
+} //Compose16Scalar
+
+/// \brief The AES S-box.
+
+static const uint8_t g_nSBox[256] = {
+  0x63,0x7c,0x77,0x7b,0xf2,0x6b,0x6f,0xc5,0x30,0x01,0x67,0x2b,0xfe,0xd7,0xab,0x76,
+  0xca,0x82,0xc9,0x7d,0xfa,0x59,0x47,0xf0,0xad,0xd4,0xa2,0xaf,0x9c,0xa4,0x72,0xc0,
+  0xb7,0xfd,0x93,0x26,0x36,0x3f,0xf7,0xcc,0x34,0xa5,0xe5,0xf1,0x71,0xd8,0x31,0x15,
+  0x04,0xc7,0x23,0xc3,0x18,0x96,0x05,0x9a,0x07,0x12,0x80,0xe2,0xeb,0x27,0xb2,0x75,
+  0x09,0x83,0x2c,0x1a,0x1b,0x6e,0x5a,0xa0,0x52,0x3b,0xd6,0xb3,0x29,0xe3,0x2f,0x84,
+  0x53,0xd1,0x00,0xed,0x20,0xfc,0xb1,0x5b,0x6a,0xcb,0xbe,0x39,0x4a,0x4c,0x58,0xcf,
+  0xd0,0xef,0xaa,0xfb,0x43,0x4d,0x33,0x85,0x45,0xf9,0x02,0x7f,0x50,0x3c,0x9f,0xa8,
+  0x51,0xa3,0x40,0x8f,0x92,0x9d,0x38,0xf5,0xbc,0xb6,0xda,0x21,0x10,0xff,0xf3,0xd2,
+  0xcd,0x0c,0x13,0xec,0x5f,0x97,0x44,0x17,0xc4,0xa7,0x7e,0x3d,0x64,0x5d,0x19,0x73,
+  0x60,0x81,0x4f,0xdc,0x22,0x2a,0x90,0x88,0x46,0xee,0xb8,0x14,0xde,0x5e,0x0b,0xdb,
+  0xe0,0x32,0x3a,0x0a,0x49,0x06,0x24,0x5c,0xc2,0xd3,0xac,0x62,0x91,0x95,0xe4,0x79,
+  0xe7,0xc8,0x37,0x6d,0x8d,0xd5,0x4e,0xa9,0x6c,0x56,0xf4,0xea,0x65,0x7a,0xae,0x08,
+  0xba,0x78,0x25,0x2e,0x1c,0xa6,0xb4,0xc6,0xe8,0xdd,0x74,0x1f,0x4b,0xbd,0x8b,0x8a,
+  0x70,0x3e,0xb5,0x66,0x48,0x03,0xf6,0x0e,0x61,0x35,0x57,0xb9,0x86,0xc1,0x1d,0x9e,
+  0xe1,0xf8,0x98,0x11,0x69,0xd9,0x8e,0x94,0x9b,0x1e,0x87,0xe9,0xce,0x55,0x28,0xdf,
+  0x8c,0xa1,0x89,0x0d,0xbf,0xe6,0x42,0x68,0x41,0x99,0x2d,0x0f,0xb0,0x54,0xbb,0x16
+}; //g_nSBox
+
+/// Multiply by x in the AES field \f$GF(2^8)\f$.
+/// \param b A field element.
+/// \return b times x.
+
+static inline uint8_t XTime(uint8_t b){
+  return uint8_t((b << 1) ^ ((b >> 7)*0x1B));
+} //XTime
+
+/// One AES encryption round in software, exactly like the aesenc
+/// instruction: ShiftRows, SubBytes, MixColumns, then add the round key.
+/// The state is in column order, as it is in an SSE register.
+/// \param s [IN, OUT] 16-byte state.
+/// \param k 16-byte round key.
+
+static void AESRoundScalar(uint8_t* s, const uint8_t* k){
+  uint8_t t[16]; //state after ShiftRows and SubBytes
+
+  for(int c=0; c<4; c++)
+    for(int r=0; r<4; r++)
+      t[4*c + r] = g_nSBox[s[4*((c + r)%4) + r]];
+
+  for(int c=0; c<4; c++){ //MixColumns and AddRoundKey
+    const uint8_t* a = t + 4*c; //column
+    const uint8_t x = a[0] ^ a[1] ^ a[2] ^ a[3]; //sum of column
+
+    for(int r=0; r<4; r++)
+      s[4*c + r] = a[r] ^ x ^ XTime(a[r] ^ a[(r + 1)%4]) ^ k[4*c + r];
+  } //for
+} //AESRoundScalar
+
+/// Scalar AES finalizer kernel for permutations of size 32. The key words
+/// are stored little-endian, as they would be loaded into a register.
+/// \param m Permutation map.
+/// \param key Three 128-bit keys, low word first.
+/// \param out [OUT] Two 64-bit words, low word first.
+
+static void AES32Scalar(const uint8_t* m, const uint64_t* key, uint64_t* out){
+  uint8_t k[48]; //keys as bytes
+  for(int i=0; i<48; i++)
+    k[i] = uint8_t(key[i/8] >> (8*(i%8)));
+
+  uint8_t s[16]; //state
+  for(int i=0; i<16; i++)
+    s[i] = m[i] ^ k[i];
+
+  AESRoundScalar(s, m + 16);
+  AESRoundScalar(s, k + 16);
+  AESRoundScalar(s, k + 32);
+
+  for(int i=0; i<2; i++){
+    out[i] = 0;
+    for(int j=7; j>=0; j--)
+      out[i] = (out[i] << 8) | s[8*i + j];
+  } //for
+} //AES32Scalar
+
+#pragma endregion scalar
+
+#ifdef CAYLEY_X86
+
+///////////////////////////////////////////////////////////////////////////////
+//SSE4.2 kernels
+
+#pragma region sse42
+
+/// SSE4.2 composition kernel for permutations of size 32. Each half of the
+/// map is looked up in both halves of p using pshufb, and the results are
+/// blended according to bit 4 of the map entries.
+/// \param m [IN, OUT] Permutation map to be updated.
+/// \param p Permutation map to apply.
+
+TARGET("sse4.2") static void Compose32SSE42(uint8_t* m, const uint8_t* p){
+  const __m128i lo = _mm_loadu_si128((const __m128i*)p); //p[0..15]
+  const __m128i hi = _mm_loadu_si128((const __m128i*)(p + 16)); //p[16..31]
+
+  for(int i=0; i<32; i+=16){
+    const __m128i idx = _mm_loadu_si128((const __m128i*)(m + i)); //indices
+    const __m128i sel = _mm_slli_epi16(idx, 3); //bit 4 to bit 7 for blend
+    const __m128i r = _mm_blendv_epi8(_mm_shuffle_epi8(lo, idx),
+      _mm_shuffle_epi8(hi, idx), sel);
+    _mm_storeu_si128((__m128i*)(m + i), r);
+  } //for
+} //Compose32SSE42
+
+/// SSE4.2 hash kernel for permutations of size 32. The map entries are less
+/// than 256, so each 64-bit product is assembled from two 32-bit multiplies.
+/// \param m Permutation map.
+/// \param key 32 64-bit multipliers.
+/// \return Exclusive-or of the products of the map entries and the key.
+
+TARGET("sse4.2") static uint64_t Hash32SSE42(const uint8_t* m,
+  const uint64_t* key)
+{
+  __m128i h = _mm_setzero_si128(); //two partial hashes
+
+  for(int i=0; i<32; i+=2){
+    uint16_t pair; //two map entries
+    memcpy(&pair, m + i, sizeof(pair));
+
+    const __m128i x = _mm_cvtepu8_epi64(_mm_cvtsi32_si128(pair));
+    const __m128i k = _mm_loadu_si128((const __m128i*)(key + i));
+    const __m128i lo = _mm_mul_epu32(x, k); //x times low half of k
+    const __m128i hi = _mm_mul_epu32(x, _mm_srli_epi64(k, 32)); //high half
+
+    h = _mm_xor_si128(h, _mm_add_epi64(lo, _mm_slli_epi64(hi, 32)));
+  } //for
+
+  return uint64_t(_mm_cvtsi128_si64(h)) ^
+    uint64_t(_mm_cvtsi128_si64(_mm_unpackhi_epi64(h, h)));
+} //Hash32SSE42
+
+/// SSE4.2 composition kernel for packed permutations of size at most 16.
+/// Both maps are unpacked into one byte per entry, composed with a single
+/// pshufb, and packed again by multiplying each odd byte by 16 and adding it
+/// to the even byte before it.
+/// \param m Packed permutation map to be updated.
+/// \param p Packed permutation map to apply.
+/// \return Updated map.
+
+TARGET("sse4.2") static uint64_t Compose16SSE42(uint64_t m, uint64_t p){
+  const __m128i mask = _mm_set1_epi8(0x0F); //low nibble of each byte
+
+  const __m128i x = _mm_cvtsi64_si128(int64_t(m));
+  const __m128i y = _mm_cvtsi64_si128(int64_t(p));
+
+  const __m128i idx = _mm_unpacklo_epi8(_mm_and_si128(x, mask),
+    _mm_and_si128(_mm_srli_epi16(x, 4), mask)); //m one entry per byte
+  const __m128i tab = _mm_unpacklo_epi8(_mm_and_si128(y, mask),
+    _mm_and_si128(_mm_srli_epi16(y, 4), mask)); //p one entry per byte
+
+  const __m128i r = _mm_maddubs_epi16(_mm_shuffle_epi8(tab, idx),
+    _mm_set1_epi16(0x1001)); //pairs of entries in the low byte of each word
+
+  return uint64_t(_mm_cvtsi128_si64(_mm_packus_epi16(r, r)));
+} //Compose16SSE42
+
+#pragma endregion sse42
+
+///////////////////////////////////////////////////////////////////////////////
+//AVX2 kernels
+
+#pragma region avx2
+
+/// AVX2 composition kernel for permutations of size 32. Like the SSE4.2
+/// kernel, but the whole map is done at once.
+/// \param m [IN, OUT] Permutation map to be updated.
+/// \param p Permutation map to apply.
+
+TARGET("avx2") static void Compose32AVX2(uint8_t* m, const uint8_t* p){
+  const __m256i tab = _mm256_loadu_si256((const __m256i*)p); //p[0..31]
+  const __m256i lo = _mm256_permute2x128_si256(tab, tab, 0x00); //p[0..15] x2
+  const __m256i hi = _mm256_permute2x128_si256(tab, tab, 0x11); //p[16..31] x2
+
+  const __m256i idx = _mm256_loadu_si256((const __m256i*)m); //indices
+  const __m256i sel = _mm256_slli_epi16(idx, 3); //bit 4 to bit 7 for blend
+  const __m256i r = _mm256_blendv_epi8(_mm256_shuffle_epi8(lo, idx),
+    _mm256_shuffle_epi8(hi, idx), sel);
+
+  _mm256_storeu_si256((__m256i*)m, r);
+} //Compose32AVX2
+
+/// AVX2 hash kernel for permutations of size 32. Like the SSE4.2 kernel, but
+/// four products at a time.
+/// \param m Permutation map.
+/// \param key 32 64-bit multipliers.
+/// \return Exclusive-or of the products of the map entries and the key.
+
+TARGET("avx2") static uint64_t Hash32AVX2(const uint8_t* m,
+  const uint64_t* key)
+{
+  __m256i h = _mm256_setzero_si256(); //four partial hashes
+
+  for(int i=0; i<32; i+=4){
+    uint32_t quad; //four map entries
+    memcpy(&quad, m + i, sizeof(quad));
+
+    const __m256i x = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(quad));
+    const __m256i k = _mm256_loadu_si256((const __m256i*)(key + i));
+    const __m256i lo = _mm256_mul_epu32(x, k); //x times low half of k
+    const __m256i hi = _mm256_mul_epu32(x, _mm256_srli_epi64(k, 32));
+
+    h = _mm256_xor_si256(h, _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32)));
+  } //for
+
+  const __m128i g = _mm_xor_si128(_mm256_castsi256_si128(h),
+    _mm256_extracti128_si256(h, 1)); //two partial hashes
+
+  return uint64_t(_mm_cvtsi128_si64(g)) ^
+    uint64_t(_mm_cvtsi128_si64(_mm_unpackhi_epi64(g, g)));
+} //Hash32AVX2
+
+#pragma endregion avx2
+
+///////////////////////////////////////////////////////////////////////////////
+//AVX-512 kernels
+
+#pragma region avx512
+
+/// AVX-512 composition kernel for permutations of size 32, which is a single
+/// byte permute instruction (vpermb).
+/// \param m [IN, OUT] Permutation map to be updated.
+/// \param p Permutation map to apply.
+
+TARGET("avx512f,avx512vl,avx512bw,avx512vbmi")
+static void Compose32AVX512(uint8_t* m, const uint8_t* p){
+  const __m256i tab = _mm256_loadu_si256((const __m256i*)p); //p[0..31]
+  const __m256i idx = _mm256_loadu_si256((const __m256i*)m); //indices
+  _mm256_storeu_si256((__m256i*)m, _mm256_permutexvar_epi8(idx, tab));
+} //Compose32AVX512
+
+/// AVX-512 hash kernel for permutations of size 32, using 64-bit multiplies
+/// eight at a time.
+/// \param m Permutation map.
+/// \param key 32 64-bit multipliers.
+/// \return Exclusive-or of the products of the map entries and the key.
+
+TARGET("avx512f,avx512dq")
+static uint64_t Hash32AVX512(const uint8_t* m, const uint64_t* key){
+  __m512i h = _mm512_setzero_si512(); //eight partial hashes
+
+  for(int i=0; i<32; i+=8){
+    const __m512i x = _mm512_cvtepu8_epi64(_mm_loadl_epi64((const __m128i*)(m + i)));
+    const __m512i k = _mm512_loadu_si512((const void*)(key + i));
+    h = _mm512_xor_si512(h, _mm512_mullo_epi64(x, k));
+  } //for
+
+  const __m256i g = _mm256_xor_si256(_mm512_castsi512_si256(h),
+    _mm512_extracti64x4_epi64(h, 1)); //four partial hashes
+  const __m128i f = _mm_xor_si128(_mm256_castsi256_si128(g),
+    _mm256_extracti128_si256(g, 1)); //two partial hashes
+
+  return uint64_t(_mm_cvtsi128_si64(f)) ^
+    uint64_t(_mm_cvtsi128_si64(_mm_unpackhi_epi64(f, f)));
+} //Hash32AVX512
+
+#pragma endregion avx512
+
+///////////////////////////////////////////////////////////////////////////////
+//AES-NI kernels
+
+#pragma region aesni
+
+/// AES-NI finalizer kernel for permutations of size 32.
+/// \param m Permutation map.
+/// \param key Three 128-bit keys, low word first.
+/// \param out [OUT] Two 64-bit words, low word first.
+
+TARGET("aes,sse4.2")
+static void AES32AESNI(const uint8_t* m, const uint64_t* key, uint64_t* out){
+  const __m128i a = _mm_loadu_si128((const __m128i*)m); //m[0..15]
+  const __m128i b = _mm_loadu_si128((const __m128i*)(m + 16)); //m[16..31]
+
+  __m128i s = _mm_xor_si128(a, _mm_loadu_si128((const __m128i*)key));
+  s = _mm_aesenc_si128(s, b);
+  s = _mm_aesenc_si128(s, _mm_loadu_si128((const __m128i*)(key + 2)));
+  s = _mm_aesenc_si128(s, _mm_loadu_si128((const __m128i*)(key + 4)));
+
+  _mm_storeu_si128((__m128i*)out, s);
+} //AES32AESNI
+
+#pragma endregion aesni
+
+#endif //CAYLEY_X86
+
+///////////////////////////////////////////////////////////////////////////////
+//Dispatch
+
+#pragma region dispatch
+
+static ISA g_eISA = ISA::Scalar; ///< ISA level of the selected kernels.
+static bool g_bAESNI = false; ///< Whether the AES-NI kernel is selected.
+
+/// Get the best instruction set level supported by this CPU and operating
+/// system. AVX-512 requires the VBMI extension for the byte permute.
+/// \return Best ISA level.
+
+ISA GetBestISA(){
+  #if defined(CAYLEY_X86) && defined(_MSC_VER) //Windows Visual Studio
+    int r[4]; //eax, ebx, ecx, edx
+    __cpuid(r, 0);
+    const int maxleaf = r[0]; //highest supported leaf
+
+    __cpuid(r, 1);
+    const bool sse42 = (r[2] & (1 << 20)) != 0;
+    const bool osxsave = (r[2] & (1 << 27)) != 0;
+    const uint64_t xcr0 = osxsave? _xgetbv(0): 0; //OS-enabled state
+
+    int s[4] = {0}; //extended features
+    if(maxleaf >= 7)__cpuidex(s, 7, 0);
+
+    const bool avx2 = (xcr0 & 0x6) == 0x6 && (s[1] & (1 << 5)) != 0;
+    const bool avx512 = (xcr0 & 0xE6) == 0xE6 &&
+      (s[1] & (1 << 16)) != 0 && (s[1] & (1 << 17)) != 0 && //F, DQ
+      (s[1] & (1 << 30)) != 0 && (s[1] & (1 << 31)) != 0 && //BW, VL
+      (s[2] & (1 << 1)) != 0; //VBMI
+
+  #elif defined(CAYLEY_X86) //gcc or clang
+    __builtin_cpu_init();
+    const bool sse42 = __builtin_cpu_supports("sse4.2") != 0;
+    const bool avx2 = __builtin_cpu_supports("avx2") != 0;
+    const bool avx512 = __builtin_cpu_supports("avx512f") &&
+      __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512bw") &&
+      __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512vbmi");
+
+  #else //not x86-64
+    const bool sse42 = false, avx2 = false, avx512 = false;
+  #endif
+
+  if(avx512 && avx2)return ISA::AVX512;
+  if(avx2)return ISA::AVX2;
+  if(sse42)return ISA::SSE42;
+  return ISA::Scalar;
+} //GetBestISA
+
+/// Find out whether the CPU has the AES instructions. They are independent
+/// of the ISA levels, but are only used at SSE4.2 and above, so that
+/// CAYLEY_ISA=scalar tests the software AES.
+/// \return true If it does.
+
+bool HasAESNI(){
+  #if defined(CAYLEY_X86) && defined(_MSC_VER) //Windows Visual Studio
+    int r[4]; //eax, ebx, ecx, edx
+    __cpuid(r, 1);
+    return (r[2] & (1 << 25)) != 0;
+  #elif defined(CAYLEY_X86) //gcc or clang
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes") != 0;
+  #else //not x86-64
+    return false;
+  #endif
+} //HasAESNI
+
+/// Reader function for whether the selected AES finalizer kernel uses the
+/// AES instructions.
+/// \return true If it does.
+
+bool UsingAESNI(){
+  return g_bAESNI;
+} //UsingAESNI
+
+/// Reader function for the instruction set level of the selected kernels.
+/// \return ISA level.
+
+ISA GetISA(){
+  return g_eISA;
+} //GetISA
+
+/// Get the printable name of an instruction set level, which is also the
+/// name used by CAYLEY_ISA.
+/// \param isa ISA level.
+/// \return Name.
+
+const char* GetISAName(ISA isa){
+  switch(isa){
+    case ISA::SSE42:  return "sse4.2";
+    case ISA::AVX2:   return "avx2";
+    case ISA::AVX512: return "avx512";
+    default:          return "scalar";
+  } //switch
+} //GetISAName
+
+/// Select the kernels for an instruction set level.
+/// \param isa ISA level.
+/// \return true If successful, false if the CPU does not support it, in which
+/// case the selection is unchanged.
+
+bool SetISA(ISA isa){
+  if(isa > GetBestISA())return false;
+
+  g_eISA = isa;
+
+  switch(isa){
+    #ifdef CAYLEY_X86
+      case ISA::SSE42:
+        Compose32 = Compose32SSE42;
+        Hash32 = Hash32SSE42;
+      break;
+
+      case ISA::AVX2:
+        Compose32 = Compose32AVX2;
+        Hash32 = Hash32AVX2;
+      break;
+
+      case ISA::AVX512:
+        Compose32 = Compose32AVX512;
+        Hash32 = Hash32AVX512;
+      break;
+    #endif
+
+    default:
+      Compose32 = Compose32Scalar;
+      Hash32 = Hash32Scalar;
+  } //switch
+
+  #ifdef CAYLEY_X86
+    Compose16 = isa > ISA::Scalar? Compose16SSE42: Compose16Scalar;
+  #else
+    Compose16 = Compose16Scalar;
+  #endif
+
+  g_bAESNI = isa > ISA::Scalar && HasAESNI();
+
+  #ifdef CAYLEY_X86
+    AES32 = g_bAESNI? AES32AESNI: AES32Scalar;
+  #else
+    AES32 = AES32Scalar;
+  #endif
+
+  return true;
+} //SetISA
+
+/// Select the kernels at startup: the best that the CPU supports, unless
+/// overridden by the environment variable CAYLEY_ISA.
+/// \return true.
+
+static bool SelectKernels(){
+  ISA isa = GetBestISA(); //ISA level to be used
+  const char* env = getenv("CAYLEY_ISA"); //override
+
+  if(env != nullptr){
+    int i = 0;
+
+    while(i < (int)ISA::Count && strcmp(env, GetISAName(ISA(i))) != 0)
+      i++;
+
+    if(i == (int)ISA::Count)
+      fprintf(stderr, "CAYLEY_ISA=%s is unknown, using %s\n", env,
+        GetISAName(isa));
+
+    else if(ISA(i) > isa)
+      fprintf(stderr, "CAYLEY_ISA=%s is not supported, using %s\n", env,
+        GetISAName(isa));
+
+    else isa = ISA(i);
+  } //if
+
+  return SetISA(isa);
+} //SelectKernels
+
+/// Composition kernel used before the kernels have been selected, which can
+/// only happen during static initialization. It selects the kernels and then
+/// calls the selected one.
+/// \param m [IN, OUT] Permutation map to be updated.
+/// \param p Permutation map to apply.
+
+static void Compose32Resolve(uint8_t* m, const uint8_t* p){
+  SelectKernels();
+  Compose32(m, p);
+} //Compose32Resolve
+
+/// Hash kernel used before the kernels have been selected, which can only
+/// happen during static initialization. It selects the kernels and then
+/// calls the selected one.
+/// \param m Permutation map.
+/// \param key 32 64-bit multipliers.
+/// \return Exclusive-or of the products of the map entries and the key.
+
+static uint64_t Hash32Resolve(const uint8_t* m, const uint64_t* key){
+  SelectKernels();
+  return Hash32(m, key);
+} //Hash32Resolve
+
+/// Packed composition kernel used before the kernels have been selected,
+/// which can only happen during static initialization. It selects the
+/// kernels and then calls the selected one.
+/// \param m Packed permutation map to be updated.
+/// \param p Packed permutation map to apply.
+/// \return Updated map.
+
+static uint64_t Compose16Resolve(uint64_t m, uint64_t p){
+  SelectKernels();
+  return Compose16(m, p);
+} //Compose16Resolve
+
+/// AES finalizer kernel used before the kernels have been selected, which
+/// can only happen during static initialization. It selects the kernels and
+/// then calls the selected one.
+/// \param m Permutation map.
+/// \param key Three 128-bit keys, low word first.
+/// \param out [OUT] Two 64-bit words, low word first.
+
+static void AES32Resolve(const uint8_t* m, const uint64_t* key,
+  uint64_t* out)
+{
+  SelectKernels();
+  AES32(m, key, out);
+} //AES32Resolve
+
+Compose32Fn Compose32 = Compose32Resolve; ///< Composition kernel.
+Hash32Fn Hash32 = Hash32Resolve; ///< Hash kernel.
+Compose16Fn Compose16 = Compose16Resolve; ///< Packed composition kernel.
+AES32Fn AES32 = AES32Resolve; ///< AES finalizer kernel.
+
+static const bool g_bSelected = SelectKernels(); ///< Select at startup.
+
+#pragma endregion dispatch
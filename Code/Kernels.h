@@ -0,0 +1,57 @@
+/// \file Kernels.h
+/// \brief Declaration of the runtime-dispatched permutation and hash kernels.
+
+#ifndef __kernels__
+#define __kernels__
+
+#include <cinttypes>
+
+/// \brief Instruction set level of a kernel.
+
+enum class ISA{
+  Scalar, SSE42, AVX2, AVX512, Count
+}; //ISA
+
+/// \brief Composition kernel for permutations of size 32.
+///
+/// Replace each entry \f$m_i\f$ of a map by \f$p_{m_i}\f$.
+
+typedef void (*Compose32Fn)(uint8_t* m, const uint8_t* p);
+
+/// \brief Hash kernel for permutations of size 32.
+///
+/// Exclusive-or together the products of the map entries and a key.
+
+typedef uint64_t (*Hash32Fn)(const uint8_t* m, const uint64_t* key);
+
+/// \brief Composition kernel for packed permutations of size at most 16.
+///
+/// Each permutation map is packed into a 64-bit word with entry \f$i\f$ in
+/// nibble \f$i\f$. Return the map with each entry \f$m_i\f$ replaced by
+/// \f$p_{m_i}\f$.
+
+typedef uint64_t (*Compose16Fn)(uint64_t m, uint64_t p);
+
+/// \brief AES finalizer kernel for permutations of size 32.
+///
+/// Mix the map into 128 bits with three AES encryption rounds. The first
+/// half of the map is the state and the second half is the first round key.
+/// The key holds three 128-bit keys, low word first, of which the first is
+/// added to the state beforehand and the other two are the round keys of the
+/// other two rounds.
+
+typedef void (*AES32Fn)(const uint8_t* m, const uint64_t* key, uint64_t* out);
+
+extern Compose32Fn Compose32; ///< Composition kernel.
+extern Hash32Fn Hash32; ///< Hash kernel.
+extern Compose16Fn Compose16; ///< Packed composition kernel.
+extern AES32Fn AES32; ///< AES finalizer kernel.
+
+ISA GetBestISA(); ///< Best ISA level supported by this CPU.
+ISA GetISA(); ///< ISA level of the selected kernels.
+bool SetISA(ISA isa); ///< Select kernels for an ISA level.
+const char* GetISAName(ISA isa); ///< Printable name of an ISA level.
+bool HasAESNI(); ///< Whether the CPU has the AES instructions.
+bool UsingAESNI(); ///< Whether the AES finalizer kernel uses them.
+
+#endif
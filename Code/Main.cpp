@@ -8,17 +8,25 @@
 #include "Includes.h"
 #include "uintx_t.h"
 #include "Cayley32.h"
+#include "PerfCounters.h"
+#include "Benchmark.h"
+#include "Daemon.h"
+#include "ShmRing.h"
+#include "Kernels.h"
+#include "mt19937-64.h"
+#include "Metrics.h"
+#include "Engines.h"
+#include "Check.h"
+#include "Period.h"
 
 //function prototypes
 
-void init_genrand64(uint64_t seed); ///< Initialize Mersenne Twister.
-uint64_t genrand64_int64(void); ///< Mersenne Twister.
 uint64_t CPUTimeInNanoseconds(); ///< CPU time in nanoseconds.
 
 /// \brief Task type
 
 enum class Task{
-  Time, Generate, GenerateEx, GenerateMT, None
+  Time, Generate, GenerateEx, GenerateCtr, GenerateAES, GeneratePacked, GenerateWide, GenerateMT, Profile, Scale, Bench, Latency, Blocks, Bank, Shuffle, Wide, Check, Period, Daemon, Publish, None
 }; //Task
 
 /// \brief Print help.
@@ -28,12 +36,43 @@ enum class Task{
 void PrintHelp(){
   printf("Cayley32: A pseudorandom number generator based on the ");
   printf("symmetric group S_23.\n");
-  printf("Usage:\ngenerator.exe [-s seed] [-g] [-ge] [-gm] [-h]\n");
+  printf("Usage:\ngenerator.exe [-s seed] [-g] [-ge] [-gc] [-ga] [-gp n] [-gw n] [-gm] ");
+  printf("[-perf [-r regions]] [-scale [-tables m]] [-bench] [-lat] ");
+  printf("[-blocks] [-bank] [-shuffle] [-wide] [-check] [-period n,d,b] ");
+  printf("[-pf d] [-metrics] [--startup-profile] [-daemon path] [-shm name] [-h]\n");
   printf("  -s n: Seed n, a hex number (defaults to fixed value)\n");
   printf("  -g: Generate infinite Cayley32 pseudorandom bits\n");
   printf("  -ge: Generate infinite Cayley32e pseudorandom bits\n");
+  printf("  -gc: Generate infinite counter-based Cayley32c pseudorandom bits\n");
+  printf("  -ga: Generate infinite Cayley32a (AES finalizer) pseudorandom bits\n");
+  printf("  -gp n: Generate infinite packed Cayley pseudorandom bits over S_n, ");
+  printf("8 <= n <= 16\n");
+  printf("  -gw n: Generate infinite wide Cayley pseudorandom bits over S_n, ");
+  printf("256 <= n <= 16777216\n");
   printf("  -gm: Generate infinite Mersenne Twister pseudorandom bits\n");
+  printf("  -perf: Count hardware events per bit for Cayley32\n");
+  printf("  -r list: Comma-separated regions for -perf from build, gen, ");
+  printf("out (defaults to all)\n");
+  printf("  -scale: Measure Cayley32 throughput on 1 to all cores\n");
+  printf("  -tables m: Power tables for -scale per core, node, or shared ");
+  printf("(defaults to core)\n");
+  printf("  -bench: Compare Cayley32 with other PRNGs\n");
+  printf("  -blocks: Generate Cayley32c block-parallel on 1 to all cores\n");
+  printf("  -lat: Per-call latency percentiles of Cayley32\n");
+  printf("  -bank: Compare a bank of Cayley32 streams with Cayley32 objects\n");
+  printf("  -shuffle: Parallel shuffle on 1 to all cores vs serial Fisher-Yates\n");
+  printf("  -wide: Time wide permutation operations, direct vs blocked\n");
+  printf("  -check: Known-answer and differential self-check\n");
+  printf("  -period n,d,b: Cycles and collisions of a walk over S_n with a ");
+  printf("delay line of d words of b bits (defaults to 8,2,12)\n");
+  printf("  -pf d: Prefetch power-table entries d steps ahead, 0 < d < 32\n");
+  printf("  -metrics: Print metrics as JSON to stderr when done\n");
+  printf("  --startup-profile: Print time spent starting up to stderr\n");
+  printf("  -daemon path: Serve Cayley32 on Unix domain socket path\n");
+  printf("  -shm name: Publish Cayley32 to shared-memory ring name\n");
   printf("  -h: This help.\n");
+  printf("Set CAYLEY_ISA to scalar, sse4.2, avx2, or avx512 to override ");
+  printf("kernel selection.\n");
   printf("To report run-time: ./generator.exe\n");
   printf("To test with DieHarder: ");
   printf("./generator.exe -s 99999 -g | dieharder -g 200 -a\n");
@@ -46,10 +85,30 @@ void PrintHelp(){
 /// \param argv Command line arguments.
 /// \param seed [OUT] Seed.
 /// \param t [OUT] Task.
-
-void GetParams(int argc, char *argv[], uintx_t& seed, Task& t){
+/// \param regions [OUT] Regions to be profiled.
+/// \param path [OUT] Socket path for the daemon or shared-memory name.
+/// \param prefetch [OUT] Prefetch distance, 0 for none.
+/// \param tables [OUT] Which threads get their own power tables for -scale.
+/// \param metrics [OUT] Whether to print the metrics when done.
+/// \param profile [OUT] Whether to print the startup profile.
+/// \param packed [OUT] Permutation size for the packed Cayley PRNG.
+/// \param wide [OUT] Permutation size for the wide Cayley PRNG.
+/// \param period [OUT] Parameters for the period analysis.
+
+void GetParams(int argc, char *argv[], uintx_t& seed, Task& t,
+  std::string& regions, std::string& path, int& prefetch, TableMode& tables,
+  bool& metrics, bool& profile, int& packed, int& wide, std::string& period)
+{
   seed = 999999; //default seed
   t = Task::Time; //default task
+  regions = "build,gen,out"; //default regions
+  prefetch = 0; //default prefetch distance
+  tables = TableMode::Core; //default power table placement
+  metrics = false; //default is no metrics
+  profile = false; //default is no startup profile
+  packed = 16; //default packed permutation size
+  wide = 65536; //default wide permutation size
+  period = "8,2,12"; //default period analysis parameters
 
   for(int i=1; i<argc; i++){
     std::string s0 = argv[i];
@@ -63,9 +122,87 @@ void GetParams(int argc, char *argv[], uintx_t& seed, Task& t){
     else if(s0 == "-ge")
       t = Task::GenerateEx;
     
+    else if(s0 == "-gc")
+      t = Task::GenerateCtr;
+    
+    else if(s0 == "-ga")
+      t = Task::GenerateAES;
+    
+    else if(s0 == "-gp" && i + 1 < argc){
+      t = Task::GeneratePacked;
+      packed = std::min(std::max(atoi(argv[i + 1]), 8), 16);
+    } //else if
+    
+    else if(s0 == "-gw" && i + 1 < argc){
+      t = Task::GenerateWide;
+      wide = std::min(std::max(atoi(argv[i + 1]), 256), 16777216);
+    } //else if
+    
     else if(s0 == "-gm")
       t = Task::GenerateMT;
     
+    else if(s0 == "-perf")
+      t = Task::Profile;
+    
+    else if(s0 == "-scale")
+      t = Task::Scale;
+    
+    else if(s0 == "-bench")
+      t = Task::Bench;
+    
+    else if(s0 == "-lat")
+      t = Task::Latency;
+    
+    else if(s0 == "-blocks")
+      t = Task::Blocks;
+    
+    else if(s0 == "-bank")
+      t = Task::Bank;
+    
+    else if(s0 == "-shuffle")
+      t = Task::Shuffle;
+    
+    else if(s0 == "-wide")
+      t = Task::Wide;
+    
+    else if(s0 == "-check")
+      t = Task::Check;
+    
+    else if(s0 == "-period" && i + 1 < argc){
+      t = Task::Period;
+      period = argv[i + 1];
+    } //else if
+    
+    else if(s0 == "-daemon" && i + 1 < argc){
+      t = Task::Daemon;
+      path = argv[i + 1];
+    } //else if
+    
+    else if(s0 == "-shm" && i + 1 < argc){
+      t = Task::Publish;
+      path = argv[i + 1];
+    } //else if
+    
+    else if(s0 == "-r" && i + 1 < argc)
+      regions = argv[i + 1];
+    
+    else if(s0 == "-pf" && i + 1 < argc)
+      prefetch = atoi(argv[i + 1]);
+    
+    else if(s0 == "-metrics")
+      metrics = true;
+    
+    else if(s0 == "--startup-profile" || s0 == "-startup-profile")
+      profile = true;
+    
+    else if(s0 == "-tables" && i + 1 < argc){
+      const std::string s1 = argv[i + 1]; //table placement
+
+      if(s1 == "node")tables = TableMode::Node;
+      else if(s1 == "shared")tables = TableMode::Shared;
+      else tables = TableMode::Core;
+    } //else if
+    
     else if(s0 == "-h"){
       t = Task::None;
       PrintHelp();
@@ -81,11 +218,16 @@ void GetParams(int argc, char *argv[], uintx_t& seed, Task& t){
 /// being written to stdout.
 /// \param rnd A PRNG.
 /// \param nBufSize Buffer size in 8-byte blocks.
+/// \param profile Startup profile, which is printed when the first
+///   bufferful is ready to be written.
 
-template<typename t> void Generate(const t& rnd, uint64_t nBufSize){
+template<typename t> void Generate(const t& rnd, uint64_t nBufSize,
+  CStartupProfile& profile)
+{
   const FILE* unused = freopen(nullptr, "wb", stdout); //stdout in binary mode
 
   uint64_t* buffer = new uint64_t[nBufSize]; //buffer for pseudo-random numbers
+  bool bFirst = true; //whether the next bufferful is the first
 
   while(true){ //keep generating bufferfuls of data and throwing it to stdout
     uint64_t* p = buffer; //output pointer, set to start of buffer
@@ -93,8 +235,18 @@ template<typename t> void Generate(const t& rnd, uint64_t nBufSize){
     for(uint64_t i=0; i<nBufSize; i++) //fill buffer with pseudo-random UINT64s
       *p++ = rnd(); //generate uint64_t and append to buffer
 
+    if(bFirst){ //before writing the first bufferful, which may never return
+      profile.Mark("first output");
+      profile.Print();
+      bFirst = false;
+    } //if
+
     const size_t bytecount = nBufSize*sizeof(uint64_t); //buffer size in bytes
     fwrite((uint8_t*)buffer, bytecount, 1, stdout); //output buffer as bytes
+    fflush(stdout); //for small buffers of slow PRNGs
+
+    METRIC_ADD(BytesWritten, bytecount);
+    TRACE1(generate, bytecount);
   } //while
 
   delete [] buffer;
@@ -119,53 +271,136 @@ template<typename t> double Time(const t& rand, uint64_t n){
 /// \brief Time Cayley and the Mersenne Twister.
 ///
 /// Print to the console the average number of nanoseconds per bit used by
-/// Cayley and the Mersenne Twister.
+/// Cayley and the Mersenne Twister, the latter both one word at a time and
+/// in bulk.
 /// \param pCayley Pointer to an instance of the Cayley32 PRNG.
+/// \param pMT Pointer to an instance of the Mersenne Twister.
 /// \param n Number of 64-bit words to generate.
 
-void Time(Cayley32* pCayley, uint64_t n){ 
+void Time(Cayley32* pCayley, CMersenneTwister* pMT, uint64_t n){ 
   const uint32_t mb = (8*n*sizeof(uint64_t))/1048576LL; //number of Mb
   
   printf("Timing the generation of %u Megabits ", mb);
   printf("by Cayley32 and the Mersenne Twister.\n");
+  printf("Using %s kernels.\n", GetISAName(GetISA()));
+
+  if(pCayley->GetPrefetch() > 0)
+    printf("Prefetching %d steps ahead.\n", pCayley->GetPrefetch());
 
   const double t0 = Time([&](){pCayley->rand();}, n);
   printf("Cayley32: %0.2f nanoseconds per bit\n", t0);
 
-  const double t1 = Time([&](){genrand64_int64();}, n);
+  const double t1 = Time([&](){pMT->rand();}, n);
   printf("Mersenne Twister: %0.2f nanoseconds per bit\n", t1);
+
+  const uint64_t nBufSize = 4096; //buffer size in words
+  uint64_t buffer[nBufSize]; //buffer for bulk generation
+  const double t2 = Time([&](){pMT->fill(buffer, nBufSize);},
+    n/nBufSize)/nBufSize; //Time() thinks each buffer is one word
+  printf("Mersenne Twister (fill): %0.2f nanoseconds per bit\n", t2);
   
   printf("Cayley32 is %0.1f times slower\n", t0/t1);
 } //Time
 
+/// \brief Profile Cayley32 with hardware performance counters.
+///
+/// Print to the console the number of cycles, instructions, cache misses,
+/// TLB misses, and branch misses per bit in each of the selected regions.
+/// The regions are "build" (seeding, which includes building the power
+/// tables), "gen" (generating pseudorandom numbers into a buffer),
+/// and "out" (writing the buffer to the null device).
+/// \param seed Seed.
+/// \param n Number of 64-bit words to generate.
+/// \param regions Comma-separated list of regions to be profiled.
+
+void Profile(uintx_t& seed, uint64_t n, const std::string& regions){
+  const bool bBuild = regions.find("build") != std::string::npos;
+  const bool bGen = regions.find("gen") != std::string::npos;
+  const bool bOut = regions.find("out") != std::string::npos;
+
+  const uint64_t bits = 8*n*sizeof(uint64_t); //number of bits generated
+  const uint64_t nBufSize = 1048576; //buffer size in 64-bit words
+
+  CPerfCounters build, gen, out; //one set of counters per region
+
+  if(!build.IsAvailable()){
+    printf("Hardware performance counters are not available.\n");
+    return;
+  } //if
+
+  #ifdef _MSC_VER //Windows Visual Studio
+    FILE* sink = fopen("NUL", "wb"); //null device
+  #else
+    FILE* sink = fopen("/dev/null", "wb"); //null device
+  #endif
+
+  Cayley32 cayley32; //new PRNG with fixed generators
+  
+  if(bBuild)build.Start();
+  cayley32.srand(seed); //seed it, which builds the power tables
+  if(bBuild)build.Stop();
+
+  uint64_t* buffer = new uint64_t[nBufSize]; //buffer for pseudo-random numbers
+
+  for(uint64_t i=0; i<n; i+=nBufSize){ //a bufferful at a time
+    const uint64_t m = std::min(nBufSize, n - i); //words in this bufferful
+
+    if(bGen)gen.Start();
+    for(uint64_t j=0; j<m; j++)
+      buffer[j] = cayley32.rand();
+    if(bGen)gen.Stop();
+
+    if(bOut)out.Start();
+    fwrite((uint8_t*)buffer, m*sizeof(uint64_t), 1, sink);
+    if(bOut)out.Stop();
+  } //for
+
+  delete [] buffer;
+  fclose(sink);
+
+  printf("Hardware events for %" PRIu64 " Megabits from Cayley32.\n",
+    bits/1048576);
+
+  if(bBuild)build.Print("build", bits);
+  if(bGen)gen.Print("gen", bits);
+  if(bOut)out.Print("out", bits);
+} //Profile
+
 /// \brief Main.
 ///
 /// \param argc Number of arguments.
 /// \param argv Arguments.
-/// \return 0 (What could *possibly* go wrong?)
+/// \return 0, unless the self-check fails (What could *possibly* go wrong?)
 
 int main(int argc, char *argv[]){
+  CStartupProfile profile; //time spent starting up
+
   uintx_t seed = 9999999; //default seed 
   Task t = Task::Time; //default task
+  std::string regions; //regions to be profiled
+  std::string path; //socket path for the daemon or shared-memory name
+  int prefetch; //prefetch distance
+  TableMode tables; //power table placement for the scaling benchmark
+  bool metrics; //whether to print metrics
+  bool bProfile; //whether to print the startup profile
+  bool ok = true; //whether the task succeeded
+  int packed; //permutation size for the packed Cayley PRNG
+  int wide; //permutation size for the wide Cayley PRNG
+  std::string period; //parameters for the period analysis
 
-  GetParams(argc, argv, seed, t); //get parameters from command line args
-  
-  init_genrand64((uint64_t)seed); //seed Mersenne Twister
+  GetParams(argc, argv, seed, t, regions, path, prefetch, tables, metrics,
+    bProfile, packed, wide, period); //get parameters from command line args
 
-  Cayley32e cayley32e; //new PRNG with pseudorandom generators
-  cayley32e.srand(genrand64_int64); //seed it
-  
-  Cayley32 cayley32; //new PRNG with fixed generators
-  cayley32.srand(seed); //seed it
+  profile.Enable(bProfile);
+  profile.Mark("parse");
 
-  //cayley32.GetGenerator(0).printnum();
-  //cayley32.GetGenerator(1).printnum();
+  CEngines engines(seed, prefetch, profile); //constructed only when needed
 
   const uint32_t nBufSize = 10485760; //buffer size
 
   switch(t){ //depending on the task
     case Task::Time:
-      Time(&cayley32, 33554432);
+      Time(&engines.GetCayley32(), &engines.GetMT(), 33554432);
 
       #ifdef _MSC_VER //Windows Visual Studio
         _cputs("\nHit Almost Any Key to Exit...\n");
@@ -173,18 +408,110 @@ int main(int argc, char *argv[]){
       #endif
     break;
 
-    case Task::Generate: //fixed generators
-      Generate([&](){return cayley32.rand();}, nBufSize);
+    case Task::Generate:{ //fixed generators
+      Cayley32& cayley32 = engines.GetCayley32();
+      Generate([&](){return cayley32.rand();}, nBufSize, profile);
+    } //case
+    break;
+
+    case Task::GenerateEx:{ //pseudo-random generators
+      Cayley32e& cayley32e = engines.GetCayley32e();
+      Generate([&](){return cayley32e.rand();}, nBufSize, profile);
+    } //case
     break;
 
-    case Task::GenerateEx: //pseudo-random generators
-      Generate([&](){return cayley32e.rand();}, nBufSize);
+    case Task::GenerateCtr:{ //counter-based
+      Cayley32c& cayley32c = engines.GetCayley32c();
+      Generate([&](){return cayley32c.rand();}, nBufSize, profile);
+    } //case
     break;
 
-    case Task::GenerateMT: //Mersenne Twister for baseline
-      Generate([&](){return genrand64_int64();}, nBufSize);
+    case Task::GenerateAES:{ //AES finalizer
+      Cayley32a& cayley32a = engines.GetCayley32a();
+      Generate([&](){return cayley32a.rand();}, nBufSize, profile);
+    } //case
+    break;
+
+    case Task::GeneratePacked:{ //packed permutations
+      CCayleyPacked& cayley = engines.GetPacked(packed);
+      Generate([&](){return cayley.rand();}, nBufSize, profile);
+    } //case
+    break;
+
+    case Task::GenerateWide: //wide permutations, a word takes O(n) time
+      if(wide <= 65536){ //16-bit maps suffice
+        CCayleyWide<uint16_t>& cayley = engines.GetWide16(wide);
+        Generate([&](){return cayley.rand();}, 256, profile);
+      } //if
+
+      else{ //32-bit maps
+        CCayleyWide<uint32_t>& cayley = engines.GetWide32(wide);
+        Generate([&](){return cayley.rand();}, 8, profile);
+      } //else
+    break;
+
+    case Task::GenerateMT:{ //Mersenne Twister for baseline
+      CMersenneTwister& mt = engines.GetMT();
+      Generate([&](){return mt.rand();}, nBufSize, profile);
+    } //case
+    break;
+
+    case Task::Profile: //hardware performance counters
+      Profile(seed, 33554432, regions);
+    break;
+
+    case Task::Scale: //multi-core scaling
+      ScalingBenchmark(seed, 33554432, tables);
+    break;
+
+    case Task::Bench: //comparison with other PRNGs
+      BaselineBenchmark(seed, 33554432);
+    break;
+
+    case Task::Latency: //per-call latency
+      LatencyBenchmark(seed, 1048576);
+    break;
+
+    case Task::Blocks: //block-parallel counter-based generation
+      BlockBenchmark(seed, 16777216);
+    break;
+
+    case Task::Bank: //bank of streams
+      BankBenchmark(seed, 16777216);
+    break;
+
+    case Task::Shuffle: //parallel shuffle
+      ShuffleBenchmark(seed, 33554432);
+    break;
+
+    case Task::Wide: //wide permutations
+      WideBenchmark(seed, 16777216);
+    break;
+
+    case Task::Check: //self-check
+      ok = SelfCheck(1048576);
+    break;
+
+    case Task::Period: //period and collision analysis
+      ok = PeriodAnalysis(seed, period);
+    break;
+
+    case Task::Daemon: //serve over a Unix domain socket
+      ok = Serve(path.c_str(), seed);
+    break;
+
+    case Task::Publish: //publish to a shared-memory ring
+      ok = Publish(path.c_str(), seed, 0);
+    break;
+
+    case Task::None: //help has been printed
     break;
   } //switch
 
-  return 0;
+  profile.Print(); //if it has not been printed already
+
+  if(metrics)
+    fprintf(stderr, "%s\n", GetMetricsJSON().c_str());
+
+  return ok? 0: 1;
 } //main
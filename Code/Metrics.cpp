@@ -0,0 +1,77 @@
+/// \file Metrics.cpp
+/// \brief Implementation of the runtime metrics.
+
+#include <chrono>
+
+#include "Includes.h"
+#include "Metrics.h"
+
+#ifdef CAYLEY_METRICS
+  std::atomic<uint64_t> g_nMetric[int(Metric::Count)]; ///< Metrics.
+#endif
+
+/// \brief Names of the metrics in JSON.
+
+static const char* g_szMetricName[int(Metric::Count)] = {
+  "streams", "srand_calls", "stream_words", "choose_calls",
+  "choose_candidates", "choose_rejected_order", "choose_rejected_fixed",
+  "choose_ns", "table_builds", "table_perms", "table_bytes", "perm_allocs",
+  "uintx_allocs", "bytes_written"
+}; //g_szMetricName
+
+/// Read a metric.
+/// \param m A metric.
+/// \return Its current value, or 0 if metrics are not compiled in.
+
+uint64_t GetMetric(Metric m){
+  #ifdef CAYLEY_METRICS
+    return g_nMetric[int(m)].load(std::memory_order_relaxed);
+  #else
+    (void)m; //unused
+    return 0;
+  #endif
+} //GetMetric
+
+/// Get all of the metrics as a JSON object on a single line, with a member
+/// "enabled" that says whether metrics are compiled in. The metrics are
+/// read one at a time, so they are not a consistent snapshot if other
+/// threads are updating them.
+/// \return JSON object.
+
+std::string GetMetricsJSON(){
+  #ifdef CAYLEY_METRICS
+    std::string s = "{\"enabled\": true"; //return result
+  #else
+    std::string s = "{\"enabled\": false"; //return result
+  #endif
+
+  for(int i=0; i<int(Metric::Count); i++){
+    char buf[64]; //one member
+    snprintf(buf, sizeof(buf), ", \"%s\": %" PRIu64, g_szMetricName[i],
+      GetMetric(Metric(i)));
+    s += buf;
+  } //for
+
+  return s + "}";
+} //GetMetricsJSON
+
+/// Set all of the metrics to zero, including the gauges, which will then be
+/// relative to the current state.
+
+void ResetMetrics(){
+  #ifdef CAYLEY_METRICS
+    for(auto& m: g_nMetric)
+      m.store(0, std::memory_order_relaxed);
+  #endif
+} //ResetMetrics
+
+/// Get the time from a monotonic clock. This is used for the timing
+/// metrics instead of WallTimeInNanoseconds() so that the library does not
+/// depend on CPUtime.cpp.
+/// \return Time in nanoseconds from an arbitrary starting point.
+
+uint64_t MetricClock(){
+  using namespace std::chrono;
+  return uint64_t(duration_cast<nanoseconds>(
+    steady_clock::now().time_since_epoch()).count());
+} //MetricClock
@@ -0,0 +1,70 @@
+/// \file Metrics.h
+/// \brief Declaration of the runtime metrics and tracepoints.
+///
+/// Metrics are process-wide counters and gauges that are updated with
+/// relaxed atomic operations at points in the life of a generator, and are
+/// read with GetMetric() or GetMetricsJSON(). They are compiled in only if
+/// CAYLEY_METRICS is defined, otherwise the METRIC macros expand to nothing
+/// and the readers return zero. USDT static tracepoints for tools such as
+/// bpftrace and perf are compiled in only if CAYLEY_USDT is defined, which
+/// needs sys/sdt.h from SystemTap, otherwise the TRACE macros expand to
+/// nothing.
+
+#ifndef __metrics__
+#define __metrics__
+
+#include <cinttypes>
+#include <string>
+
+/// \brief A metric.
+
+enum class Metric{
+  Streams, ///< Gauge: generators in existence.
+  SrandCalls, ///< Counter: calls of srand().
+  StreamWords, ///< Counter: words generated by streams before reseeding or destruction.
+  ChooseCalls, ///< Counter: calls of CCayley::ChooseGenerators().
+  ChooseCandidates, ///< Counter: candidate generators tried.
+  ChooseRejectedOrder, ///< Counter: candidates rejected for not having maximal order.
+  ChooseRejectedFixed, ///< Counter: pairs rejected for a common fixed point.
+  ChooseNanoseconds, ///< Counter: time spent choosing generators.
+  TableBuilds, ///< Counter: power tables built.
+  TablePerms, ///< Gauge: permutations held in power tables.
+  TableBytes, ///< Gauge: bytes of permutation maps held in power tables.
+  PermAllocs, ///< Counter: heap allocations by CPerm.
+  UintxAllocs, ///< Counter: heap allocations by uintx_t.
+  BytesWritten, ///< Counter: bytes written to stdout by the generate tasks.
+  Count ///< Number of metrics.
+}; //Metric
+
+uint64_t GetMetric(Metric m); ///< Read a metric.
+std::string GetMetricsJSON(); ///< All metrics as a JSON object.
+void ResetMetrics(); ///< Set all metrics to zero.
+uint64_t MetricClock(); ///< Monotonic clock in nanoseconds.
+
+#ifdef CAYLEY_METRICS
+  #include <atomic>
+
+  extern std::atomic<uint64_t> g_nMetric[int(Metric::Count)]; ///< Metrics.
+
+  #define METRIC_ADD(m, n) \
+    g_nMetric[int(Metric::m)].fetch_add(uint64_t(n), std::memory_order_relaxed)
+  #define METRIC_SUB(m, n) \
+    g_nMetric[int(Metric::m)].fetch_sub(uint64_t(n), std::memory_order_relaxed)
+#else
+  #define METRIC_ADD(m, n) ((void)0) ///< Add to a metric.
+  #define METRIC_SUB(m, n) ((void)0) ///< Subtract from a gauge.
+#endif
+
+#ifdef CAYLEY_USDT
+  #include <sys/sdt.h>
+
+  #define TRACE0(name) DTRACE_PROBE(cayley, name)
+  #define TRACE1(name, a) DTRACE_PROBE1(cayley, name, a)
+  #define TRACE2(name, a, b) DTRACE_PROBE2(cayley, name, a, b)
+#else
+  #define TRACE0(name) ((void)0) ///< Tracepoint.
+  #define TRACE1(name, a) ((void)0) ///< Tracepoint with 1 argument.
+  #define TRACE2(name, a, b) ((void)0) ///< Tracepoint with 2 arguments.
+#endif
+
+#endif
@@ -0,0 +1,144 @@
+/// \file PackedPerm.cpp
+/// \brief Implementation of the packed permutation CPackedPerm and its power
+/// table CPackedPowerTable.
+
+#include "Includes.h"
+#include "PackedPerm.h"
+#include "Kernels.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//CPackedPerm functions
+
+#pragma region packedperm
+
+/// The default constructor makes an empty permutation.
+
+CPackedPerm::CPackedPerm(){
+} //constructor
+
+/// Construct the identity permutation.
+/// \param n Size of permutation, at most 16.
+
+CPackedPerm::CPackedPerm(uint8_t n): m_nSize(n){
+  assert(n <= 16); //safety
+} //constructor
+
+/// Construct by packing a permutation.
+/// \param p A permutation of size at most 16.
+
+CPackedPerm::CPackedPerm(const CPerm& p): m_nSize(p.GetSize()){
+  assert(m_nSize <= 16); //safety
+
+  for(int i=0; i<m_nSize; i++){
+    m_nMap &= ~(0xFULL << 4*i); //clear nibble i
+    m_nMap |= uint64_t(p[i]) << 4*i; //set it to the image of i
+  } //for
+} //constructor
+
+/// Reader function for the size.
+/// \return Size of permutation.
+
+uint8_t CPackedPerm::GetSize() const{
+  return m_nSize;
+} //GetSize
+
+/// Reader function for the packed map.
+/// \return Packed map, with the image of i in nibble i.
+
+uint64_t CPackedPerm::GetMap() const{
+  return m_nMap;
+} //GetMap
+
+/// Identity test.
+/// \return true If this is the identity permutation.
+
+bool CPackedPerm::IsIdentity() const{
+  return m_nMap == m_nIdentity;
+} //IsIdentity
+
+/// Unpack into a CPerm.
+/// \return This permutation as a CPerm.
+
+CPerm CPackedPerm::Unpack() const{
+  uint8_t map[16]; //unpacked map
+
+  for(int i=0; i<m_nSize; i++)
+    map[i] = (*this)[i];
+
+  return CPerm(m_nSize, map);
+} //Unpack
+
+/// Reader function for the nth element of the map.
+/// \param n Index.
+/// \return Image of n.
+
+uint8_t CPackedPerm::operator[](uint8_t n) const{
+  return uint8_t((m_nMap >> 4*n) & 0xF);
+} //operator[]
+
+/// Composition, using the packed composition kernel selected for this CPU.
+/// \param p Permutation to compose with, of the same size.
+/// \return Reference to this permutation after composition.
+
+const CPackedPerm& CPackedPerm::operator*=(const CPackedPerm& p){
+  assert(m_nSize == p.m_nSize); //safety
+  m_nMap = Compose16(m_nMap, p.m_nMap);
+  return *this;
+} //operator*=
+
+/// Composition with a packed map from a CPackedPowerTable.
+/// \param map Packed map of a permutation of the same size.
+/// \return Reference to this permutation after composition.
+
+const CPackedPerm& CPackedPerm::operator*=(uint64_t map){
+  m_nMap = Compose16(m_nMap, map);
+  return *this;
+} //operator*=
+
+/// Equality test.
+/// \param p0 A packed permutation.
+/// \param p1 A packed permutation.
+/// \return true If they are equal.
+
+bool operator==(const CPackedPerm& p0, const CPackedPerm& p1){
+  return p0.m_nSize == p1.m_nSize && p0.m_nMap == p1.m_nMap;
+} //operator==
+
+#pragma endregion packedperm
+
+//////////////////////////////////////////////////////////////////////////////
+//CPackedPowerTable functions
+
+#pragma region packedpowertable
+
+/// Initialize the table by computing powers of a permutation until we get
+/// back to the identity.
+/// \param p A packed permutation.
+
+void CPackedPowerTable::Initialize(const CPackedPerm& p){
+  m_stdMap.clear();
+  m_stdMap.push_back(CPackedPerm(p.GetSize()).GetMap()); //p^0
+
+  CPackedPerm q(p); //a power of p, which starts out at p^1
+
+  while(!q.IsIdentity()){
+    m_stdMap.push_back(q.GetMap());
+    q *= p;
+  } //while
+} //Initialize
+
+/// Reader function for the order of the permutation.
+/// \return Order, which is the number of entries in the table.
+
+const uint32_t CPackedPowerTable::GetOrder() const{
+  return uint32_t(m_stdMap.size());
+} //GetOrder
+
+/// Reader function for the size of the maps.
+/// \return Size of the table in bytes.
+
+size_t CPackedPowerTable::GetBytes() const{
+  return m_stdMap.size()*sizeof(uint64_t);
+} //GetBytes
+
+#pragma endregion packedpowertable
@@ -0,0 +1,75 @@
+/// \file PackedPerm.h
+/// \brief Declaration of the packed permutation CPackedPerm and its power
+/// table CPackedPowerTable.
+
+#ifndef __packedperm__
+#define __packedperm__
+
+#include <vector>
+
+#include "Permutation.h"
+
+/// \brief Packed permutation of size at most 16.
+///
+/// A permutation of size at most 16 packed into a 64-bit word, with the image
+/// of \f$i\f$ in nibble \f$i\f$. The nibbles past the end of the permutation
+/// are fixed points, so the identity of every size is the same word, and
+/// composition is a single byte shuffle.
+
+class CPackedPerm{
+  private:
+    static const uint64_t m_nIdentity = 0xFEDCBA9876543210ULL; ///< Identity.
+
+    uint64_t m_nMap = m_nIdentity; ///< Nibble i is the image of i.
+    uint8_t m_nSize = 0; ///< Number of things being permuted.
+
+  public:
+    CPackedPerm(); ///< Constructor.
+    CPackedPerm(uint8_t n); ///< Constructor.
+    CPackedPerm(const CPerm& p); ///< Constructor.
+
+    uint8_t GetSize() const; ///< Get size.
+    uint64_t GetMap() const; ///< Get packed map.
+    bool IsIdentity() const; ///< Identity permutation test.
+    CPerm Unpack() const; ///< Get as a CPerm.
+
+    uint8_t operator[](uint8_t n) const; ///< Get nth element of map.
+    const CPackedPerm& operator*=(const CPackedPerm& p); ///< Composition.
+    const CPackedPerm& operator*=(uint64_t map); ///< Composition with a map.
+
+    friend bool operator==(const CPackedPerm& p0, const CPackedPerm& p1); ///< Equality test.
+}; //CPackedPerm
+
+bool operator==(const CPackedPerm& p0, const CPackedPerm& p1); ///< Is equal to.
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// \brief Table of all powers of a packed permutation.
+///
+/// Like CPowerTable, but each power takes only 8 bytes, so that the table
+/// for a generator of maximal order in \f$S_{16}\f$, which has
+/// \f$g(16) = 140\f$ entries, fits in about 1KB.
+
+class CPackedPowerTable{
+  private:
+    std::vector<uint64_t> m_stdMap; ///< Packed maps of the powers.
+
+  public:
+    void Initialize(const CPackedPerm& p); ///< Initialize.
+
+    const uint32_t GetOrder() const; ///< Get the order of the permutation.
+    size_t GetBytes() const; ///< Get the size of the maps.
+
+    inline uint64_t GetMap(uint32_t n) const; ///< Look up map of power.
+}; //CPackedPowerTable
+
+/// Reader function for the packed map of a power. This is inline because it
+/// is called once per pseudorandom number.
+/// \param n An exponent less than the order.
+/// \return The packed map of the n'th power of the permutation.
+
+inline uint64_t CPackedPowerTable::GetMap(uint32_t n) const{
+  return m_stdMap[n];
+} //GetMap
+
+#endif
@@ -0,0 +1,180 @@
+/// \file PerfCounters.cpp
+/// \brief Implementation of the hardware performance counter class CPerfCounters.
+
+#include "Includes.h"
+#include "PerfCounters.h"
+
+#ifdef __linux__ //Linux perf_event_open
+
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+/// \brief Event type and configuration for each PerfEvent.
+
+static const struct{
+  uint32_t type; ///< Event type.
+  uint64_t config; ///< Event configuration.
+} g_sEventConfig[] = {
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+  {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+    (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+  {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB |
+    (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+}; //g_sEventConfig
+
+#endif
+
+/// \brief Printable name of each PerfEvent.
+
+static const char* g_szEventName[] = {
+  "cycles", "instructions", "L1D misses", "LLC misses", "dTLB misses",
+  "branch misses"
+}; //g_szEventName
+
+/// Open a disabled counter for each event on the current thread. Counters
+/// that the kernel refuses to open are silently left out.
+
+CPerfCounters::CPerfCounters(){
+  for(int i=0; i<m_nEvents; i++){
+    m_nFd[i] = -1;
+    m_nCount[i] = 0;
+    m_nEnabled[i] = m_nRunning[i] = 0;
+
+    #ifdef __linux__
+      perf_event_attr attr; //event attributes
+      memset(&attr, 0, sizeof(attr));
+
+      attr.size = sizeof(attr);
+      attr.type = g_sEventConfig[i].type;
+      attr.config = g_sEventConfig[i].config;
+      attr.disabled = 1; //enabled by Start()
+      attr.exclude_kernel = 1; //user mode only
+      attr.exclude_hv = 1; //no hypervisor
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+        PERF_FORMAT_TOTAL_TIME_RUNNING; //for scaling when multiplexed
+
+      m_nFd[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    #endif
+  } //for
+} //constructor
+
+/// Close the counters.
+
+CPerfCounters::~CPerfCounters(){
+  #ifdef __linux__
+    for(int i=0; i<m_nEvents; i++)
+      if(m_nFd[i] >= 0)
+        close(m_nFd[i]);
+  #endif
+} //destructor
+
+/// Whether hardware counting is possible on this machine.
+/// \return true If at least one counter was opened.
+
+bool CPerfCounters::IsAvailable() const{
+  for(int i=0; i<m_nEvents; i++)
+    if(m_nFd[i] >= 0)return true;
+
+  return false;
+} //IsAvailable
+
+/// Read a counter, scaled up to compensate for the time that it was not
+/// running because the kernel was multiplexing more events than there are
+/// hardware counters. The kernel resets the count but not the times enabled
+/// and running, which are totals since the counter was opened, so the scale
+/// is the ratio of their increases since Start().
+/// \param i Event index.
+/// \return Scaled count since the last Start().
+
+uint64_t CPerfCounters::Read(int i) const{
+  uint64_t result = 0; //return result
+
+  #ifdef __linux__
+    uint64_t buf[3] = {0}; //value, time enabled, time running
+
+    if(m_nFd[i] >= 0 && read(m_nFd[i], buf, sizeof(buf)) == sizeof(buf)){
+      const uint64_t enabled = buf[1] - m_nEnabled[i]; //time enabled
+      const uint64_t running = buf[2] - m_nRunning[i]; //time running
+      result = buf[0];
+
+      if(running > 0 && running < enabled) //multiplexed
+        result = uint64_t(double(result)*double(enabled)/double(running));
+    } //if
+  #endif
+
+  return result;
+} //Read
+
+/// Reset the counters, note their times enabled and running, and enable
+/// them.
+
+void CPerfCounters::Start(){
+  #ifdef __linux__
+    for(int i=0; i<m_nEvents; i++)
+      if(m_nFd[i] >= 0){
+        uint64_t buf[3] = {0}; //value, time enabled, time running
+        ioctl(m_nFd[i], PERF_EVENT_IOC_RESET, 0);
+
+        if(read(m_nFd[i], buf, sizeof(buf)) == sizeof(buf)){
+          m_nEnabled[i] = buf[1];
+          m_nRunning[i] = buf[2];
+        } //if
+
+        ioctl(m_nFd[i], PERF_EVENT_IOC_ENABLE, 0);
+      } //if
+  #endif
+} //Start
+
+/// Disable the counters and add their values to the accumulated counts.
+
+void CPerfCounters::Stop(){
+  #ifdef __linux__
+    for(int i=0; i<m_nEvents; i++)
+      if(m_nFd[i] >= 0)
+        ioctl(m_nFd[i], PERF_EVENT_IOC_DISABLE, 0);
+  #endif
+
+  for(int i=0; i<m_nEvents; i++)
+    m_nCount[i] += Read(i);
+} //Stop
+
+/// Zero the accumulated counts.
+
+void CPerfCounters::Reset(){
+  for(int i=0; i<m_nEvents; i++)
+    m_nCount[i] = 0;
+} //Reset
+
+/// Reader function for the accumulated counts.
+/// \param e An event.
+/// \return Number of times that the event has occurred.
+
+uint64_t CPerfCounters::operator[](PerfEvent e) const{
+  return m_nCount[(int)e];
+} //operator[]
+
+/// Print the accumulated counts to stdout, both as totals and per bit of
+/// pseudorandom output.
+/// \param region Name of the region measured.
+/// \param bits Number of pseudorandom bits generated.
+
+void CPerfCounters::Print(const char* region, uint64_t bits) const{
+  printf("%s:\n", region);
+
+  for(int i=0; i<m_nEvents; i++){
+    printf("  %-14s", g_szEventName[i]);
+
+    if(m_nFd[i] < 0)
+      printf("n/a\n");
+
+    else printf("%16" PRIu64 " %10.4f per bit\n", m_nCount[i],
+      bits > 0? double(m_nCount[i])/double(bits): 0.0);
+  } //for
+} //Print
@@ -0,0 +1,52 @@
+/// \file PerfCounters.h
+/// \brief Declaration of the hardware performance counter class CPerfCounters.
+
+#ifndef __perfcounters__
+#define __perfcounters__
+
+#include <cinttypes>
+
+/// \brief Hardware events counted by CPerfCounters.
+
+enum class PerfEvent{
+  Cycles, Instructions, L1DMisses, LLCMisses, DTLBMisses, BranchMisses, Count
+}; //PerfEvent
+
+/// \brief Hardware performance counters.
+///
+/// A set of hardware performance counters for cycles, instructions,
+/// L1 data cache misses, last level cache misses, data TLB misses, and
+/// branch misses. Counting is done by the Linux perf_event_open interface,
+/// and only the current thread in user mode is counted. Counts accumulate
+/// over every Start() / Stop() pair until Reset() is called, so a region
+/// may be measured in several pieces. On other operating systems, or if
+/// the kernel refuses access to the counters, IsAvailable() returns false
+/// and all counts are zero.
+
+class CPerfCounters{
+  private:
+    static const int m_nEvents = (int)PerfEvent::Count; ///< Number of events.
+
+    int m_nFd[m_nEvents]; ///< File descriptor for each event, -1 if none.
+    uint64_t m_nCount[m_nEvents]; ///< Accumulated count for each event.
+    uint64_t m_nEnabled[m_nEvents]; ///< Time enabled for each event at Start().
+    uint64_t m_nRunning[m_nEvents]; ///< Time running for each event at Start().
+
+    uint64_t Read(int i) const; ///< Read a scaled counter.
+
+  public:
+    CPerfCounters(); ///< Constructor.
+    ~CPerfCounters(); ///< Destructor.
+
+    bool IsAvailable() const; ///< Whether any counter could be opened.
+
+    void Start(); ///< Start counting.
+    void Stop(); ///< Stop counting and accumulate.
+    void Reset(); ///< Zero the accumulated counts.
+
+    uint64_t operator[](PerfEvent e) const; ///< Get accumulated count.
+
+    void Print(const char* region, uint64_t bits) const; ///< Print counts.
+}; //CPerfCounters
+
+#endif
@@ -0,0 +1,728 @@
+/// \file Period.cpp
+/// \brief Implementation of the period and collision analysis.
+///
+/// The walk from any state eventually repeats a state, after which it and
+/// its output go round a cycle for ever. For the full Cayley32 state this
+/// cannot happen in practice, so the analysis runs reduced walks that keep
+/// the structure of Cayley32, a permutation multiplied by alternating
+/// generators to powers taken from a delay line of hashes of earlier
+/// permutations, with a state space small enough for repeats to be found,
+/// and compares what it finds with a random mapping on the same number of
+/// states.
+///
+/// It uses the parallel collision search of van Oorschot and Wiener,
+/// "Parallel collision search with cryptanalytic applications", Journal of
+/// Cryptology 12(1):1-28, 1999. Many trails are walked from pseudorandom
+/// states on many threads until they reach a distinguished point, that is,
+/// a state whose fingerprint starts with enough zero bits, which is stored
+/// in a shared table with the state itself. A trail that reaches a
+/// distinguished point that is already in the table has collided with an
+/// earlier trail, or with itself if it went round a cycle. The distinguished
+/// points and the number of steps between them form a graph whose cycles
+/// are the cycles of the walk that have a distinguished point on them.
+/// Brent's algorithm runs alongside each trail to catch those that end on a
+/// cycle with none.
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
+#include "Includes.h"
+#include "Period.h"
+#include "Threads.h"
+
+uint64_t WallTimeInNanoseconds(); ///< Wall clock time in nanoseconds.
+
+///////////////////////////////////////////////////////////////////////////////
+//CCayleyWalk functions
+
+#pragma region walk
+
+/// Mix the bits of a 64-bit word.
+/// \param x A 64-bit word.
+/// \return A 64-bit word that depends on every bit of x.
+
+static inline uint64_t Mix(uint64_t x){
+  x = (x ^ (x >> 31))*0x7FB5D329728EA185ULL;
+  x = (x ^ (x >> 27))*0x81DADEF4BC2DD44DULL;
+  return x ^ (x >> 33);
+} //Mix
+
+/// Construct a walk with an empty delay line. It must be seeded with
+/// CCayley::srand() or share the tables of one that has before it can take
+/// a step.
+/// \param n Permutation size, \f$4 \leq n \leq 32\f$.
+/// \param d Number of words in the delay line, \f$2 \leq d \leq 32\f$.
+/// \param b Number of bits in each word, \f$1 \leq b \leq 64\f$.
+
+CCayleyWalk::CCayleyWalk(uint32_t n, uint32_t d, uint32_t b):
+  CCayley(n), m_nLength(d), m_nMask(b >= 64? ~0ULL: (1ULL << b) - 1)
+{
+  assert(n <= 32 && d >= 2 && d <= uint32_t(m_nDelay)); //safety
+  HashPerm();
+} //constructor
+
+/// Hash the current permutation into 64 bits. Only the low \f$b\f$ bits go
+/// into the delay line, but all of them go into the fingerprint.
+
+void CCayleyWalk::HashPerm(){
+  const uint8_t* map = m_pCurPerm->GetMap(); //shorthand
+  uint64_t h = m_nSize; //return result
+
+  for(uint32_t i=0; i<m_nSize; i+=8){
+    uint64_t w = 0; //next 8 entries of the map
+    memcpy(&w, map + i, std::min(8U, m_nSize - i));
+    h = Mix(h ^ w);
+  } //for
+
+  m_nPermHash = h;
+} //HashPerm
+
+/// Go to a pseudorandom state, with a uniformly distributed permutation and
+/// delay line and generator parity 0.
+/// \param rnd A Mersenne Twister.
+
+void CCayleyWalk::Randomize(CMersenneTwister& rnd){
+  m_pCurPerm->Randomize(rnd);
+
+  for(uint32_t i=0; i<m_nLength; i++)
+    m_nDelayLine[i] = rnd() & m_nMask;
+
+  m_nTail = 0;
+  m_nParity = 0;
+  HashPerm();
+} //Randomize
+
+/// Take a step of the walk, as Cayley32e::rand() does, but with the short
+/// delay line.
+/// \return \f$b\f$ pseudorandom bits.
+
+uint64_t CCayleyWalk::Step(){
+  NextPerm(); //update current permutation
+  HashPerm(); //hash it
+
+  const uint64_t num = m_nPermHash & m_nMask; //keep b bits
+  m_nDelayLine[m_nTail] = num; //enter into delay line
+  m_nTail = (m_nTail + 1)%m_nLength; //advance delay line
+
+  return num^m_nDelayLine[m_nTail]; //strengthen pseudo-random number
+} //Step
+
+/// Get a 64-bit fingerprint of the state, which is the same for equal
+/// states wherever the tail of the delay line is.
+/// \return Fingerprint.
+
+uint64_t CCayleyWalk::GetFingerprint() const{
+  uint64_t h = Mix(m_nPermHash ^ m_nParity); //return result
+
+  for(uint32_t i=m_nTail; i<m_nLength; i++)
+    h = Mix(h ^ m_nDelayLine[i]);
+
+  for(int i=0; i<m_nTail; i++)
+    h = Mix(h ^ m_nDelayLine[i]);
+
+  return h;
+} //GetFingerprint
+
+/// Get the state, that is, the permutation map packed 8 entries to a word,
+/// then the delay line starting at its tail, then the generator parity.
+/// \param v [OUT] State.
+
+void CCayleyWalk::GetState(std::vector<uint64_t>& v) const{
+  const uint8_t* map = m_pCurPerm->GetMap(); //shorthand
+  v.clear();
+
+  for(uint32_t i=0; i<m_nSize; i+=8){
+    uint64_t w = 0; //next 8 entries of the map
+    memcpy(&w, map + i, std::min(8U, m_nSize - i));
+    v.push_back(w);
+  } //for
+
+  for(uint32_t i=0; i<m_nLength; i++)
+    v.push_back(m_nDelayLine[(m_nTail + i)%m_nLength]);
+
+  v.push_back(m_nParity);
+} //GetState
+
+/// Set the state to one got from GetState() by an instance with the same
+/// permutation size and delay line length.
+/// \param v State.
+
+void CCayleyWalk::SetState(const std::vector<uint64_t>& v){
+  uint8_t map[32]; //permutation map
+  size_t j = 0; //index into v
+
+  for(uint32_t i=0; i<m_nSize; i+=8)
+    memcpy(map + i, &v[j++], std::min(8U, m_nSize - i));
+
+  *m_pCurPerm = CPerm(uint8_t(m_nSize), map);
+
+  for(uint32_t i=0; i<m_nLength; i++)
+    m_nDelayLine[i] = v[j++];
+
+  m_nTail = 0;
+  m_nParity = uint32_t(v[j]);
+  HashPerm();
+} //SetState
+
+#pragma endregion walk
+
+///////////////////////////////////////////////////////////////////////////////
+//Parallel collision search
+
+#pragma region search
+
+/// \brief A distinguished point.
+
+struct CDistinguished{
+  std::vector<uint64_t> m_stdState; ///< State.
+  uint32_t m_nTrail = 0; ///< Index of the trail that found it.
+  uint64_t m_nNext = 0; ///< Fingerprint of the next distinguished point.
+  uint64_t m_nLength = 0; ///< Steps to the next one, 0 if unknown.
+}; //CDistinguished
+
+/// \brief A cycle of the walk.
+
+struct CWalkCycle{
+  uint64_t m_nLength = 0; ///< Number of steps round it.
+  uint64_t m_nTrails = 0; ///< Number of trails that end on it.
+  bool m_bBare = false; ///< Whether it has no distinguished point.
+  std::vector<uint64_t> m_stdState; ///< A state on it.
+}; //CWalkCycle
+
+/// \brief What became of a trail.
+
+enum class Outcome{
+  Merged, Closed, Bare, Clash, Count
+}; //Outcome
+
+/// \brief State of the search shared by the threads.
+///
+/// The table of distinguished points, the cycles with no distinguished
+/// point, and the totals are protected by a mutex. Only distinguished
+/// points and the ends of trails need it, which are rare enough that the
+/// threads seldom wait.
+
+struct CSearch{
+  const CCayleyWalk* m_pWalk = nullptr; ///< Owner of the power tables.
+  uint32_t m_nSize = 0; ///< Permutation size.
+  uint32_t m_nLength = 0; ///< Number of words in the delay line.
+  uint32_t m_nBits = 0; ///< Number of bits in each word.
+  uint32_t m_nZeros = 0; ///< Leading zero bits of distinguished points.
+  uint32_t m_nTrails = 0; ///< Number of trails.
+
+  std::mutex m_stdMutex; ///< Mutex for everything below.
+  std::unordered_map<uint64_t, CDistinguished> m_stdPoint; ///< By fingerprint.
+  std::map<uint64_t, CWalkCycle> m_stdBare; ///< Bare cycles by their key.
+  std::vector<uint64_t> m_stdFirst; ///< First point of each trail.
+  std::vector<uint8_t> m_stdHasFirst; ///< Whether each trail reached one.
+  std::vector<uint64_t> m_stdBareKey; ///< Bare cycle each trail ended on.
+
+  std::atomic<uint64_t> m_nExplored{0}; ///< New states, approximately.
+  uint64_t m_nSteps = 0; ///< Total number of steps.
+  uint64_t m_nOutcome[int(Outcome::Count)] = {0}; ///< Trails by outcome.
+  double m_dExposure = 0; ///< Sum of pairs of states that could have collided.
+}; //CSearch
+
+/// Go round a cycle to find the state on it with the smallest fingerprint,
+/// which identifies it. If the cycle has a distinguished point then this
+/// is one, since they are the states with the smallest fingerprints.
+/// \param walk [IN, OUT] A walk that is on the cycle.
+/// \param length Length of the cycle.
+/// \param state [OUT] The state with the smallest fingerprint.
+/// \return Smallest fingerprint.
+
+static uint64_t CycleKey(CCayleyWalk& walk, uint64_t length,
+  std::vector<uint64_t>& state)
+{
+  uint64_t key = walk.GetFingerprint(); //return result
+  walk.GetState(state);
+
+  for(uint64_t i=1; i<length; i++){
+    walk.Step();
+
+    if(walk.GetFingerprint() < key){
+      key = walk.GetFingerprint();
+      walk.GetState(state);
+    } //if
+  } //for
+
+  walk.Step(); //back to where it started
+  return key;
+} //CycleKey
+
+/// Find the number of steps from a state to the cycle that it leads to.
+/// \param ahead A walk, which is used for scratch.
+/// \param behind Another walk, which is used for scratch.
+/// \param start Starting state.
+/// \param length Length of the cycle.
+/// \return Number of steps before the walk gets to the cycle.
+
+static uint64_t TailLength(CCayleyWalk& ahead, CCayleyWalk& behind,
+  const std::vector<uint64_t>& start, uint64_t length)
+{
+  ahead.SetState(start);
+  behind.SetState(start);
+
+  for(uint64_t i=0; i<length; i++)
+    ahead.Step();
+
+  std::vector<uint64_t> a, b; //states, to be sure
+  uint64_t tail = 0; //return result
+
+  for(;;){
+    if(ahead.GetFingerprint() == behind.GetFingerprint()){
+      ahead.GetState(a);
+      behind.GetState(b);
+      if(a == b)break;
+    } //if
+
+    ahead.Step();
+    behind.Step();
+    tail++;
+  } //for
+
+  return tail;
+} //TailLength
+
+/// \brief Walk trails on one thread of the collision search.
+///
+/// Walk trails \f$i, i + t, i + 2t, \ldots\f$ where \f$t\f$ is the number
+/// of threads, each from a pseudorandom state until it reaches a
+/// distinguished point that is already in the table, gets a fingerprint
+/// that clashes with one in the table, or, by Brent's algorithm, repeats a
+/// state without doing either, which happens on cycles with no
+/// distinguished point, many of which are very short.
+/// \param i Thread index.
+/// \param nThreads Number of threads.
+/// \param seed Seed for the starting states.
+/// \param search Shared state of the search.
+
+static void SearchThread(uint32_t i, uint32_t nThreads, uint64_t seed,
+  CSearch* search)
+{
+  PinThread(i);
+
+  CCayleyWalk walk(search->m_nSize, search->m_nLength, search->m_nBits);
+  CCayleyWalk scratch(search->m_nSize, search->m_nLength, search->m_nBits);
+  walk.ShareTables(*search->m_pWalk);
+  scratch.ShareTables(*search->m_pWalk);
+
+  CMersenneTwister rnd(seed); //for starting states
+  std::vector<uint64_t> start, state, tortoise; //states
+  const uint32_t shift = 64 - search->m_nZeros; //for the distinguished test
+
+  for(uint32_t trail=i; trail<search->m_nTrails; trail+=nThreads){
+    walk.Randomize(rnd);
+    walk.GetState(start);
+
+    const uint64_t t0 = search->m_nExplored; //states explored by others
+    uint64_t steps = 0, gap = 0; //steps in trail and since last point
+    uint64_t prev = 0; //fingerprint of last distinguished point
+    bool bPrev = false; //whether there is one
+    Outcome outcome = Outcome::Merged; //what became of it
+    uint64_t fresh = 0; //number of new states
+
+    tortoise = start; //Brent's tortoise
+    uint64_t fpTortoise = walk.GetFingerprint(); //its fingerprint
+    uint64_t power = 1, length = 0; //Brent's power of 2 and cycle length
+
+    for(;;){
+      walk.Step();
+      steps++;
+      gap++;
+      length++;
+
+      const uint64_t fp = walk.GetFingerprint(); //fingerprint
+
+      if(search->m_nZeros == 0 || (fp >> shift) == 0){ //distinguished point
+        walk.GetState(state);
+        std::lock_guard<std::mutex> lock(search->m_stdMutex);
+
+        auto it = search->m_stdPoint.find(fp); //look it up
+        const bool seen = it != search->m_stdPoint.end(); //seen before
+        const bool clash = seen && it->second.m_stdState != state; //not it
+
+        if(!clash){ //the same state, or a new one
+          if(bPrev){ //link the last one to this one
+            CDistinguished& p = search->m_stdPoint.at(prev); //no insertion
+            p.m_nNext = fp;
+            p.m_nLength = gap;
+          } //if
+
+          else{
+            search->m_stdFirst[trail] = fp;
+            search->m_stdHasFirst[trail] = 1;
+          } //else
+        } //if
+
+        if(seen){
+          if(clash)outcome = Outcome::Clash;
+          else if(it->second.m_nTrail == trail)outcome = Outcome::Closed;
+          else outcome = Outcome::Merged;
+
+          //the states after the collision were not new, and there are
+          //about as many of them as there are between distinguished points
+
+          const uint64_t overshoot = uint64_t(1) << search->m_nZeros;
+          fresh = steps > overshoot? steps - overshoot: 0;
+          break;
+        } //if
+
+        CDistinguished& p = search->m_stdPoint[fp]; //new, so keep going
+        p.m_stdState = state;
+        p.m_nTrail = trail;
+        prev = fp;
+        bPrev = true;
+        gap = 0;
+      } //if
+
+      if(fp == fpTortoise){ //repeated a state, probably
+        walk.GetState(state);
+
+        if(state == tortoise){ //on a cycle
+          const uint64_t key = CycleKey(walk, length, state);
+          const uint64_t tail = TailLength(walk, scratch, start, length);
+          fresh = tail + length;
+          steps += 2*length + 2*tail;
+
+          if(search->m_nZeros > 0 && (key >> shift) != 0){ //with no point
+            outcome = Outcome::Bare;
+            std::lock_guard<std::mutex> lock(search->m_stdMutex);
+            CWalkCycle& c = search->m_stdBare[key];
+            c.m_nLength = length;
+            c.m_bBare = true;
+            if(c.m_stdState.empty())c.m_stdState = state;
+            search->m_stdBareKey[trail] = key;
+          } //if
+
+          else outcome = Outcome::Closed; //before it got back to its point
+          break;
+        } //if
+      } //if
+
+      if(length == power){ //move the tortoise to the hare
+        walk.GetState(tortoise);
+        fpTortoise = fp;
+        power *= 2;
+        length = 0;
+      } //if
+    } //for
+
+    std::lock_guard<std::mutex> lock(search->m_stdMutex);
+    search->m_nSteps += steps;
+    search->m_nOutcome[int(outcome)]++;
+
+    if(outcome != Outcome::Clash){ //a collision with others or itself
+      const uint64_t t1 = search->m_nExplored; //explored by now
+      search->m_dExposure += double(fresh)*double(t0 + t1)/4 +
+        double(fresh)*double(fresh)/4;
+      search->m_nExplored += fresh;
+    } //if
+  } //for
+} //SearchThread
+
+/// Find the length of the shortest period of the output of a cycle, which
+/// divides the length of the cycle.
+/// \param walk A walk with the power tables.
+/// \param c A cycle.
+/// \return Length of the shortest period, or 0 if the cycle is too long.
+
+static uint64_t OutputPeriod(CCayleyWalk& walk, const CWalkCycle& c){
+  if(c.m_nLength > (uint64_t(1) << 24))return 0; //too long to store
+
+  walk.SetState(c.m_stdState);
+  std::vector<uint64_t> out(c.m_nLength); //output round the cycle
+
+  for(auto& x: out)
+    x = walk.Step();
+
+  for(uint64_t p=1; p<c.m_nLength; p++)
+    if(c.m_nLength%p == 0){
+      bool ok = true; //whether p is a period
+
+      for(uint64_t i=0; ok && i<c.m_nLength; i++)
+        ok = out[i] == out[(i + p)%c.m_nLength];
+
+      if(ok)return p;
+    } //if
+
+  return c.m_nLength;
+} //OutputPeriod
+
+#pragma endregion search
+
+///////////////////////////////////////////////////////////////////////////////
+//Period analysis
+
+#pragma region analysis
+
+/// Find the order and parity of a permutation from its cycle lengths.
+/// \param p A permutation.
+/// \param odd [OUT] Whether it is odd.
+/// \return Its order, which is the least common multiple of its cycle
+///   lengths.
+
+static uint64_t Order(const CPerm& p, bool& odd){
+  const uint32_t n = p.GetSize(); //permutation size
+  std::vector<bool> seen(n, false); //elements in cycles seen so far
+  uint32_t cycles = 0; //number of cycles, including fixed points
+  uint64_t order = 1; //return result
+
+  for(uint32_t i=0; i<n; i++)
+    if(!seen[i]){
+      uint64_t length = 0; //length of the cycle through i
+      cycles++;
+
+      for(uint32_t j=i; !seen[j]; j=p[uint8_t(j)]){
+        seen[j] = true;
+        length++;
+      } //for
+
+      uint64_t a = order, c = length; //find their greatest common divisor
+
+      while(c != 0){
+        const uint64_t r = a%c; //remainder
+        a = c;
+        c = r;
+      } //while
+
+      order = order/a*length;
+    } //if
+
+  odd = (n - cycles)%2 == 1;
+  return order;
+} //Order
+
+/// Find the cycles of the graph of distinguished points, and the cycle that
+/// each trail ends on.
+/// \param search Search that has finished.
+/// \param cycles [OUT] Cycles by smallest fingerprint, which already holds
+///   the cycles with no distinguished point.
+
+static void FindCycles(const CSearch& search,
+  std::map<uint64_t, CWalkCycle>& cycles)
+{
+  const auto& point = search.m_stdPoint; //shorthand
+  std::unordered_map<uint64_t, uint32_t> stamp; //path that visited each point
+  std::unordered_map<uint64_t, uint64_t> cycleOf; //cycle of each point on one
+  uint32_t path = 0; //current path
+
+  for(auto& start: point){ //follow the path from each point
+    if(stamp.count(start.first))continue;
+    path++;
+    uint64_t x = start.first; //current point
+    bool found = false; //whether the path went round a cycle
+
+    for(;;){
+      auto s = stamp.find(x);
+
+      if(s != stamp.end()){
+        found = s->second == path;
+        break;
+      } //if
+
+      stamp[x] = path;
+      const CDistinguished& p = point.at(x);
+      if(p.m_nLength == 0)break; //dead end
+      x = p.m_nNext;
+      if(point.count(x) == 0)break; //safety
+    } //for
+
+    if(found){ //go round the cycle from x
+      uint64_t length = 0, key = x; //length and smallest fingerprint
+      uint64_t y = x; //current point
+
+      do{
+        const CDistinguished& p = point.at(y);
+        length += p.m_nLength;
+        key = std::min(key, y);
+        y = p.m_nNext;
+      }while(y != x);
+
+      do{
+        cycleOf[y] = key;
+        y = point.at(y).m_nNext;
+      }while(y != x);
+
+      CWalkCycle& c = cycles[key];
+      c.m_nLength = length;
+      c.m_stdState = point.at(key).m_stdState;
+    } //if
+  } //for
+
+  for(uint32_t i=0; i<search.m_nTrails; i++){ //which cycle each trail ends on
+    if(search.m_stdHasFirst[i] == 0){
+      auto it = cycles.find(search.m_stdBareKey[i]);
+      if(it != cycles.end())it->second.m_nTrails++;
+      continue;
+    } //if
+
+    uint64_t x = search.m_stdFirst[i]; //current point
+
+    for(size_t j=0; j<=point.size() && cycleOf.count(x) == 0; j++){
+      auto it = point.find(x);
+      if(it == point.end() || it->second.m_nLength == 0)break; //dead end
+      x = it->second.m_nNext;
+    } //for
+
+    auto c = cycleOf.find(x);
+    if(c != cycleOf.end())cycles[c->second].m_nTrails++;
+  } //for
+} //FindCycles
+
+/// \brief Period and collision analysis.
+///
+/// Search for the cycles of a reduced Cayley walk over \f$S_n\f$ with a
+/// delay line of \f$d\f$ words of \f$b\f$ bits, with generators chosen
+/// by a Mersenne Twister seeded with the low 64 bits of the seed, on all
+/// cores, and print the cycles that it finds, the shortest period of the
+/// output on each, and how often trails collided, next to what would be
+/// expected of a random mapping on the same number of states.
+///
+/// Since the generator parity alternates, the walk is a random mapping only
+/// on the states of one parity taken two steps at a time. If there are
+/// \f$M\f$ states of each parity then a trail is expected to go
+/// \f$2\sqrt{\pi M/2}\f$ steps before it repeats a state, and the cycle
+/// that it ends on is expected to have length \f$\sqrt{\pi M/2}\f$. The
+/// states explored by the trails that collided, and the number of
+/// collisions, give an estimate of \f$M\f$ which is close to the true
+/// number if the walk mixes like a random mapping, and smaller if it is
+/// confined to fewer states.
+/// \param seed Seed.
+/// \param spec Comma-separated \f$n\f$, \f$d\f$, and \f$b\f$, of which
+///   any that are missing take their default values of 8, 2, and 12.
+/// \return true If the parameters are valid.
+
+bool PeriodAnalysis(const uintx_t& seed, const std::string& spec){
+  unsigned n = 8, d = 2, b = 12; //defaults
+  sscanf(spec.c_str(), "%u,%u,%u", &n, &d, &b);
+
+  if(n < 4 || n > 32 || d < 2 || d > 32 || b < 1 || b > 64){
+    printf("Period analysis needs 4 <= n <= 32, 2 <= d <= 32, ");
+    printf("and 1 <= b <= 64.\n");
+    return false;
+  } //if
+
+  CMersenneTwister mt((uint64_t)seed); //for seeding
+  CCayleyWalk walk(n, d, b); //owner of the power tables
+  walk.srand(mt);
+
+  bool odd0, odd1; //whether the generators are odd
+  const uint64_t order0 = Order(walk.GetGenerator(0), odd0);
+  const uint64_t order1 = Order(walk.GetGenerator(1), odd1);
+
+  //log2 of the number of permutations that the walk can reach, of the
+  //number of states of each parity, and of the expected trail length
+
+  const double perms = std::lgamma(n + 1.0)/std::log(2.0) -
+    (odd0 || odd1? 0: 1);
+  const double states = perms + d*std::min(double(b), perms);
+  const double pi = 3.14159265358979323846; //no M_PI in standard C++
+  const double rho = 1 + 0.5*std::log2(pi/2) + states/2;
+
+  printf("Period analysis of the Cayley walk over S_%u with a delay line ", n);
+  printf("of %u words of %u bits.\n", d, b);
+  printf("Generators of order %" PRIu64 " and %" PRIu64 ", %s and %s, ",
+    order0, order1, odd0? "odd": "even", odd1? "odd": "even");
+  printf("so the walk is on %s_%u.\n", odd0 || odd1? "S": "a coset of A", n);
+  printf("About 2^%0.2f states of each generator parity.\n", states);
+
+  if(rho > 28){
+    printf("Too many states to analyze; use a smaller n, d, or b.\n");
+    return false;
+  } //if
+
+  const uint32_t nThreads = GetCoreCount(); //number of threads
+
+  CSearch search; //shared state of the search
+  search.m_pWalk = &walk;
+  search.m_nSize = n;
+  search.m_nLength = d;
+  search.m_nBits = b;
+  search.m_nZeros = uint32_t(std::max(0.0, std::floor(rho) - 8));
+  search.m_nTrails = 4096;
+  search.m_stdFirst.assign(search.m_nTrails, 0);
+  search.m_stdHasFirst.assign(search.m_nTrails, 0);
+  search.m_stdBareKey.assign(search.m_nTrails, 0);
+
+  printf("%u trails on %u threads, distinguished points 1 in 2^%u.\n",
+    search.m_nTrails, nThreads, search.m_nZeros);
+
+  const uint64_t t0 = WallTimeInNanoseconds(); //start time
+  std::vector<std::thread> threads; //the threads
+
+  for(uint32_t i=0; i<nThreads; i++)
+    threads.push_back(std::thread(SearchThread, i, nThreads, mt(), &search));
+
+  for(auto& t: threads)
+    t.join();
+
+  const double seconds = (WallTimeInNanoseconds() - t0)/1e9; //elapsed time
+
+  std::map<uint64_t, CWalkCycle> cycles = search.m_stdBare; //all cycles
+  FindCycles(search, cycles);
+
+  const uint64_t* outcome = search.m_nOutcome; //shorthand
+  printf("%" PRIu64 " steps in %0.2f s, %zu distinguished points.\n",
+    search.m_nSteps, seconds, search.m_stdPoint.size());
+  printf("Trails that merged %" PRIu64 ", closed a cycle %" PRIu64 ", ",
+    outcome[int(Outcome::Merged)], outcome[int(Outcome::Closed)]);
+  printf("ended on a cycle\nwith no distinguished point %" PRIu64 ", ",
+    outcome[int(Outcome::Bare)]);
+  printf("clashed %" PRIu64 ".\n", outcome[int(Outcome::Clash)]);
+
+  //list the cycles that the most trails end on
+
+  std::vector<CWalkCycle*> sorted; //cycles in decreasing order of trails
+  for(auto& c: cycles)
+    sorted.push_back(&c.second);
+
+  std::stable_sort(sorted.begin(), sorted.end(),
+    [](const CWalkCycle* c0, const CWalkCycle* c1){
+      return c0->m_nTrails > c1->m_nTrails;});
+
+  printf("%zu cycles found.\n", cycles.size());
+  printf("Cycle length  Output period  Trails  Distinguished points\n");
+
+  double sum = 0, count = 0; //for the mean cycle length of a trail
+
+  for(size_t i=0; i<sorted.size(); i++){
+    const CWalkCycle& c = *sorted[i]; //shorthand
+    sum += double(c.m_nTrails)*double(c.m_nLength);
+    count += double(c.m_nTrails);
+
+    if(i < 16){
+      const uint64_t period = OutputPeriod(walk, c); //0 if too long
+      printf("%12" PRIu64 "  ", c.m_nLength);
+      if(period > 0)printf("%13" PRIu64, period);
+      else printf("%13s", "?");
+      printf("  %6" PRIu64 "  %s\n", c.m_nTrails, c.m_bBare? "no": "yes");
+    } //if
+  } //for
+
+  if(sorted.size() > 16)
+    printf("%zu more not shown.\n", sorted.size() - 16);
+
+  //compare with a random mapping on the same number of states
+
+  printf("Mean cycle length of a trail: %0.0f steps ", count > 0? sum/count: 0);
+  printf("(random mapping: %0.0f).\n", std::exp2(rho - 1));
+  printf("Cycles expected of a random mapping: %0.1f.\n",
+    0.5*states*std::log(2.0));
+
+  const uint64_t collisions = search.m_nTrails -
+    outcome[int(Outcome::Clash)]; //every other trail ends in one
+
+  if(collisions > 0 && search.m_dExposure > 0){
+    printf("%" PRIu64 " collisions imply about 2^%0.2f states of each ",
+      collisions, std::log2(search.m_dExposure/collisions));
+    printf("parity (random mapping: 2^%0.2f).\n", states);
+  } //if
+
+  return true;
+} //PeriodAnalysis
+
+#pragma endregion analysis
@@ -0,0 +1,43 @@
+/// \file Period.h
+/// \brief Declaration of the period and collision analysis.
+
+#ifndef __period__
+#define __period__
+
+#include <string>
+#include <vector>
+
+#include "Cayley.h"
+#include "mt19937-64.h"
+
+/// \brief A reduced Cayley walk for period analysis.
+///
+/// A Cayley walk with the generators, power tables, and current permutation
+/// of CCayley, but with a delay line of only \f$d\f$ words of \f$b\f$ bits
+/// each, so that the state space is small enough for cycles and collisions
+/// to be found by brute force. Its state is the current permutation, the
+/// delay line starting at its tail, and the generator parity, which
+/// determine the rest of the walk and its output.
+
+class CCayleyWalk: public CCayley{
+  private:
+    uint32_t m_nLength = 2; ///< Number of words in the delay line.
+    uint64_t m_nMask = 0; ///< Mask for the bits kept of each word.
+    uint64_t m_nPermHash = 0; ///< Hash of the current permutation.
+
+    void HashPerm(); ///< Hash the current permutation.
+
+  public:
+    CCayleyWalk(uint32_t n, uint32_t d, uint32_t b); ///< Constructor.
+
+    void Randomize(CMersenneTwister& rnd); ///< Go to a pseudorandom state.
+    uint64_t Step(); ///< Take a step and get b pseudorandom bits.
+    uint64_t GetFingerprint() const; ///< Get hash of the state.
+
+    void GetState(std::vector<uint64_t>& v) const; ///< Get the state.
+    void SetState(const std::vector<uint64_t>& v); ///< Set the state.
+}; //CCayleyWalk
+
+bool PeriodAnalysis(const uintx_t& seed, const std::string& spec); ///< Period and collision analysis.
+
+#endif
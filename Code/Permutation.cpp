@@ -4,6 +4,9 @@
 #include <string.h> //for memcpy
 #include "Permutation.h"
 #include "Includes.h"
+#include "Kernels.h"
+#include "mt19937-64.h"
+#include "Metrics.h"
 
 ////////////////////////////////////////////////////////////////////////////
 //Constructors and destructors.
@@ -16,56 +19,19 @@
 
 CPerm::CPerm(uint8_t n): m_nSize(n){
   m_nMap = new uint8_t[n];
+  METRIC_ADD(PermAllocs, 1);
 
   for(uint8_t i=0; i<m_nSize; i++)
     m_nMap[i] = i;
 } //constructor
 
-/// Use the method of Hall and Knuth, "Combinatorial analysis and computers",
-/// The American Mathematical Monthly 72(2):21-28, 1965, to construct a 
-/// permutation from its reverse lexicographic number using mixed-radix
-/// arithmetic. This is the inverse of operator uintx_t().
+/// Construct a permutation from its reverse lexicographic number.
+/// This is the inverse of GetNum<uintx_t>().
 /// \param n Size of permutation.
 /// \param m Reverse lexicographic number of permutation.
 
 CPerm::CPerm(uint8_t n, uintx_t m): CPerm(n){
-  uintx_t* factorial = new uintx_t[n]; //factorials
-  factorial[0] = 1;
-
-  for(uint8_t i=1; i<n; i++)
-    factorial[i] = uint32_t(i)*factorial[i - 1];
-
-  const uintx_t nfactorial = uint32_t(n)*factorial[n - 1];
-  m %= nfactorial; //prevent m from being larger than n!
-
-  uint32_t* c = new uint32_t[n]; //c[i] will be the number of p[0..i-1] < p[i]
-  uint32_t* d = new uint32_t[n]; //helper
-
-  for(int i=0; i<n; i++){ //initialize c and d
-    c[i] = 0;
-    d[i] = i;
-  } //for
-  
-  //compute c[0..n-1]
-  
-  for(int i=n-1; i>0; i--){
-    c[i] = uint32_t(m/factorial[i]);
-    m = m%factorial[i];
-  } //for
-  
-  //use c[] and d[] to compute the permutation
-  
-  for(int i=n-1; i>=0; i--){
-    m_nMap[i] = d[c[i]];
-    for(int j=c[i]; j<i; j++)
-      d[j] = d[j + 1];
-  } //for
-
-  //clean up and exit
-  
-  delete [] factorial;
-  delete [] d;
-  delete [] c;
+  SetNum(m);
 } //constructor
 
 /// Construct a permutation from a permutation table. It is assumed that the
@@ -101,9 +67,10 @@ CPerm::~CPerm(){
 
 /// Use the Mersenne Twister to choose a pseudo-random permutation with a
 /// uniform distribution, that is, each permutation is equally likely.
-/// \param rng An external random number generator to use as a seed.
+/// \param rng An external random number generator to use as a seed, either
+/// a function or an instance of a class with operator().
 
-void CPerm::Randomize(uint64_t (*rng)(void)){
+template<class rng_t> void CPerm::Randomize(rng_t& rng){
   for(uint8_t i=0; i<m_nSize-1; i++){ 
     const int j = rng()%((uint64_t)m_nSize - i) + i; //random target
     std::swap(m_nMap[i], m_nMap[j]);
@@ -112,9 +79,10 @@ void CPerm::Randomize(uint64_t (*rng)(void)){
 
 /// Use the Mersenne Twister to choose a pseudo-random odd permutation with a 
 /// uniform distribution, that is, each odd permutation is equally likely.
-/// \param rng An external random number generator to use as a seed.
+/// \param rng An external random number generator to use as a seed, either
+/// a function or an instance of a class with operator().
 
-void CPerm::RandomizeOdd(uint64_t (*rng)(void)){
+template<class rng_t> void CPerm::RandomizeOdd(rng_t& rng){
   int nCount = 0; //number of transpositions
 
   for(uint8_t i=0; i<m_nSize-2; i++){ //all except last pair to enforce oddness
@@ -160,6 +128,13 @@ uint8_t CPerm::GetSize() const{
   return m_nSize;
 } //GetSize
 
+/// Reader function for the map.
+/// \return Pointer to the map, which has GetSize() entries.
+
+const uint8_t* CPerm::GetMap() const{
+  return m_nMap;
+} //GetMap
+
 /// Test whether this is the identity permutation, that is, the permutation
 /// that maps everything to itself.
 /// \return true If this is the identity permutation.
@@ -249,11 +224,25 @@ bool operator==(const CPerm& p0, const CPerm& p1){
 } //operator==
 
 /// Permutation composition, that is, post-multiplication by a permutation.
+/// Permutations of size 32 use the composition kernel selected for this CPU.
 /// \param p A permutation.
 /// \return A reference to this permutation after composition.
 
 const CPerm& CPerm::operator*=(const CPerm& p){
-  const uint8_t* pmap = p.m_nMap; //p's map table
+  return *this *= p.m_nMap;
+} //operator*=
+
+/// Post-multiplication by a permutation given only by its map, which must
+/// have the same size as this permutation.
+/// Permutations of size 32 use the composition kernel selected for this CPU.
+/// \param pmap The map of a permutation.
+/// \return A reference to this permutation after composition.
+
+const CPerm& CPerm::operator*=(const uint8_t* pmap){
+  if(m_nSize == 32){ //fast path
+    Compose32(m_nMap, pmap);
+    return *this;
+  } //if
 
   for(uint8_t i=0; i<m_nSize; i++){ //for each map entry
     uint8_t& m = m_nMap[i]; //current map entry
@@ -287,13 +276,60 @@ template<class uint> uint CPerm::GetNum() const{
   return n;
 } //GetNum
 
+/// Use the method of Hall and Knuth, "Combinatorial analysis and computers",
+/// The American Mathematical Monthly 72(2):21-28, 1965, to set this to the
+/// permutation with a given reverse lexicographic number using mixed-radix
+/// arithmetic. This is the inverse of GetNum(). The mixed-radix digits are
+/// peeled off the bottom by dividing by 2, 3, ..., n in turn, so only
+/// division by a word is needed and no factorials are computed. Reducing
+/// m modulo n! happens automatically.
+/// \param m Reverse lexicographic number of permutation.
+
+template<class uint> void CPerm::SetNum(uint m){
+  uint8_t c[256]; //c[i] will be the number of p[0..i-1] < p[i]
+  uint8_t d[256]; //helper
+
+  c[0] = 0;
+
+  for(int i=1; i<m_nSize; i++){ //compute c[1..n-1]
+    c[i] = uint8_t(uint32_t(m%uint32_t(i + 1)));
+    m = m/uint32_t(i + 1);
+  } //for
+
+  for(int i=0; i<m_nSize; i++)
+    d[i] = i;
+  
+  //use c[] and d[] to compute the permutation
+  
+  for(int i=m_nSize - 1; i>=0; i--){
+    m_nMap[i] = d[c[i]];
+    for(int j=c[i]; j<i; j++)
+      d[j] = d[j + 1];
+  } //for
+} //SetNum
+
 /////////////////////////////////////////////////////////////////////////////
 //explicit template instantiations
 
 template uintx_t CPerm::GetNum<uintx_t>() const;
+template uint512w_t CPerm::GetNum<uint512w_t>() const;
+template uint256w_t CPerm::GetNum<uint256w_t>() const;
+template uint128w_t CPerm::GetNum<uint128w_t>() const;
 template uint64_t CPerm::GetNum<uint64_t>() const;
 template uint32_t CPerm::GetNum<uint32_t>() const;
 template uint16_t CPerm::GetNum<uint16_t>() const;
 template uint8_t  CPerm::GetNum<uint8_t>() const;
 
-#pragma endregion operators
\ No newline at end of file
+template void CPerm::SetNum<uintx_t>(uintx_t m);
+template void CPerm::SetNum<uint512w_t>(uint512w_t m);
+template void CPerm::SetNum<uint256w_t>(uint256w_t m);
+template void CPerm::SetNum<uint128w_t>(uint128w_t m);
+template void CPerm::SetNum<uint64_t>(uint64_t m);
+template void CPerm::SetNum<uint32_t>(uint32_t m);
+
+template void CPerm::Randomize<uint64_t(void)>(uint64_t (&)(void));
+template void CPerm::Randomize<CMersenneTwister>(CMersenneTwister&);
+template void CPerm::RandomizeOdd<uint64_t(void)>(uint64_t (&)(void));
+template void CPerm::RandomizeOdd<CMersenneTwister>(CMersenneTwister&);
+
+#pragma endregion operators
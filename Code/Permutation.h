@@ -7,6 +7,7 @@
 #include <cinttypes>
 
 #include "uintx_t.h"
+#include "wide_uint.h"
 
 /// \brief Permutation.
 ///
@@ -32,22 +33,25 @@ class CPerm{
 
     ~CPerm(); ///< Destructor.
 
-    void Randomize(uint64_t (*rng)(void)); ///< Set to random permutation.
-    void RandomizeOdd(uint64_t (*rng)(void)); ///< Set to random odd permutation.
+    template<class rng_t> void Randomize(rng_t& rng); ///< Set to random permutation.
+    template<class rng_t> void RandomizeOdd(rng_t& rng); ///< Set to random odd permutation.
 
     void Randomize(uint32_t s[]); ///< Set to random permutation.
 
     uint8_t GetSize() const; ///< Get size.
+    const uint8_t* GetMap() const; ///< Get map.
     bool IsIdentity() const; ///< Identity permutation test.
 
     void printmap() const; ///< Print as a map.
     void printnum() const; ///< Print reverse lexicographic number.
 
     template<class uint> uint GetNum() const; ///< Get reverse lexicographic number.
+    template<class uint> void SetNum(uint m); ///< Set from reverse lexicographic number.
 
     uint8_t operator[](uint8_t n) const; ///< Get nth element of map.
     CPerm& operator=(const CPerm& p); ///< Assignment operator.
     const CPerm& operator*=(const CPerm& p); ///< Permutation composition.
+    const CPerm& operator*=(const uint8_t* map); ///< Composition with a map.
 
     friend bool operator==(const CPerm& p0, const CPerm& p1); ///< Equality test.
 }; //CPerm
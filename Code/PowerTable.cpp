@@ -1,11 +1,17 @@
 /// \file PowerTable.cpp
 /// \brief Implementation of the power table class CPowerTable.
 
+#include <string.h>
+
 #include "PowerTable.h"
+#include "Metrics.h"
 
 /// Delete all of the permutations we computed to fill the power table.
 
 CPowerTable::~CPowerTable(){
+  METRIC_SUB(TablePerms, m_nOrder);
+  METRIC_SUB(TableBytes, GetBytes());
+
   for(auto p: m_stdPower)
     delete p;
 } //destructor
@@ -16,6 +22,9 @@ CPowerTable::~CPowerTable(){
 
 void CPowerTable::Initialize(const CPerm& p){
   //clean up in case we are re-initializing
+  METRIC_SUB(TablePerms, m_nOrder);
+  METRIC_SUB(TableBytes, GetBytes());
+
   for(auto p: m_stdPower)
     delete p;
   m_stdPower.clear();
@@ -33,8 +42,43 @@ void CPowerTable::Initialize(const CPerm& p){
     q *= p; //next power of p
     m_nOrder++; //next order
   } //while
+
+  //copy the maps into a contiguous block, each map padded to a power of 2
+  //bytes if it is smaller than a cache line so that none straddles two,
+  //otherwise to a whole number of cache lines
+
+  const uint32_t line = 64; //cache line size in bytes
+  m_nStride = 1;
+
+  while(m_nStride < uint32_t(n))
+    m_nStride *= 2;
+
+  if(m_nStride > line)
+    m_nStride = (n + line - 1)/line*line;
+
+  m_stdMap.assign(size_t(m_nOrder)*m_nStride + line - 1, 0);
+
+  const uintptr_t base = uintptr_t(m_stdMap.data()); //unaligned start
+  m_pMap = m_stdMap.data() + (line - base%line)%line; //aligned start
+
+  for(uint32_t i=0; i<m_nOrder; i++)
+    memcpy((uint8_t*)GetMap(i), m_stdPower[i]->GetMap(), n);
+
+  METRIC_ADD(TableBuilds, 1);
+  METRIC_ADD(TablePerms, m_nOrder);
+  METRIC_ADD(TableBytes, GetBytes());
+  TRACE2(table__init, n, m_nOrder);
 } //Initialize
 
+/// Get the number of bytes used by the maps of the powers, both in the
+/// permutations and in the contiguous block.
+/// \return Number of bytes of maps.
+
+size_t CPowerTable::GetBytes() const{
+  const size_t n = m_stdPower.empty()? 0: m_stdPower[0]->GetSize(); //perm size
+  return m_nOrder*n + m_stdMap.size();
+} //GetBytes
+
 /// Reader function for the order of the permutation. Assumes that Initialize() 
 /// has been called.
 /// \return The order of the permutation whose powers are in this table.
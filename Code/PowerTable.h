@@ -8,17 +8,28 @@
 
 #include "Permutation.h"
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)) //Visual Studio
+  #include <xmmintrin.h>
+#endif
+
 /// \brief Table of all powers of a permutation.
 ///
 /// The power table stores power of permutations as an optimization so that
 /// we don't have to keep recomputing them. We just keep computing powers until
 /// we get the identity permutation (which we eventually do because groups).
+/// The maps of the powers are also kept back-to-back in a single aligned
+/// block so that the address of any of them can be computed, and prefetched,
+/// without first loading a pointer.
 
 class CPowerTable{
   private:
     std::vector<CPerm*> m_stdPower; ///< Table of powers.
     uint32_t m_nOrder = 0; ///< Order of the underlying permutation.
 
+    std::vector<uint8_t> m_stdMap; ///< Maps of the powers, back-to-back.
+    const uint8_t* m_pMap = nullptr; ///< First map, aligned to a cache line.
+    uint32_t m_nStride = 0; ///< Distance between maps in bytes.
+
   public:
     ~CPowerTable(); ///< Destructor.
 
@@ -26,6 +37,37 @@ class CPowerTable{
 
     const CPerm& operator[](int n) const; ///< Look up power of permutation.
     const uint32_t GetOrder() const; ///< Get the order of the permutation.
+    size_t GetBytes() const; ///< Get the size of the maps.
+
+    inline const uint8_t* GetMap(int n) const; ///< Look up map of power.
+    inline void Prefetch(int n) const; ///< Prefetch map of power.
 }; //CPowerTable
 
+/// Reader function for the map of a power in the contiguous block. Assumes
+/// that Initialize() has been called. This is inline because it is called
+/// once per pseudorandom number.
+/// \param n An exponent.
+/// \return The map of the n'th power of the permutation in this table.
+
+inline const uint8_t* CPowerTable::GetMap(int n) const{
+  return m_pMap + size_t(n)*m_nStride;
+} //GetMap
+
+/// Ask the CPU to start loading the map of a power into L1 cache without
+/// waiting for it. This is only a hint, so it does nothing on compilers
+/// and CPUs that do not support it.
+/// \param n An exponent.
+
+inline void CPowerTable::Prefetch(int n) const{
+  const uint8_t* p = GetMap(n); //map to be prefetched
+
+  for(uint32_t i=0; i<m_nStride; i+=64){ //each cache line
+    #if defined(__GNUC__) //gcc and clang
+      __builtin_prefetch(p + i, 0, 3);
+    #elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+      _mm_prefetch((const char*)(p + i), _MM_HINT_T0);
+    #endif
+  } //for
+} //Prefetch
+
 #endif
\ No newline at end of file
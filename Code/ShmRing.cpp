@@ -0,0 +1,114 @@
+/// \file ShmRing.cpp
+/// \brief Implementation of the shared-memory ring producer.
+
+#include <new>
+#include <csignal>
+
+#include "Includes.h"
+#include "ShmRing.h"
+#include "Cayley32.h"
+#include "Threads.h"
+
+static volatile sig_atomic_t g_bQuit = 0; ///< Set by a signal to stop producing.
+
+/// \brief Signal handler.
+///
+/// Ask the producer to shut down cleanly.
+
+static void OnSignal(int /*sig*/){
+  g_bQuit = 1;
+} //OnSignal
+
+/// Create a shared-memory ring and publish blocks of pseudorandom numbers
+/// from Cayley32 into it until interrupted by SIGINT or SIGTERM. The
+/// producer runs on a single pinned thread and generates each block in place
+/// in shared memory. It waits (yielding) while the ring is full.
+/// Consumers use CShmRingReader from ShmRing.h.
+/// \param name Name of the POSIX shared-memory object, eg. "/cayley".
+/// \param seed Seed.
+/// \param core Logical core to pin the producer to.
+/// \return true If the producer shut down cleanly.
+
+bool Publish(const char* name, const uintx_t& seed, uint32_t core){
+  #ifdef __linux__
+    const uint32_t nSlots = 64; //number of slots, a power of 2
+    const uint32_t nWords = 8192; //block size in 64-bit words
+    const size_t size = ShmRingSize(nSlots, nWords); //shared memory size
+
+    PinThread(core);
+
+    const int fd = shm_open(name, O_CREAT | O_RDWR | O_TRUNC, 0644);
+
+    if(fd < 0 || ftruncate(fd, size) < 0){
+      fprintf(stderr, "Cannot create shared memory %s\n", name);
+      if(fd >= 0)close(fd);
+      return false;
+    } //if
+
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if(base == MAP_FAILED){
+      fprintf(stderr, "Cannot map shared memory %s\n", name);
+      shm_unlink(name);
+      return false;
+    } //if
+
+    //initialize the ring, setting the magic number last
+
+    CShmRingHeader* header = new(base) CShmRingHeader; //ring header
+    CShmRingSlot* slot = new(header + 1) CShmRingSlot[nSlots]; //slots
+    uint64_t* data = (uint64_t*)(slot + nSlots); //blocks
+
+    header->m_nSlots = nSlots;
+    header->m_nBlockWords = nWords;
+    header->m_nClosed.store(0);
+    header->m_nHead.store(0);
+
+    for(uint32_t i=0; i<nSlots; i++)
+      slot[i].m_nSeq.store(i); //empty, waiting for ticket i
+
+    std::atomic_thread_fence(std::memory_order_release);
+    header->m_nMagic = CShmRingHeader::m_nMagicNumber;
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+
+    Cayley32 cayley32; //new PRNG with fixed generators
+    uintx_t s(seed); //seed
+    cayley32.srand(s); //seed it
+
+    fprintf(stderr, "Publishing Cayley32 to %s\n", name);
+
+    //publish blocks with consecutive tickets
+
+    for(uint64_t t=0; !g_bQuit; t++){
+      CShmRingSlot& cur = slot[t & (nSlots - 1)]; //slot for ticket t
+
+      while(cur.m_nSeq.load(std::memory_order_acquire) != t && !g_bQuit)
+        std::this_thread::yield(); //ring full, wait for a release
+
+      if(g_bQuit)break;
+
+      uint64_t* p = data + (t & (nSlots - 1))*nWords; //block for ticket t
+
+      for(uint32_t i=0; i<nWords; i++)
+        p[i] = cayley32.rand();
+
+      cur.m_nSeq.store(t + 1, std::memory_order_release); //publish
+    } //for
+
+    //clean up and exit
+
+    header->m_nClosed.store(1, std::memory_order_release);
+    munmap(base, size);
+    shm_unlink(name);
+
+    fprintf(stderr, "Stopped publishing to %s\n", name);
+    return true;
+
+  #else //other OS
+    fprintf(stderr, "The shared-memory ring requires Linux\n");
+    return false;
+  #endif
+} //Publish
@@ -0,0 +1,219 @@
+/// \file ShmRing.h
+/// \brief Declaration of the shared-memory ring and its client.
+///
+/// This header is all that a consumer process needs in order to read blocks
+/// of pseudorandom numbers published by "generator.exe -shm name". It
+/// depends only on the C++11 standard library and POSIX shared memory.
+
+#ifndef __shmring__
+#define __shmring__
+
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <thread>
+
+#ifdef __linux__ //POSIX shared memory
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+  "The ring needs address-free 64-bit atomics");
+
+/// \brief Header of the shared-memory ring.
+///
+/// The shared-memory object consists of this header followed by an array
+/// of slots, followed by one block of 64-bit words per slot. The ring uses
+/// a lock-free single-producer, multi-consumer protocol based on ticket
+/// numbers. Blocks are published with consecutive tickets 0, 1, 2, ...
+/// and ticket \f$t\f$ lives in slot \f$t \bmod s\f$, where \f$s\f$ is the
+/// number of slots. The sequence number of a slot says what it holds:
+/// - \f$t\f$: empty, waiting for the producer to publish ticket \f$t\f$;
+/// - \f$t+1\f$: ticket \f$t\f$ published, waiting to be claimed;
+/// - \f$t+s\f$: ticket \f$t\f$ released, slot free for ticket \f$t+s\f$.
+/// A consumer claims ticket \f$t\f$ by a compare-and-swap on the head, so
+/// each block is claimed by exactly one consumer, and tickets only grow, so
+/// no block is ever handed out twice.
+
+struct CShmRingHeader{
+  static const uint64_t m_nMagicNumber = 0x43594c4559524e47; ///< "CYLEYRNG".
+
+  uint64_t m_nMagic; ///< Magic number, set last by the producer.
+  uint32_t m_nSlots; ///< Number of slots, a power of 2.
+  uint32_t m_nBlockWords; ///< Number of 64-bit words in a block.
+  std::atomic<uint32_t> m_nClosed; ///< Nonzero when the producer has quit.
+
+  alignas(64) std::atomic<uint64_t> m_nHead; ///< Next ticket to be claimed.
+}; //CShmRingHeader
+
+/// \brief A slot in the shared-memory ring.
+///
+/// Each slot has its own cache line to prevent false sharing.
+
+struct CShmRingSlot{
+  alignas(64) std::atomic<uint64_t> m_nSeq; ///< Sequence number.
+}; //CShmRingSlot
+
+/// Size of the shared-memory object for a ring.
+/// \param slots Number of slots.
+/// \param words Number of 64-bit words per block.
+/// \return Size in bytes.
+
+inline size_t ShmRingSize(uint32_t slots, uint32_t words){
+  return sizeof(CShmRingHeader) + slots*sizeof(CShmRingSlot) +
+    size_t(slots)*words*sizeof(uint64_t);
+} //ShmRingSize
+
+/// \brief Consumer of the shared-memory ring.
+///
+/// Blocks are read in place in shared memory with no copying. A consumer
+/// calls Acquire() to claim a block, reads it, and then calls Release() to
+/// give its slot back to the producer. Any number of consumers in any
+/// number of processes may share a ring.
+
+class CShmRingReader{
+  private:
+    void* m_pBase = nullptr; ///< Mapped shared memory.
+    size_t m_nSize = 0; ///< Size of mapped shared memory.
+
+    CShmRingHeader* m_pHeader = nullptr; ///< Ring header.
+    CShmRingSlot* m_pSlot = nullptr; ///< Slots.
+    uint64_t* m_pData = nullptr; ///< Blocks.
+
+  public:
+    /// Unmap the shared memory.
+    ~CShmRingReader(){
+      Close();
+    } //destructor
+
+    /// Map a ring published by a producer.
+    /// \param name Name of the POSIX shared-memory object, eg. "/cayley".
+    /// \return true If successful.
+
+    bool Open(const char* name){
+      #ifdef __linux__
+        Close();
+
+        const int fd = shm_open(name, O_RDWR, 0);
+        if(fd < 0)return false;
+
+        struct stat st; //to get the size of the object
+
+        if(fstat(fd, &st) < 0 || size_t(st.st_size) < sizeof(CShmRingHeader)){
+          close(fd);
+          return false;
+        } //if
+
+        m_nSize = size_t(st.st_size);
+        m_pBase = mmap(nullptr, m_nSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+          fd, 0);
+        close(fd);
+
+        if(m_pBase == MAP_FAILED){
+          m_pBase = nullptr;
+          return false;
+        } //if
+
+        m_pHeader = (CShmRingHeader*)m_pBase;
+
+        if(m_pHeader->m_nMagic != CShmRingHeader::m_nMagicNumber ||
+          m_nSize < ShmRingSize(m_pHeader->m_nSlots, m_pHeader->m_nBlockWords))
+        {
+          Close();
+          return false;
+        } //if
+
+        std::atomic_thread_fence(std::memory_order_acquire); //see the header
+
+        m_pSlot = (CShmRingSlot*)(m_pHeader + 1);
+        m_pData = (uint64_t*)(m_pSlot + m_pHeader->m_nSlots);
+        return true;
+
+      #else //other OS
+        return false;
+      #endif
+    } //Open
+
+    /// Unmap the shared memory, if mapped.
+
+    void Close(){
+      #ifdef __linux__
+        if(m_pBase != nullptr)
+          munmap(m_pBase, m_nSize);
+      #endif
+
+      m_pBase = nullptr;
+      m_pHeader = nullptr;
+    } //Close
+
+    /// Reader function for the block size.
+    /// \return Number of 64-bit words in a block.
+
+    uint32_t GetBlockWords() const{
+      return m_pHeader->m_nBlockWords;
+    } //GetBlockWords
+
+    /// Try to claim the next published block without waiting.
+    /// \param ticket [OUT] Ticket of the claimed block, for Release().
+    /// \return Pointer to the block in shared memory, or nullptr if no
+    /// block is ready.
+
+    const uint64_t* TryAcquire(uint64_t& ticket){
+      const uint64_t mask = m_pHeader->m_nSlots - 1; //for modding by slots
+      uint64_t t = m_pHeader->m_nHead.load(std::memory_order_relaxed);
+
+      while(true){
+        CShmRingSlot& slot = m_pSlot[t & mask]; //slot for ticket t
+        const uint64_t seq = slot.m_nSeq.load(std::memory_order_acquire);
+
+        if(seq < t + 1)return nullptr; //not published yet
+
+        if(seq == t + 1){ //published, try to claim it
+          if(m_pHeader->m_nHead.compare_exchange_weak(t, t + 1,
+            std::memory_order_relaxed))
+          {
+            ticket = t;
+            return m_pData + (t & mask)*m_pHeader->m_nBlockWords;
+          } //if
+        } //if
+
+        else t = m_pHeader->m_nHead.load(std::memory_order_relaxed); //beaten
+      } //while
+    } //TryAcquire
+
+    /// Claim the next published block, yielding to other threads while
+    /// waiting for the producer if necessary.
+    /// \param ticket [OUT] Ticket of the claimed block, for Release().
+    /// \return Pointer to the block in shared memory, or nullptr if the
+    /// producer has quit.
+
+    const uint64_t* Acquire(uint64_t& ticket){
+      while(true){
+        const uint64_t* p = TryAcquire(ticket); //claimed block, if any
+        if(p != nullptr)return p;
+        if(m_pHeader->m_nClosed.load(std::memory_order_acquire))return nullptr;
+        std::this_thread::yield();
+      } //while
+    } //Acquire
+
+    /// Give a claimed block's slot back to the producer. The block must not
+    /// be read after this.
+    /// \param ticket Ticket returned by Acquire() or TryAcquire().
+
+    void Release(uint64_t ticket){
+      const uint64_t mask = m_pHeader->m_nSlots - 1; //for modding by slots
+      m_pSlot[ticket & mask].m_nSeq.store(ticket + m_pHeader->m_nSlots,
+        std::memory_order_release);
+    } //Release
+}; //CShmRingReader
+
+///////////////////////////////////////////////////////////////////////////////
+
+class uintx_t; //declared in uintx_t.h, which consumers do not need
+
+bool Publish(const char* name, const uintx_t& seed, uint32_t core); ///< Publish to shared memory.
+
+#endif
@@ -0,0 +1,295 @@
+/// \file Shuffle.cpp
+/// \brief Implementation of the parallel shuffle CShuffle.
+
+#include <thread>
+#include <memory>
+
+#include "Includes.h"
+#include "Shuffle.h"
+#include "CayleyBank.h"
+#include "Threads.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//Bounded draws
+
+#pragma region draws
+
+/// \brief Unbiased bounded draws from a Cayley32.
+///
+/// Draws numbers uniformly at random below a bound with Lemire's
+/// multiply-and-shift, taking 16 bits at a time from the words of a
+/// Cayley32 when the bound is at most \f$2^{16}\f$ and 32 bits otherwise.
+/// The words are generated in bulk with fill().
+
+class CDraws{
+  private:
+    Cayley32& m_cRng; ///< Source of pseudo-random words.
+    uint64_t m_nBuffer[64]; ///< Pseudo-random words.
+    int m_nIndex = 64; ///< Index of next word in m_nBuffer.
+    uint64_t m_nBits = 0; ///< Bits left over from the current word.
+    int m_nLeft = 0; ///< Number of bits left in m_nBits.
+
+    /// Take bits from the current word, starting a new one if there are
+    /// too few left.
+    /// \tparam b Number of bits, 16 or 32.
+    /// \return Pseudo-random bits.
+
+    template<int b> uint32_t Bits(){
+      if(m_nLeft < b){
+        if(m_nIndex == 64){
+          m_cRng.fill(m_nBuffer, 64);
+          m_nIndex = 0;
+        } //if
+
+        m_nBits = m_nBuffer[m_nIndex++];
+        m_nLeft = 64;
+      } //if
+
+      const uint32_t x = uint32_t(m_nBits & ((uint64_t(1) << b) - 1));
+      m_nBits >>= b;
+      m_nLeft -= b;
+      return x;
+    } //Bits
+
+  public:
+    /// Constructor.
+    /// \param g Seeded source of pseudo-random words.
+
+    CDraws(Cayley32& g): m_cRng(g){}
+
+    /// Draw a number below a bound. The product of \f$b\f$ random bits and
+    /// the bound \f$s\f$ is uniform on multiples of \f$s\f$ below
+    /// \f$2^bs\f$, and its top bits are the draw unless its low \f$b\f$ bits
+    /// fall below \f$2^b \bmod s\f$, in which case it is drawn again. That
+    /// remainder, the only division, is needed only when the low bits are
+    /// below \f$s\f$.
+    /// \param s Bound, \f$0 < s \leq 2^{32}\f$.
+    /// \return Pseudo-random number \f$x\f$, \f$0 \leq x < s\f$.
+
+    inline uint64_t Draw(uint64_t s){
+      if(s <= 65536){
+        uint32_t m = Bits<16>()*uint32_t(s); //product
+
+        if((m & 0xFFFF) < s){
+          const uint32_t t = uint32_t(65536 - s)%uint32_t(s); //threshold
+
+          while((m & 0xFFFF) < t)
+            m = Bits<16>()*uint32_t(s);
+        } //if
+
+        return m >> 16;
+      } //if
+
+      uint64_t m = uint64_t(Bits<32>())*s; //product
+
+      if((m & 0xFFFFFFFF) < s){
+        const uint64_t t = ((uint64_t(1) << 32) - s)%s; //threshold
+
+        while((m & 0xFFFFFFFF) < t)
+          m = uint64_t(Bits<32>())*s;
+      } //if
+
+      return m >> 32;
+    } //Draw
+}; //CDraws
+
+/// Process items on threads, thread \f$t\f$ of \f$T\f$ taking items
+/// \f$t, t + T, t + 2T, \ldots\f$, each with its own Cayley32 that shares
+/// the power tables of another. The calling thread takes the first share.
+/// \param owner Owner of the power tables.
+/// \param nThreads Number of threads.
+/// \param m Number of items.
+/// \param f Function of a Cayley32 and an item index.
+
+template<class F> static void ForEach(const Cayley32& owner,
+  uint32_t nThreads, size_t m, F f)
+{
+  nThreads = uint32_t(std::max<size_t>(std::min<size_t>(nThreads, m), 1));
+
+  auto work = [&](uint32_t t){ //items of thread t
+    Cayley32 g; //this thread's stream
+    g.ShareTables(owner);
+
+    for(size_t i=t; i<m; i+=nThreads)
+      f(g, i);
+  }; //work
+
+  std::vector<std::thread> threads; //the other threads
+
+  for(uint32_t t=1; t<nThreads; t++)
+    threads.push_back(std::thread(work, t));
+
+  work(0);
+
+  for(auto& t: threads)
+    t.join();
+} //ForEach
+
+#pragma endregion draws
+
+///////////////////////////////////////////////////////////////////////////////
+//CShuffle functions
+
+#pragma region shuffle
+
+/// Constructor. The power tables are not built until the first shuffle.
+/// \param nThreads Number of threads, 0 for one per logical core.
+
+CShuffle::CShuffle(uint32_t nThreads): m_nThreads(nThreads){
+} //constructor
+
+/// Build the power tables, which the first shuffle would otherwise do.
+/// This lets the cost of building them be paid, or measured, separately.
+
+void CShuffle::BuildTables(){
+  m_cOwner.BuildTables();
+} //BuildTables
+
+/// Seed the shuffle. The first shuffle after seeding with the same seed
+/// gives the same permutation, as does the second, and so on.
+/// \param seed Seed value.
+
+void CShuffle::srand(const uint128w_t& seed){
+  m_nSeed = seed;
+  m_nCalls = 0;
+} //srand
+
+/// Set the number of threads. This does not change the permutations.
+/// \param n Number of threads, 0 for one per logical core.
+
+void CShuffle::SetThreads(uint32_t n){
+  m_nThreads = n;
+} //SetThreads
+
+/// Set the target numbers of elements in a chunk and in a bucket. An array
+/// no bigger than a bucket is shuffled in place with a Fisher-Yates
+/// shuffle. Buckets should fit in the L2 cache, and there should be
+/// several chunks for each thread. Both change the permutations.
+/// \param chunk Target number of elements per chunk.
+/// \param bucket Target number of elements per bucket, at most \f$2^{24}\f$.
+
+void CShuffle::SetBlocking(size_t chunk, size_t bucket){
+  m_nChunkSize = std::max<size_t>(chunk, 1);
+  m_nBucketSize = std::min<size_t>(std::max<size_t>(bucket, 1), 1 << 24);
+} //SetBlocking
+
+/// Shuffle an array. Chunk \f$c\f$ of \f$C\f$ uses stream \f$c\f$ for its
+/// bucket choices and group \f$g\f$ of buckets uses stream \f$C + g\f$ for
+/// its shuffles, stream \f$i\f$ being a Cayley32 seeded with
+/// CCayleyBank::GetSeed(key, i) for a key that depends on the seed and
+/// the number of shuffles since seeding.
+/// \param p [in, out] Array to shuffle.
+/// \param n Number of elements in the array.
+
+template<class T> void CShuffle::Shuffle(T* p, size_t n){
+  const uint128w_t key = CCayleyBank::GetSeed(m_nSeed, size_t(m_nCalls++));
+  if(n < 2)return;
+
+  m_cOwner.BuildTables();
+
+  const size_t maxBuckets = m_nMaxBuckets; //not bound to a reference
+  const size_t maxChunks = m_nMaxChunks; //not bound to a reference
+
+  const size_t K = std::min((n + m_nBucketSize - 1)/m_nBucketSize,
+    maxBuckets); //number of buckets
+  const size_t C = K == 1? 1: std::min((n + m_nChunkSize - 1)/m_nChunkSize,
+    maxChunks); //number of chunks, and of groups of buckets
+  const uint32_t nThreads = m_nThreads > 0? m_nThreads: GetCoreCount();
+
+  if(K == 1){ //small enough to shuffle in place
+    Cayley32 g; //stream of the only group
+    g.ShareTables(m_cOwner);
+    g.srand(CCayleyBank::GetSeed(key, 1));
+    CDraws draws(g);
+
+    for(size_t i=n-1; i>0; i--)
+      std::swap(p[i], p[draws.Draw(i + 1)]);
+
+    return;
+  } //if
+
+  std::unique_ptr<uint16_t[]> choice(new uint16_t[n]); //bucket of each element
+  std::unique_ptr<T[]> scratch(new T[n]); //elements by bucket
+  std::vector<uint64_t> offset(C*K, 0); //counts, then offsets, by chunk
+  std::vector<uint64_t> start(K + 1, 0); //start of each bucket
+
+  //choose buckets and count elements per bucket in each chunk
+
+  ForEach(m_cOwner, nThreads, C, [&](Cayley32& g, size_t c){
+    g.srand(CCayleyBank::GetSeed(key, c));
+    CDraws draws(g);
+    uint64_t* count = &offset[c*K]; //counts of this chunk
+
+    for(size_t i=c*n/C; i<(c + 1)*n/C; i++){
+      const uint16_t k = uint16_t(draws.Draw(K)); //bucket
+      choice[i] = k;
+      count[k]++;
+    } //for
+  }); //ForEach
+
+  //lay out the buckets, each with its elements in chunk order
+
+  for(size_t c=0; c<C; c++)
+    for(size_t k=0; k<K; k++)
+      start[k + 1] += offset[c*K + k];
+
+  for(size_t k=0; k<K; k++)
+    start[k + 1] += start[k];
+
+  std::vector<uint64_t> next(start.begin(), start.end() - 1); //next offsets
+
+  for(size_t c=0; c<C; c++)
+    for(size_t k=0; k<K; k++){
+      const uint64_t count = offset[c*K + k]; //elements of chunk c in bucket k
+      offset[c*K + k] = next[k];
+      next[k] += count;
+    } //for
+
+  //scatter
+
+  ForEach(m_cOwner, nThreads, C, [&](Cayley32&, size_t c){
+    uint64_t* off = &offset[c*K]; //offsets of this chunk
+
+    for(size_t i=c*n/C; i<(c + 1)*n/C; i++)
+      scratch[off[choice[i]]++] = p[i];
+  }); //ForEach
+
+  //shuffle each bucket back into the array, inside-out
+
+  ForEach(m_cOwner, nThreads, C, [&](Cayley32& g, size_t c){
+    g.srand(CCayleyBank::GetSeed(key, C + c));
+    CDraws draws(g);
+
+    for(size_t k=c*K/C; k<(c + 1)*K/C; k++){
+      const T* src = &scratch[start[k]]; //bucket k
+      T* q = p + start[k]; //where it goes
+      const uint64_t m = start[k + 1] - start[k]; //size of bucket k
+      assert(m <= (uint64_t(1) << 32)); //safety
+
+      for(uint64_t i=0; i<m; i++){
+        const uint64_t j = draws.Draw(i + 1); //where src[i] goes
+        q[i] = q[j];
+        q[j] = src[i];
+      } //for
+    } //for
+  }); //ForEach
+} //Shuffle
+
+/// Shuffle an array of 32-bit elements.
+/// \param p [in, out] Array to shuffle.
+/// \param n Number of elements in the array.
+
+void CShuffle::shuffle(uint32_t* p, size_t n){
+  Shuffle(p, n);
+} //shuffle
+
+/// Shuffle an array of 64-bit elements. This gives the same permutation as
+/// shuffling an array of 32-bit elements of the same length.
+/// \param p [in, out] Array to shuffle.
+/// \param n Number of elements in the array.
+
+void CShuffle::shuffle(uint64_t* p, size_t n){
+  Shuffle(p, n);
+} //shuffle
+
+#pragma endregion shuffle
@@ -0,0 +1,56 @@
+/// \file Shuffle.h
+/// \brief Declaration of the parallel shuffle CShuffle.
+
+#ifndef __Shuffle__
+#define __Shuffle__
+
+#include "Cayley32.h"
+
+/// \brief Parallel shuffle of large arrays driven by Cayley32 streams.
+///
+/// Shuffles an array by scattering and then shuffling (Sanders, 1998).
+/// The array is cut into chunks, and each element of each chunk is sent to
+/// a bucket chosen uniformly at random. The buckets are laid out one after
+/// another in a scratch array, each holding its elements in chunk order,
+/// and each bucket is then shuffled on its own with an inside-out Fisher-Yates
+/// shuffle back into the array. Each chunk, and each group of buckets, has
+/// its own Cayley32 stream, which all share the power tables of one
+/// Cayley32, so chunks and bucket groups can be processed by different
+/// threads. Which permutation results depends on the seed, the number of
+/// shuffles done since seeding, and the chunk and bucket sizes, but not on
+/// the number of threads.
+///
+/// Bounded draws use Lemire's multiply-and-shift, which divides only when a
+/// draw falls in the rare region that must be rejected to avoid bias, and
+/// take 16 bits of a pseudo-random word when the bound allows it, 32 bits
+/// otherwise. The scratch space is the size of the array plus 2 bytes per
+/// element for the bucket choices.
+
+class CShuffle{
+  private:
+    Cayley32 m_cOwner; ///< Owner of the power tables.
+    uint128w_t m_nSeed = 0; ///< Seed.
+    uint64_t m_nCalls = 0; ///< Number of shuffles since seeding.
+    uint32_t m_nThreads = 0; ///< Number of threads, 0 for one per core.
+
+    size_t m_nChunkSize = 262144; ///< Target elements per chunk.
+    size_t m_nBucketSize = 16384; ///< Target elements per bucket.
+
+    static const size_t m_nMaxChunks = 256; ///< Maximum number of chunks.
+    static const size_t m_nMaxBuckets = 65536; ///< Maximum number of buckets.
+
+    template<class T> void Shuffle(T* p, size_t n); ///< Shuffle an array.
+
+  public:
+    CShuffle(uint32_t nThreads=0); ///< Constructor.
+
+    void BuildTables(); ///< Build the power tables now.
+    void srand(const uint128w_t& seed); ///< Seed the shuffle.
+    void SetThreads(uint32_t n); ///< Set the number of threads.
+    void SetBlocking(size_t chunk, size_t bucket); ///< Set chunk and bucket sizes.
+
+    void shuffle(uint32_t* p, size_t n); ///< Shuffle an array.
+    void shuffle(uint64_t* p, size_t n); ///< Shuffle an array.
+}; //CShuffle
+
+#endif
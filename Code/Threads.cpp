@@ -0,0 +1,106 @@
+/// \file Threads.cpp
+/// \brief Implementation of cross-platform thread helper functions.
+
+#include <thread>
+#include <algorithm>
+
+#include "Threads.h"
+
+#ifdef _MSC_VER //Windows Visual Studio
+  #include <windows.h>
+#elif defined(__linux__) //Linux
+  #include <pthread.h>
+  #include <sched.h>
+  #include <dirent.h>
+  #include <stdio.h>
+  #include <stdlib.h>
+  #include <string.h>
+#endif
+
+/// Get the number of logical cores, that is, the number of threads that can
+/// run concurrently.
+/// \return Number of logical cores, at least 1.
+
+uint32_t GetCoreCount(){
+  const uint32_t n = std::thread::hardware_concurrency(); //0 if unknown
+  return n > 0? n: 1;
+} //GetCoreCount
+
+/// Pin the current thread to a logical core so that the operating system
+/// will not migrate it. Does nothing on operating systems that do not
+/// support it.
+/// \param core Logical core number, modulo the number of logical cores.
+/// \return true If the thread was pinned.
+
+bool PinThread(uint32_t core){
+  core %= GetCoreCount(); //safety
+
+  #ifdef _MSC_VER //Windows Visual Studio
+    const DWORD_PTR mask = DWORD_PTR(1) << core; //affinity mask
+    return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+
+  #elif defined(__linux__) //Linux
+    cpu_set_t set; //affinity set
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+
+  #else //other OS
+    return false;
+  #endif
+} //PinThread
+
+/// Get the NUMA node that a logical core belongs to. On Linux this is found
+/// from the nodeN entry in the core's sysfs directory, which exists only on
+/// kernels built with NUMA support, so every core is on node 0 otherwise.
+/// \param core Logical core number, modulo the number of logical cores.
+/// \return NUMA node number, 0 if unknown.
+
+uint32_t GetNodeOfCore(uint32_t core){
+  core %= GetCoreCount(); //safety
+
+  #ifdef _MSC_VER //Windows Visual Studio
+    USHORT node = 0; //return result
+    PROCESSOR_NUMBER pn; //processor number in its group
+    pn.Group = WORD(core/64);
+    pn.Number = BYTE(core%64);
+    pn.Reserved = 0;
+    return GetNumaProcessorNodeEx(&pn, &node)? node: 0;
+
+  #elif defined(__linux__) //Linux
+    char path[64]; //sysfs directory of this core
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u", core);
+
+    DIR* dir = opendir(path); //directory stream
+    if(dir == nullptr)return 0;
+
+    uint32_t node = 0; //return result
+
+    while(dirent* e = readdir(dir)) //look for nodeN
+      if(strncmp(e->d_name, "node", 4) == 0 && e->d_name[4] >= '0' &&
+        e->d_name[4] <= '9')
+      {
+        node = (uint32_t)strtoul(e->d_name + 4, nullptr, 10);
+        break;
+      } //if
+
+    closedir(dir);
+    return node;
+
+  #else //other OS
+    return 0;
+  #endif
+} //GetNodeOfCore
+
+/// Get the number of NUMA nodes that have logical cores, assuming that they
+/// are numbered consecutively.
+/// \return Number of NUMA nodes, at least 1.
+
+uint32_t GetNodeCount(){
+  uint32_t n = 1; //return result
+
+  for(uint32_t i=0; i<GetCoreCount(); i++)
+    n = std::max(n, GetNodeOfCore(i) + 1);
+
+  return n;
+} //GetNodeCount
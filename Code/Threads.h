@@ -0,0 +1,14 @@
+/// \file Threads.h
+/// \brief Declaration of cross-platform thread helper functions.
+
+#ifndef __threads__
+#define __threads__
+
+#include <cinttypes>
+
+uint32_t GetCoreCount(); ///< Number of logical cores.
+bool PinThread(uint32_t core); ///< Pin the current thread to a core.
+uint32_t GetNodeOfCore(uint32_t core); ///< NUMA node of a core.
+uint32_t GetNodeCount(); ///< Number of NUMA nodes.
+
+#endif
@@ -0,0 +1,657 @@
+/// \file WidePerm.cpp
+/// \brief Implementation of the wide permutation CWidePerm and its cycle
+/// decomposition CWideCycles.
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "Includes.h"
+#include "WidePerm.h"
+#include "mt19937-64.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//Helper functions
+
+#pragma region helpers
+
+/// Split a range into equal parts and process them on threads, the calling
+/// thread taking the first part.
+/// \param nThreads Number of threads.
+/// \param n Size of the range.
+/// \param f Function of the thread index and the start and end of its part.
+
+template<class F> static void ParallelFor(uint32_t nThreads, size_t n, F f){
+  nThreads = uint32_t(std::max<size_t>(std::min<size_t>(nThreads, n), 1));
+  std::vector<std::thread> threads; //the other threads
+
+  for(uint32_t t=1; t<nThreads; t++)
+    threads.push_back(std::thread(f, t, t*n/nThreads, (t + 1)*n/nThreads));
+
+  f(uint32_t(0), size_t(0), n/nThreads);
+
+  for(auto& t: threads)
+    t.join();
+} //ParallelFor
+
+/// Write values to positions of a map a block at a time. The position and
+/// value pairs are sorted by the block of the map that the position is in,
+/// with a counting sort, and then written, so that the writes of each block
+/// hit the cache instead of missing it on almost every write as they would
+/// in pseudo-random order.
+/// \param dst [in, out] A map.
+/// \param pair Position and value pairs, interleaved.
+/// \param count Number of pairs.
+/// \param shift Log base 2 of the number of entries per block.
+/// \param nBlocks Number of blocks in the map.
+
+template<class index_t> static void Scatter(index_t* dst, const index_t* pair,
+  size_t count, int shift, size_t nBlocks)
+{
+  std::vector<size_t> next(nBlocks + 1, 0); //next pair of each block
+  std::unique_ptr<index_t[]> sorted(new index_t[2*count]); //sorted pairs
+
+  for(size_t j=0; j<count; j++)
+    next[(pair[2*j] >> shift) + 1]++;
+
+  for(size_t b=1; b<nBlocks; b++)
+    next[b] += next[b - 1];
+
+  for(size_t j=0; j<count; j++){
+    const size_t k = next[pair[2*j] >> shift]++; //index in sorted order
+    sorted[2*k] = pair[2*j];
+    sorted[2*k + 1] = pair[2*j + 1];
+  } //for
+
+  for(size_t k=0; k<count; k++)
+    dst[sorted[2*k]] = sorted[2*k + 1];
+} //Scatter
+
+/// Get the log base 2 of the block size, if blocking is worthwhile, which
+/// it was measured to be only for maps of more than 16 blocks, about the
+/// size of the last-level cache for blocks the size of the L2 cache.
+/// \param n Number of entries in a map.
+/// \param block Entries per block, a power of 2, or 0 for no blocking.
+/// \return Log base 2 of the block size, or -1 for no blocking.
+
+static int BlockShift(size_t n, size_t block){
+  if(block == 0 || n <= 16*block)return -1;
+
+  int shift = 0; //return result
+  while((size_t(1) << (shift + 1)) <= block)shift++;
+
+  return shift;
+} //BlockShift
+
+#pragma endregion helpers
+
+///////////////////////////////////////////////////////////////////////////////
+//CWidePerm functions
+
+#pragma region wideperm
+
+template<class index_t> size_t CWidePerm<index_t>::m_nBlockSize = 65536;
+
+/// Constructor for the identity permutation.
+/// \param n Size, at most one more than the largest index_t.
+
+template<class index_t> CWidePerm<index_t>::CWidePerm(size_t n):
+  m_stdMap(n)
+{
+  assert(n == 0 || n - 1 <= size_t(index_t(~index_t(0)))); //safety
+
+  for(size_t i=0; i<n; i++)
+    m_stdMap[i] = index_t(i);
+} //constructor
+
+/// Constructor from a narrow permutation.
+/// \param p A permutation.
+
+template<class index_t> CWidePerm<index_t>::CWidePerm(const CPerm& p):
+  m_stdMap(p.GetMap(), p.GetMap() + p.GetSize()){
+} //constructor
+
+/// Choose a pseudo-random permutation with a uniform distribution with a
+/// Fisher-Yates shuffle, as CPerm::Randomize() does.
+/// \param rng An external random number generator, either a function or an
+/// instance of a class with operator().
+
+template<class index_t> template<class rng_t>
+  void CWidePerm<index_t>::Randomize(rng_t& rng)
+{
+  const size_t n = m_stdMap.size(); //size
+
+  for(size_t i=0; i+1<n; i++){
+    const size_t j = size_t(rng()%(uint64_t(n) - i) + i); //random target
+    std::swap(m_stdMap[i], m_stdMap[j]);
+  } //for
+} //Randomize
+
+/// Choose a pseudo-random odd permutation with a uniform distribution. The
+/// last transposition of the shuffle is made or not so as to make the
+/// number of transpositions odd.
+/// \param rng An external random number generator, either a function or an
+/// instance of a class with operator().
+
+template<class index_t> template<class rng_t>
+  void CWidePerm<index_t>::RandomizeOdd(rng_t& rng)
+{
+  const size_t n = m_stdMap.size(); //size
+  assert(n >= 2); //safety
+  size_t nCount = 0; //number of transpositions
+
+  for(size_t i=0; i+2<n; i++){ //all except last pair to enforce oddness
+    const size_t j = size_t(rng()%(uint64_t(n) - i) + i); //random target
+
+    if(i != j){ //not self-target
+      std::swap(m_stdMap[i], m_stdMap[j]);
+      nCount++;
+    } //if
+  } //for
+
+  if(nCount%2 == 0) //even so far
+    std::swap(m_stdMap[n - 2], m_stdMap[n - 1]);
+} //RandomizeOdd
+
+/// Reader function for the size of the permutation.
+/// \return Permutation size.
+
+template<class index_t> size_t CWidePerm<index_t>::GetSize() const{
+  return m_stdMap.size();
+} //GetSize
+
+/// Reader function for the map.
+/// \return Pointer to the map, which has GetSize() entries.
+
+template<class index_t> const index_t* CWidePerm<index_t>::GetMap() const{
+  return m_stdMap.data();
+} //GetMap
+
+/// Test for the identity permutation.
+/// \return true If this is the identity permutation.
+
+template<class index_t> bool CWidePerm<index_t>::IsIdentity() const{
+  for(size_t i=0; i<m_stdMap.size(); i++)
+    if(m_stdMap[i] != i)return false;
+
+  return true;
+} //IsIdentity
+
+/// Post-multiply by a permutation given only by its map, which must have the
+/// same size as this permutation, replacing each entry \f$m_i\f$ with
+/// \f$p_{m_i}\f$. This is not blocked, unlike Invert(), since its
+/// pseudo-random reads are independent of each other, so the CPU overlaps
+/// their cache misses by itself, which was measured to be faster than
+/// sorting them by block first.
+/// \param map The map of a permutation, which may be our own.
+/// \param nThreads Number of threads.
+
+template<class index_t> void CWidePerm<index_t>::Compose(const index_t* map,
+  uint32_t nThreads)
+{
+  index_t* m = m_stdMap.data(); //shorthand for our map
+
+  std::vector<index_t> copy; //copy of our map, if it is the other map
+  if(map == m)map = (copy = m_stdMap).data();
+
+  ParallelFor(nThreads, m_stdMap.size(), [&](uint32_t, size_t lo, size_t hi){
+    for(size_t i=lo; i<hi; i++)
+      m[i] = map[m[i]];
+  }); //ParallelFor
+} //Compose
+
+/// Get the inverse. If the map is big enough (see BlockShift()), each
+/// thread writes its part of the inverse a block at a time with Scatter().
+/// \param p [OUT] The inverse.
+/// \param nThreads Number of threads.
+
+template<class index_t> void CWidePerm<index_t>::Invert(CWidePerm& p,
+  uint32_t nThreads) const
+{
+  assert(&p != this); //safety
+
+  const size_t n = m_stdMap.size(); //size
+  const index_t* m = m_stdMap.data(); //shorthand for our map
+  p.m_stdMap.resize(n);
+  index_t* inv = p.m_stdMap.data(); //shorthand for the inverse map
+
+  const int shift = BlockShift(n, m_nBlockSize); //log of block size
+
+  ParallelFor(nThreads, n, [&](uint32_t, size_t lo, size_t hi){
+    if(shift < 0){ //unblocked
+      for(size_t i=lo; i<hi; i++)
+        inv[m[i]] = index_t(i);
+
+      return;
+    } //if
+
+    std::unique_ptr<index_t[]> pair(new index_t[2*(hi - lo)]); //for Scatter
+
+    for(size_t i=lo; i<hi; i++){
+      pair[2*(i - lo)] = m[i];
+      pair[2*(i - lo) + 1] = index_t(i);
+    } //for
+
+    Scatter(inv, pair.get(), hi - lo, shift, ((n - 1) >> shift) + 1);
+  }); //ParallelFor
+} //Invert
+
+/// Set the number of map entries per block for inversion and for the maps
+/// of powers made by CWideCycles::GetPower(). Maps of at most 16 blocks
+/// are accessed directly. This does not change any results.
+/// \param n Entries per block, rounded down to a power of 2, 0 for no
+///   blocking.
+
+template<class index_t> void CWidePerm<index_t>::SetBlockSize(size_t n){
+  m_nBlockSize = 0;
+
+  if(n > 0)
+    for(m_nBlockSize=1; 2*m_nBlockSize<=n; m_nBlockSize*=2);
+} //SetBlockSize
+
+/// Reader function for the number of map entries per block.
+/// \return Entries per block, 0 for no blocking.
+
+template<class index_t> size_t CWidePerm<index_t>::GetBlockSize(){
+  return m_nBlockSize;
+} //GetBlockSize
+
+/// Get the image of an element.
+/// \param n An element.
+/// \return The image of n.
+
+template<class index_t> index_t CWidePerm<index_t>::operator[](size_t n) const{
+  return m_stdMap[n];
+} //operator[]
+
+/// Post-multiplication by a permutation on one thread.
+/// \param p A permutation of the same size.
+/// \return A reference to this permutation after composition.
+
+template<class index_t>
+  const CWidePerm<index_t>& CWidePerm<index_t>::operator*=(const CWidePerm& p)
+{
+  assert(p.GetSize() == GetSize()); //safety
+  Compose(p.GetMap());
+  return *this;
+} //operator*=
+
+/// Equality test.
+/// \param p0 A permutation.
+/// \param p1 A permutation.
+/// \return true If the permutations are equal.
+
+template<class index_t> bool operator==(const CWidePerm<index_t>& p0,
+  const CWidePerm<index_t>& p1)
+{
+  return p0.m_stdMap == p1.m_stdMap;
+} //operator==
+
+#pragma endregion wideperm
+
+///////////////////////////////////////////////////////////////////////////////
+//CWideCycles functions
+
+#pragma region widecycles
+
+/// \brief Part of a cycle found by one walker.
+
+struct CCyclePiece{
+  size_t m_nList = 0; ///< List that holds its elements.
+  size_t m_nBegin = 0; ///< Start of its elements in the list.
+  size_t m_nEnd = 0; ///< End of its elements in the list.
+  size_t m_nFirst = 0; ///< Its first element.
+  size_t m_nNext = 0; ///< Image of its last element, the first of another.
+}; //CCyclePiece
+
+/// Claim an element for a piece on one thread.
+/// \param claimed Whether each element has been claimed.
+/// \param x An element.
+/// \return true If it had already been claimed.
+
+static inline bool Claim(uint8_t* claimed, size_t x){
+  const bool b = claimed[x] != 0; //return result
+  claimed[x] = 1;
+  return b;
+} //Claim
+
+/// Claim an element for a piece on one of many threads.
+/// \param claimed Whether each element has been claimed.
+/// \param x An element.
+/// \return true If it had already been claimed.
+
+static inline bool Claim(std::atomic<uint8_t>* claimed, size_t x){
+  return claimed[x].exchange(1, std::memory_order_relaxed) != 0;
+} //Claim
+
+/// Follow the cycles of a permutation from the unclaimed elements of a
+/// range, claiming elements as we go, stopping each piece at the first
+/// element already claimed. The range is split among several walkers that
+/// take a step each in turn, so that the cache misses of their steps, each
+/// of which depends on the last, overlap.
+/// \param m A map.
+/// \param claimed Whether each element has been claimed.
+/// \param lo Start of the range.
+/// \param hi End of the range.
+/// \param first Index of the list of the first walker.
+/// \param nWalkers Number of walkers.
+/// \param list [in, out] Elements of the pieces of each walker.
+/// \param piece [in, out] Pieces found by each walker.
+
+template<class index_t, class claim_t> static void FollowPieces(
+  const index_t* m, claim_t* claimed, size_t lo, size_t hi, size_t first,
+  uint32_t nWalkers, std::vector<std::vector<index_t>>& list,
+  std::vector<std::vector<CCyclePiece>>& piece)
+{
+  std::vector<size_t> next(nWalkers), end(nWalkers); //range of each walker
+  std::vector<size_t> cur(nWalkers); //current element of each walker
+  std::vector<CCyclePiece> c(nWalkers); //current piece of each walker
+  std::vector<bool> walking(nWalkers, false); //whether in a piece
+
+  for(uint32_t k=0; k<nWalkers; k++){
+    next[k] = lo + k*(hi - lo)/nWalkers;
+    end[k] = lo + (k + 1)*(hi - lo)/nWalkers;
+  } //for
+
+  for(uint32_t active=nWalkers; active>0; ){
+    active = 0;
+
+    for(uint32_t k=0; k<nWalkers; k++){
+      std::vector<index_t>& v = list[first + k]; //this walker's elements
+
+      if(!walking[k]){ //find an unclaimed element to start a piece
+        while(next[k] < end[k] && Claim(claimed, next[k]))next[k]++;
+        if(next[k] == end[k])continue;
+
+        cur[k] = next[k]++;
+        c[k].m_nList = first + k;
+        c[k].m_nBegin = v.size();
+        c[k].m_nFirst = cur[k];
+        v.push_back(index_t(cur[k]));
+        walking[k] = true;
+      } //if
+
+      else{ //take a step
+        const size_t y = m[cur[k]]; //next element
+
+        if(Claim(claimed, y)){ //end of piece
+          c[k].m_nEnd = v.size();
+          c[k].m_nNext = y;
+          piece[first + k].push_back(c[k]);
+          walking[k] = false;
+        } //if
+
+        else{
+          #if defined(__GNUC__) //gcc and clang
+            __builtin_prefetch(m + y, 0, 3);
+          #endif
+
+          v.push_back(index_t(y));
+          cur[k] = y;
+        } //else
+      } //else
+
+      active++;
+    } //for
+  } //for
+} //FollowPieces
+
+/// Find the cycles of a permutation. For a small permutation on one thread,
+/// this follows the cycle of each element not yet seen in order, so each
+/// cycle starts at its smallest element. Otherwise, each of several walkers
+/// on each thread follows cycles from the unclaimed elements of its range
+/// with FollowPieces(), stopping at the first element already claimed,
+/// which must be the first element of another piece, since every other
+/// claimed element has its preimage in the same piece. The pieces are then
+/// joined into cycles, which are rotated and sorted into the same order as
+/// for a small permutation.
+/// \param p A permutation.
+/// \param nThreads Number of threads.
+
+template<class index_t> void CWideCycles<index_t>::Initialize(
+  const CWidePerm<index_t>& p, uint32_t nThreads)
+{
+  const size_t n = p.GetSize(); //size
+  const index_t* m = p.GetMap(); //shorthand for the map
+  const uint32_t nWalkers = 8; //walkers per thread
+  nThreads = uint32_t(std::max<size_t>(std::min<size_t>(nThreads, n), 1));
+
+  m_stdElement.resize(n);
+  m_stdStart.clear();
+
+  if(nThreads == 1 && n <= 65536){ //serial
+    std::vector<bool> seen(n, false); //whether each element has been seen
+    size_t j = 0; //next element
+
+    for(size_t i=0; i<n; i++)
+      if(!seen[i]){
+        m_stdStart.push_back(j);
+        size_t x = i; //current element
+
+        do{
+          seen[x] = true;
+          m_stdElement[j++] = index_t(x);
+          x = m[x];
+        }while(x != i);
+      } //if
+
+    m_stdStart.push_back(n);
+    return;
+  } //if
+
+  std::vector<std::vector<index_t>> list(nThreads*nWalkers); //by walker
+  std::vector<std::vector<CCyclePiece>> piece(nThreads*nWalkers); //by walker
+
+  if(nThreads == 1){ //no need for atomics
+    std::vector<uint8_t> claimed(n, 0); //whether each element is claimed
+    FollowPieces(m, claimed.data(), 0, n, 0, nWalkers, list, piece);
+  } //if
+
+  else{
+    std::unique_ptr<std::atomic<uint8_t>[]> claimed(
+      new std::atomic<uint8_t>[n]); //whether each element is claimed
+
+    ParallelFor(nThreads, n, [&](uint32_t, size_t lo, size_t hi){
+      for(size_t i=lo; i<hi; i++)
+        claimed[i].store(0, std::memory_order_relaxed);
+    }); //ParallelFor
+
+    ParallelFor(nThreads, n, [&](uint32_t t, size_t lo, size_t hi){
+      FollowPieces(m, claimed.get(), lo, hi, t*nWalkers, nWalkers, list,
+        piece);
+    }); //ParallelFor
+  } //else
+
+  std::vector<CCyclePiece> all; //all pieces, sorted by first element
+
+  for(auto& v: piece)
+    all.insert(all.end(), v.begin(), v.end());
+
+  std::sort(all.begin(), all.end(),
+    [](const CCyclePiece& a, const CCyclePiece& b){
+      return a.m_nFirst < b.m_nFirst;});
+
+  auto find = [&](size_t x){ //index of the piece starting at x
+    return size_t(std::lower_bound(all.begin(), all.end(), x,
+      [](const CCyclePiece& a, size_t y){return a.m_nFirst < y;}) -
+      all.begin());
+  }; //find
+
+  std::vector<bool> used(all.size(), false); //whether each piece is used
+  std::vector<std::pair<size_t, size_t>> cycle; //smallest element, piece
+  std::vector<index_t> scratch; //elements of one cycle
+
+  for(size_t i=0; i<all.size(); i++)
+    if(!used[i]){ //the smallest first element of a new cycle
+      size_t smallest = all[i].m_nFirst; //smallest element of the cycle
+
+      for(size_t j=i; !used[j]; j=find(all[j].m_nNext)){
+        used[j] = true;
+        const index_t* e = list[all[j].m_nList].data(); //its elements
+
+        for(size_t k=all[j].m_nBegin; k<all[j].m_nEnd; k++)
+          smallest = std::min<size_t>(smallest, e[k]);
+      } //for
+
+      cycle.push_back(std::make_pair(smallest, i));
+    } //if
+
+  std::sort(cycle.begin(), cycle.end());
+  size_t j = 0; //next element
+
+  for(auto& c: cycle){ //copy each cycle, starting at its smallest element
+    scratch.clear();
+    size_t k = c.second; //current piece
+
+    do{
+      const index_t* e = list[all[k].m_nList].data(); //its elements
+      scratch.insert(scratch.end(), e + all[k].m_nBegin, e + all[k].m_nEnd);
+      k = find(all[k].m_nNext);
+    }while(k != c.second);
+
+    const size_t r = size_t(std::find(scratch.begin(), scratch.end(),
+      index_t(c.first)) - scratch.begin()); //rotation
+    m_stdStart.push_back(j);
+    std::rotate_copy(scratch.begin(), scratch.begin() + r, scratch.end(),
+      m_stdElement.begin() + j);
+    j += scratch.size();
+  } //for
+
+  m_stdStart.push_back(n);
+} //Initialize
+
+/// Reader function for the number of cycles, including fixed points.
+/// \return Number of cycles.
+
+template<class index_t> size_t CWideCycles<index_t>::GetCount() const{
+  return m_stdStart.empty()? 0: m_stdStart.size() - 1;
+} //GetCount
+
+/// Reader function for the length of a cycle.
+/// \param i Index of a cycle.
+/// \return Length of cycle i.
+
+template<class index_t> size_t CWideCycles<index_t>::GetLength(size_t i) const{
+  return m_stdStart[i + 1] - m_stdStart[i];
+} //GetLength
+
+/// Reader function for a cycle.
+/// \param i Index of a cycle.
+/// \return Pointer to the GetLength(i) elements of cycle i, in order.
+
+template<class index_t>
+  const index_t* CWideCycles<index_t>::GetCycle(size_t i) const
+{
+  return m_stdElement.data() + m_stdStart[i];
+} //GetCycle
+
+/// Test for an odd permutation, which has an odd number of cycles of even
+/// length, or equivalently its size less its number of cycles is odd.
+/// \return true If the permutation is odd.
+
+template<class index_t> bool CWideCycles<index_t>::IsOdd() const{
+  return (m_stdElement.size() - GetCount())%2 == 1;
+} //IsOdd
+
+/// Get the order of the permutation, the least common multiple of its cycle
+/// lengths, which is the product over primes of the highest power of each
+/// that divides a cycle length.
+/// \return The order.
+
+template<class index_t> uintx_t CWideCycles<index_t>::GetOrder() const{
+  std::vector<size_t> length; //distinct cycle lengths
+
+  for(size_t i=0; i<GetCount(); i++)
+    length.push_back(GetLength(i));
+
+  std::sort(length.begin(), length.end());
+  length.erase(std::unique(length.begin(), length.end()), length.end());
+
+  std::vector<std::pair<size_t, size_t>> power; //prime and highest power
+
+  for(size_t x: length)
+    for(size_t p=2; x>1; p++){
+      if(p*p > x)p = x; //x is prime
+      size_t q = 1; //power of p dividing x
+
+      while(x%p == 0){
+        x /= p;
+        q *= p;
+      } //while
+
+      if(q > 1)power.push_back(std::make_pair(p, q));
+    } //for
+
+  std::sort(power.begin(), power.end());
+  uintx_t order = 1; //return result
+
+  for(size_t i=0; i<power.size(); i++)
+    if(i + 1 == power.size() || power[i + 1].first != power[i].first)
+      order = order*uint32_t(power[i].second);
+
+  return order;
+} //GetOrder
+
+/// Get the map of a power of the permutation without a power table, by
+/// sending each element \f$k\f$ places along its cycle, that is, \f$k\f$
+/// modulo the cycle length. The elements of the cycles are split into
+/// equal ranges for the threads. If the map is big enough (see
+/// BlockShift()), each thread writes its part of it a block at a time with
+/// Scatter().
+/// \param k Exponent.
+/// \param map [OUT] Map of the \f$k\f$th power, of the permutation's size.
+/// \param nThreads Number of threads.
+
+template<class index_t> void CWideCycles<index_t>::GetPower(uint64_t k,
+  index_t* map, uint32_t nThreads) const
+{
+  const size_t n = m_stdElement.size(); //size
+  const index_t* e = m_stdElement.data(); //shorthand for the elements
+  const int shift = BlockShift(n, CWidePerm<index_t>::GetBlockSize()); //log
+
+  ParallelFor(nThreads, n, [&](uint32_t, size_t lo, size_t hi){
+    std::unique_ptr<index_t[]> pair(shift < 0? nullptr:
+      new index_t[2*(hi - lo)]); //for Scatter, if blocked
+
+    size_t c = size_t(std::upper_bound(m_stdStart.begin(), m_stdStart.end(),
+      lo) - m_stdStart.begin()) - 1; //cycle containing element lo
+
+    for(size_t i=lo; i<hi; c++){
+      const size_t s = m_stdStart[c], t = m_stdStart[c + 1]; //cycle c
+      const size_t r = size_t(k%(t - s)); //places to move along it
+      const size_t end = std::min(hi, t); //end of cycle c in range
+
+      for(; i<end; i++){
+        const size_t j = i + r < t? i + r: i + r - (t - s); //destination
+
+        if(shift < 0)map[e[i]] = e[j];
+
+        else{
+          pair[2*(i - lo)] = e[i];
+          pair[2*(i - lo) + 1] = e[j];
+        } //else
+      } //for
+    } //for
+
+    if(shift >= 0)
+      Scatter(map, pair.get(), hi - lo, shift, ((n - 1) >> shift) + 1);
+  }); //ParallelFor
+} //GetPower
+
+#pragma endregion widecycles
+
+//////////////////////////////////////////////////////////////////////////////
+//explicit template instantiations
+
+template class CWidePerm<uint16_t>;
+template class CWidePerm<uint32_t>;
+template class CWideCycles<uint16_t>;
+template class CWideCycles<uint32_t>;
+
+template bool operator==(const CWidePerm<uint16_t>&, const CWidePerm<uint16_t>&);
+template bool operator==(const CWidePerm<uint32_t>&, const CWidePerm<uint32_t>&);
+
+template void CWidePerm<uint16_t>::Randomize<CMersenneTwister>(CMersenneTwister&);
+template void CWidePerm<uint32_t>::Randomize<CMersenneTwister>(CMersenneTwister&);
+template void CWidePerm<uint16_t>::RandomizeOdd<CMersenneTwister>(CMersenneTwister&);
+template void CWidePerm<uint32_t>::RandomizeOdd<CMersenneTwister>(CMersenneTwister&);
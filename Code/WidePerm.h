@@ -0,0 +1,87 @@
+/// \file WidePerm.h
+/// \brief Declaration of the wide permutation CWidePerm and its cycle
+/// decomposition CWideCycles.
+
+#ifndef __wideperm__
+#define __wideperm__
+
+#include <vector>
+
+#include "Permutation.h"
+
+/// \brief Permutation with a map of 16-bit or 32-bit integers.
+///
+/// A permutation for symmetric groups far larger than CPerm allows, of
+/// size up to \f$2^{16}\f$ with a map of uint16_t or up to \f$2^{32} - 1\f$
+/// with a map of uint32_t. Composition and inversion can be split over
+/// threads, each taking a range of the map. Inversion writes to the inverse
+/// at random, so when it is much bigger than a block, which should fit in
+/// the L2 cache, each thread first sorts its writes by block and then does
+/// them a block at a time. Composition only reads at random, which the CPU
+/// overlaps well enough by itself.
+
+template<class index_t> class CWidePerm{
+  private:
+    std::vector<index_t> m_stdMap; ///< Permutation sends i to m_stdMap[i].
+
+    static size_t m_nBlockSize; ///< Map entries per block, 0 for no blocking.
+
+  public:
+    CWidePerm(size_t n=0); ///< Constructor.
+    CWidePerm(const CPerm& p); ///< Constructor.
+
+    template<class rng_t> void Randomize(rng_t& rng); ///< Set to random permutation.
+    template<class rng_t> void RandomizeOdd(rng_t& rng); ///< Set to random odd permutation.
+
+    size_t GetSize() const; ///< Get size.
+    const index_t* GetMap() const; ///< Get map.
+    bool IsIdentity() const; ///< Identity permutation test.
+
+    void Compose(const index_t* map, uint32_t nThreads=1); ///< Composition with a map.
+    void Invert(CWidePerm& p, uint32_t nThreads=1) const; ///< Get inverse.
+
+    static void SetBlockSize(size_t n); ///< Set entries per block.
+    static size_t GetBlockSize(); ///< Get entries per block.
+
+    index_t operator[](size_t n) const; ///< Get nth element of map.
+    const CWidePerm& operator*=(const CWidePerm& p); ///< Permutation composition.
+
+    template<class T> friend bool operator==(const CWidePerm<T>& p0,
+      const CWidePerm<T>& p1); ///< Equality test.
+}; //CWidePerm
+
+template<class index_t> bool operator==(const CWidePerm<index_t>& p0,
+  const CWidePerm<index_t>& p1); ///< Is equal to.
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// \brief Cycle decomposition of a wide permutation.
+///
+/// The cycles of a CWidePerm, each starting at its smallest element, in
+/// order of their smallest elements, back-to-back in a single array. This
+/// gives any power of the permutation without a power table, which for
+/// large permutations would be far too big, since the \f$k\f$th power
+/// sends each element to the one \f$k\f$ places further along its cycle.
+/// The decomposition can be split over threads, each of which follows
+/// cycles from the elements of a range of the map, claiming elements as it
+/// goes, and stops when it reaches an element that is already claimed. The
+/// pieces are then joined into whole cycles.
+
+template<class index_t> class CWideCycles{
+  private:
+    std::vector<index_t> m_stdElement; ///< Elements of the cycles, back-to-back.
+    std::vector<size_t> m_stdStart; ///< Start of each cycle, then the end.
+
+  public:
+    void Initialize(const CWidePerm<index_t>& p, uint32_t nThreads=1); ///< Initialize.
+
+    size_t GetCount() const; ///< Get number of cycles.
+    size_t GetLength(size_t i) const; ///< Get length of a cycle.
+    const index_t* GetCycle(size_t i) const; ///< Get a cycle.
+    bool IsOdd() const; ///< Odd permutation test.
+    uintx_t GetOrder() const; ///< Get the order of the permutation.
+
+    void GetPower(uint64_t k, index_t* map, uint32_t nThreads=1) const; ///< Get map of a power.
+}; //CWideCycles
+
+#endif
@@ -0,0 +1,214 @@
+/// \file libcayley.cpp
+/// \brief Implementation of the C interface to Cayley32.
+
+#include <new>
+#include <cctype>
+
+#include "Includes.h"
+#include "Cayley32.h"
+#include "libcayley.h"
+
+/// \brief A generator handle.
+///
+/// A Cayley32 instance that shares the power tables of a single warm
+/// instance, plus the unused bytes of its last 64-bit output so that the
+/// byte stream is unaffected by the lengths passed to cayley_fill().
+
+struct cayley_t{
+  Cayley32 m_cEngine; ///< The generator.
+  uint64_t m_nSpare = 0; ///< Unused bytes of the last output, low byte first.
+  uint32_t m_nSpareBytes = 0; ///< Number of unused bytes in m_nSpare.
+}; //cayley_t
+
+/// Get the warm instance of Cayley32 whose power tables are shared by all
+/// handles. It is built on first use, which is thread-safe in C++11, and
+/// deliberately never destroyed so that handles may outlive static
+/// destructors.
+/// \return Pointer to the warm instance.
+
+static const Cayley32* GetWarm(){
+  static const Cayley32* warm = [](){
+    Cayley32* p = new Cayley32; //warm instance
+    uintx_t seed(0); //any seed will do
+    p->srand(seed); //builds the power tables
+    return p;
+  }(); //lambda
+
+  return warm;
+} //GetWarm
+
+/// Get the version of this interface, which changes only if the interface
+/// changes incompatibly.
+/// \return CAYLEY_ABI_VERSION.
+
+uint32_t cayley_abi_version(void){
+  return CAYLEY_ABI_VERSION;
+} //cayley_abi_version
+
+/// Create a generator seeded with 0.
+/// \return Handle, or NULL if out of memory.
+
+cayley_t* cayley_create(void){
+  try{
+    cayley_t* h = new cayley_t; //new handle
+    h->m_cEngine.ShareTables(*GetWarm());
+    cayley_seed64(h, 0);
+    return h;
+  } //try
+
+  catch(const std::bad_alloc&){
+    return nullptr;
+  } //catch
+} //cayley_create
+
+/// Destroy a generator.
+/// \param h Handle, may be NULL.
+
+void cayley_destroy(cayley_t* h){
+  delete h;
+} //cayley_destroy
+
+/// Seed a generator from a hexadecimal string of any length. Seeding restarts
+/// the stream, that is, equal seeds give equal streams.
+/// \param h Handle.
+/// \param hex Null-terminated string of hexadecimal digits.
+/// \return 0 if successful, -1 if hex is not a nonempty hex string.
+
+int cayley_seed(cayley_t* h, const char* hex){
+  if(hex == nullptr || *hex == '\0')return -1;
+
+  for(const char* p=hex; *p; p++)
+    if(!isxdigit((unsigned char)*p))return -1;
+
+  while(hex[0] == '0' && hex[1] != '\0') //uintx_t wants no leading zeros
+    hex++;
+
+  uintx_t seed(hex); //seed
+  h->m_cEngine.srand(seed);
+  h->m_nSpareBytes = 0;
+
+  return 0;
+} //cayley_seed
+
+/// Seed a generator from a 64-bit unsigned integer. This is equivalent to
+/// seeding it with the hexadecimal representation of that integer.
+/// \param h Handle.
+/// \param seed Seed.
+
+void cayley_seed64(cayley_t* h, uint64_t seed){
+  h->m_cEngine.srand(uint128w_t(seed));
+  h->m_nSpareBytes = 0;
+} //cayley_seed64
+
+/// Get the next 8 bytes of the stream as a 64-bit unsigned integer.
+/// \param h Handle.
+/// \return 64 pseudorandom bits.
+
+uint64_t cayley_next(cayley_t* h){
+  if(h->m_nSpareBytes == 0)
+    return h->m_cEngine.rand();
+
+  uint64_t result; //return result
+  cayley_fill(h, &result, sizeof(result));
+  return result;
+} //cayley_next
+
+/// Fill a buffer with the next bytes of the stream. Whole 64-bit words are
+/// generated in bulk directly into the buffer, which need not be aligned.
+/// \param h Handle.
+/// \param buf [OUT] Buffer.
+/// \param len Number of bytes to generate.
+
+void cayley_fill(cayley_t* h, void* buf, size_t len){
+  uint8_t* p = (uint8_t*)buf; //output pointer
+
+  for(; len > 0 && h->m_nSpareBytes > 0; len--){ //use up spare bytes
+    *p++ = uint8_t(h->m_nSpare);
+    h->m_nSpare >>= 8;
+    h->m_nSpareBytes--;
+  } //for
+
+  const size_t nBufSize = 512; //chunk size in 64-bit words
+  uint64_t chunk[nBufSize]; //aligned chunk
+
+  while(len >= sizeof(uint64_t)){ //whole words
+    const size_t n = std::min(nBufSize, len/sizeof(uint64_t)); //words
+
+    h->m_cEngine.fill(chunk, n);
+
+    for(size_t i=0; i<n; i++) //little-endian on any machine
+      for(int j=0; j<8; j++)
+        *p++ = uint8_t(chunk[i] >> (8*j));
+
+    len -= n*sizeof(uint64_t);
+  } //while
+
+  if(len > 0){ //part of one more word
+    h->m_nSpare = h->m_cEngine.rand();
+    h->m_nSpareBytes = sizeof(uint64_t);
+
+    for(; len > 0; len--){
+      *p++ = uint8_t(h->m_nSpare);
+      h->m_nSpare >>= 8;
+      h->m_nSpareBytes--;
+    } //for
+  } //if
+} //cayley_fill
+
+/// Save a snapshot of the state of a generator. Restoring it with
+/// cayley_restore(), into this or any other handle, continues the stream
+/// from this point. The snapshot is portable between machines.
+/// \param h Handle.
+/// \param buf [OUT] Buffer, may be NULL to query the size.
+/// \param len Size of buf in bytes.
+/// \return CAYLEY_STATE_SIZE, or 0 if buf is too small.
+
+size_t cayley_snapshot(const cayley_t* h, void* buf, size_t len){
+  if(buf == nullptr)return CAYLEY_STATE_SIZE;
+  if(len < CAYLEY_STATE_SIZE)return 0;
+
+  const size_t n = h->m_cEngine.GetStateSize(); //engine state size
+  assert(4 + n + 9 == CAYLEY_STATE_SIZE); //safety
+
+  uint8_t* p = (uint8_t*)buf; //output pointer
+
+  *p++ = 'C'; *p++ = 'Y'; *p++ = 'L'; *p++ = CAYLEY_ABI_VERSION; //header
+
+  h->m_cEngine.SaveState(p);
+  p += n;
+
+  for(int j=0; j<8; j++) //spare bytes, little-endian
+    *p++ = uint8_t(h->m_nSpare >> (8*j));
+
+  *p++ = uint8_t(h->m_nSpareBytes);
+
+  return CAYLEY_STATE_SIZE;
+} //cayley_snapshot
+
+/// Restore a snapshot saved by cayley_snapshot().
+/// \param h Handle.
+/// \param buf Snapshot.
+/// \param len Size of snapshot in bytes.
+/// \return 0 if successful, -1 if the snapshot is not valid, in which case
+/// the handle is unchanged.
+
+int cayley_restore(cayley_t* h, const void* buf, size_t len){
+  const uint8_t* p = (const uint8_t*)buf; //input pointer
+
+  if(len != CAYLEY_STATE_SIZE || p[0] != 'C' || p[1] != 'Y' || p[2] != 'L' ||
+    p[3] != CAYLEY_ABI_VERSION || p[CAYLEY_STATE_SIZE - 1] >= sizeof(uint64_t))
+    return -1;
+
+  if(!h->m_cEngine.LoadState(p + 4))
+    return -1;
+
+  p += 4 + h->m_cEngine.GetStateSize();
+  h->m_nSpare = 0;
+
+  for(int j=0; j<8; j++) //spare bytes, little-endian
+    h->m_nSpare |= uint64_t(*p++) << (8*j);
+
+  h->m_nSpareBytes = *p;
+
+  return 0;
+} //cayley_restore
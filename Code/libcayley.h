@@ -0,0 +1,60 @@
+/** \file libcayley.h
+    \brief C interface to the Cayley32 pseudorandom number generator.
+
+    This is the public interface of libcayley.a and libcayley.so, for use
+    from C and from foreign function interfaces such as Python's ctypes and
+    Rust. A generator is referred to by an opaque handle. Handles are
+    independent of one another and may be used concurrently from different
+    threads, but a single handle must not be used by two threads at once.
+    All handles share one read-only copy of the power tables, which is built
+    when the first handle is created.
+
+    The output of a handle is a stream of bytes, namely the little-endian
+    bytes of consecutive 64-bit outputs of Cayley32. The stream does not
+    depend on how it is split into calls of cayley_fill().
+*/
+
+#ifndef __libcayley__
+#define __libcayley__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER) && defined(CAYLEY_BUILD_DLL)
+  #define CAYLEY_API __declspec(dllexport)
+#elif defined(__GNUC__)
+  #define CAYLEY_API __attribute__((visibility("default")))
+#else
+  #define CAYLEY_API
+#endif
+
+#define CAYLEY_ABI_VERSION 1 /**< Version of this interface. */
+#define CAYLEY_STATE_SIZE 303 /**< Size of a state snapshot in bytes. */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+typedef struct cayley_t cayley_t; /**< Opaque generator handle. */
+
+CAYLEY_API uint32_t cayley_abi_version(void); /**< Get interface version. */
+
+CAYLEY_API cayley_t* cayley_create(void); /**< Create a generator. */
+CAYLEY_API void cayley_destroy(cayley_t* h); /**< Destroy a generator. */
+
+CAYLEY_API int cayley_seed(cayley_t* h, const char* hex); /**< Seed from hex. */
+CAYLEY_API void cayley_seed64(cayley_t* h, uint64_t seed); /**< Seed. */
+
+CAYLEY_API uint64_t cayley_next(cayley_t* h); /**< Get 64 bits. */
+CAYLEY_API void cayley_fill(cayley_t* h, void* buf, size_t len); /**< Fill. */
+
+CAYLEY_API size_t cayley_snapshot(const cayley_t* h, void* buf,
+  size_t len); /**< Save state. */
+CAYLEY_API int cayley_restore(cayley_t* h, const void* buf,
+  size_t len); /**< Restore state. */
+
+#ifdef __cplusplus
+} //extern "C"
+#endif
+
+#endif
@@ -55,10 +55,26 @@
 
 // Modified Feb. 7, 2020 by Ian Parberry to use uint64_t instead of unsigned
 // long long (because it's not 2002 any more).
-
-
-#include <stdio.h>
-#include <cinttypes>
+//
+// Rewritten as the class CMersenneTwister so that it can have more than one
+// instance, with the state regenerated and tempered in SIMD batches. The
+// output is unchanged. The original C functions remain as wrappers around a
+// single global instance.
+
+#include "Includes.h"
+#include "Kernels.h"
+#include "mt19937-64.h"
+
+#if defined(__x86_64__) || defined(_M_X64) //x86-64
+  #define MT_X86 ///< Define to compile the SSE2 and AVX2 twist.
+  #include <immintrin.h>
+
+  #ifdef _MSC_VER //Windows Visual Studio
+    #define TARGET(s) ///< MSVC allows intrinsics anywhere.
+  #else
+    #define TARGET(s) __attribute__((target(s))) ///< Compile for ISA s.
+  #endif
+#endif
 
 #define NN 312
 #define MM 156
@@ -66,28 +82,222 @@
 #define UM 0xFFFFFFFF80000000ULL /* Most significant 33 bits */
 #define LM 0x7FFFFFFFULL /* Least significant 31 bits */
 
+///////////////////////////////////////////////////////////////////////////////
+//Twist and temper kernels
 
-/* The array for the state vector */
-static uint64_t mt[NN]; 
-/* mti==NN+1 means mt[NN] is not initialized */
-static int mti=NN+1; 
+#pragma region kernels
 
-/* initializes mt[NN] with a seed */
-void init_genrand64(uint64_t seed)
+/// Regenerate one word of the state vector.
+/// \param mt [IN, OUT] State vector.
+/// \param i Index of word.
+/// \param j Index of the word MM places further along, modulo NN.
+
+static inline void TwistOne(uint64_t* mt, int i, int j){
+  const uint64_t x = (mt[i]&UM)|(mt[(i + 1)%NN]&LM);
+  mt[i] = mt[j] ^ (x>>1) ^ ((0ULL - (x&1ULL)) & MATRIX_A);
+} //TwistOne
+
+/// Temper a word of the state vector to make an output.
+/// \param x A word of the state vector.
+/// \return Tempered word.
+
+static inline uint64_t Temper(uint64_t x){
+  x ^= (x >> 29) & 0x5555555555555555ULL;
+  x ^= (x << 17) & 0x71D67FFFEDA60000ULL;
+  x ^= (x << 37) & 0xFFF7EEE000000000ULL;
+  x ^= (x >> 43);
+
+  return x;
+} //Temper
+
+/// Scalar twist, exactly as in the reference code.
+/// \param mt [IN, OUT] State vector.
+
+static void TwistScalar(uint64_t* mt){
+  int i;
+
+  for (i=0;i<NN-MM;i++)
+    TwistOne(mt, i, i + MM);
+
+  for (;i<NN;i++)
+    TwistOne(mt, i, i + (MM - NN));
+} //TwistScalar
+
+/// Scalar tempering of a block of the state vector.
+/// \param p [OUT] Output.
+/// \param mt Block of the state vector.
+/// \param n Number of words.
+
+static void TemperScalar(uint64_t* p, const uint64_t* mt, size_t n){
+  for(size_t i=0; i<n; i++)
+    p[i] = Temper(mt[i]);
+} //TemperScalar
+
+#ifdef MT_X86
+
+/// Twist two words at a time with SSE2. Words i and i + 1 depend only on
+/// words i + 1, i + 2, and i + MM, which have not been updated yet, or on
+/// words i + MM - NN, which have, so pairs can be computed independently.
+/// The last word wraps around to the first, so it is done separately.
+/// \param mt [IN, OUT] State vector.
+
+static void TwistSSE2(uint64_t* mt){
+  const __m128i um = _mm_set1_epi64x((long long)UM);
+  const __m128i lm = _mm_set1_epi64x((long long)LM);
+  const __m128i a = _mm_set1_epi64x((long long)MATRIX_A);
+  const __m128i one = _mm_set1_epi64x(1);
+  const __m128i zero = _mm_setzero_si128();
+
+  int i = 0;
+
+  for(int k=0; k<2; k++){ //first NN - MM words, then the rest but the last
+    const int end = k == 0? NN - MM: NN - 1; //end of batches
+    const int off = k == 0? MM: MM - NN; //offset of word MM places along
+
+    for(; i + 2<=end; i+=2){
+      const __m128i y = _mm_loadu_si128((const __m128i*)(mt + i));
+      const __m128i z = _mm_loadu_si128((const __m128i*)(mt + i + 1));
+      const __m128i w = _mm_loadu_si128((const __m128i*)(mt + i + off));
+
+      const __m128i x = _mm_or_si128(_mm_and_si128(y, um),
+        _mm_and_si128(z, lm));
+      const __m128i mag = _mm_and_si128(a,
+        _mm_sub_epi64(zero, _mm_and_si128(x, one)));
+
+      _mm_storeu_si128((__m128i*)(mt + i),
+        _mm_xor_si128(_mm_xor_si128(w, _mm_srli_epi64(x, 1)), mag));
+    } //for
+  } //for
+
+  for(; i<NN; i++) //leftovers
+    TwistOne(mt, i, i + (MM - NN));
+} //TwistSSE2
+
+/// Temper two words at a time with SSE2.
+/// \param p [OUT] Output.
+/// \param mt Block of the state vector.
+/// \param n Number of words.
+
+static void TemperSSE2(uint64_t* p, const uint64_t* mt, size_t n){
+  const __m128i c0 = _mm_set1_epi64x(0x5555555555555555LL);
+  const __m128i c1 = _mm_set1_epi64x(0x71D67FFFEDA60000LL);
+  const __m128i c2 = _mm_set1_epi64x((long long)0xFFF7EEE000000000ULL);
+
+  size_t i = 0;
+
+  for(; i + 2<=n; i+=2){
+    __m128i x = _mm_loadu_si128((const __m128i*)(mt + i));
+    x = _mm_xor_si128(x, _mm_and_si128(_mm_srli_epi64(x, 29), c0));
+    x = _mm_xor_si128(x, _mm_and_si128(_mm_slli_epi64(x, 17), c1));
+    x = _mm_xor_si128(x, _mm_and_si128(_mm_slli_epi64(x, 37), c2));
+    x = _mm_xor_si128(x, _mm_srli_epi64(x, 43));
+    _mm_storeu_si128((__m128i*)(p + i), x);
+  } //for
+
+  for(; i<n; i++) //leftovers
+    p[i] = Temper(mt[i]);
+} //TemperSSE2
+
+/// Twist four words at a time with AVX2, as TwistSSE2().
+/// \param mt [IN, OUT] State vector.
+
+TARGET("avx2") static void TwistAVX2(uint64_t* mt){
+  const __m256i um = _mm256_set1_epi64x((long long)UM);
+  const __m256i lm = _mm256_set1_epi64x((long long)LM);
+  const __m256i a = _mm256_set1_epi64x((long long)MATRIX_A);
+  const __m256i one = _mm256_set1_epi64x(1);
+  const __m256i zero = _mm256_setzero_si256();
+
+  int i = 0;
+
+  for(int k=0; k<2; k++){ //first NN - MM words, then the rest but the last
+    const int end = k == 0? NN - MM: NN - 1; //end of batches
+    const int off = k == 0? MM: MM - NN; //offset of word MM places along
+
+    for(; i + 4<=end; i+=4){
+      const __m256i y = _mm256_loadu_si256((const __m256i*)(mt + i));
+      const __m256i z = _mm256_loadu_si256((const __m256i*)(mt + i + 1));
+      const __m256i w = _mm256_loadu_si256((const __m256i*)(mt + i + off));
+
+      const __m256i x = _mm256_or_si256(_mm256_and_si256(y, um),
+        _mm256_and_si256(z, lm));
+      const __m256i mag = _mm256_and_si256(a,
+        _mm256_sub_epi64(zero, _mm256_and_si256(x, one)));
+
+      _mm256_storeu_si256((__m256i*)(mt + i),
+        _mm256_xor_si256(_mm256_xor_si256(w, _mm256_srli_epi64(x, 1)), mag));
+    } //for
+  } //for
+
+  for(; i<NN; i++) //leftovers
+    TwistOne(mt, i, i + (MM - NN));
+} //TwistAVX2
+
+/// Temper four words at a time with AVX2.
+/// \param p [OUT] Output.
+/// \param mt Block of the state vector.
+/// \param n Number of words.
+
+TARGET("avx2") static void TemperAVX2(uint64_t* p, const uint64_t* mt,
+  size_t n)
 {
-    mt[0] = seed;
-    for (mti=1; mti<NN; mti++) 
-        mt[mti] =  (6364136223846793005ULL * (mt[mti-1] ^ (mt[mti-1] >> 62)) + mti);
-}
+  const __m256i c0 = _mm256_set1_epi64x(0x5555555555555555LL);
+  const __m256i c1 = _mm256_set1_epi64x(0x71D67FFFEDA60000LL);
+  const __m256i c2 = _mm256_set1_epi64x((long long)0xFFF7EEE000000000ULL);
 
-/* initialize by an array with array-length */
-/* init_key is the array for initializing keys */
-/* key_length is its length */
-void init_by_array64(uint64_t init_key[],
-		     uint64_t key_length)
-{
+  size_t i = 0;
+
+  for(; i + 4<=n; i+=4){
+    __m256i x = _mm256_loadu_si256((const __m256i*)(mt + i));
+    x = _mm256_xor_si256(x, _mm256_and_si256(_mm256_srli_epi64(x, 29), c0));
+    x = _mm256_xor_si256(x, _mm256_and_si256(_mm256_slli_epi64(x, 17), c1));
+    x = _mm256_xor_si256(x, _mm256_and_si256(_mm256_slli_epi64(x, 37), c2));
+    x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 43));
+    _mm256_storeu_si256((__m256i*)(p + i), x);
+  } //for
+
+  for(; i<n; i++) //leftovers
+    p[i] = Temper(mt[i]);
+} //TemperAVX2
+
+#endif //MT_X86
+
+#pragma endregion kernels
+
+///////////////////////////////////////////////////////////////////////////////
+//CMersenneTwister
+
+#pragma region class
+
+/// Construct and seed.
+/// \param seed Seed.
+
+CMersenneTwister::CMersenneTwister(uint64_t seed){
+  srand(seed);
+} //constructor
+
+/// Initialize the state vector with a seed.
+/// \param seed Seed.
+
+void CMersenneTwister::srand(uint64_t seed){
+  uint64_t* mt = m_nState; //shorthand
+  int mti; //index
+
+  mt[0] = seed;
+  for (mti=1; mti<NN; mti++) 
+    mt[mti] =  (6364136223846793005ULL * (mt[mti-1] ^ (mt[mti-1] >> 62)) + mti);
+
+  m_nIndex = mti;
+} //srand
+
+/// Initialize the state vector with an array of seeds.
+/// \param init_key Array of seeds.
+/// \param key_length Number of seeds in the array.
+
+void CMersenneTwister::srand(const uint64_t init_key[], uint64_t key_length){
+    uint64_t* mt = m_nState; //shorthand
     uint64_t i, j, k;
-    init_genrand64(19650218ULL);
+    srand(19650218ULL);
     i=1; j=0;
     k = (NN>key_length ? NN : key_length);
     for (; k; k--) {
@@ -105,44 +315,92 @@ void init_by_array64(uint64_t init_key[],
     }
 
     mt[0] = 1ULL << 63; /* MSB is 1; assuring non-zero initial array */ 
+} //srand
+
+/// Regenerate the whole state vector using the best kernel for the
+/// instruction set level selected in Kernels.cpp.
+
+void CMersenneTwister::Twist(){
+  #ifdef MT_X86
+    if(GetISA() >= ISA::AVX2)TwistAVX2(m_nState);
+    else if(GetISA() > ISA::Scalar)TwistSSE2(m_nState);
+    else TwistScalar(m_nState);
+  #else
+    TwistScalar(m_nState);
+  #endif
+
+  m_nIndex = 0;
+} //Twist
+
+/// Generate a pseudorandom number on [0, 2^64-1].
+/// \return 64 pseudorandom bits.
+
+uint64_t CMersenneTwister::rand(){
+  if(m_nIndex >= NN)Twist();
+  return Temper(m_nState[m_nIndex++]);
+} //rand
+
+/// Generate a pseudorandom number on [0, 2^64-1].
+/// \return 64 pseudorandom bits.
+
+uint64_t CMersenneTwister::operator()(){
+  return rand();
+} //operator()
+
+/// Generate many pseudorandom numbers, tempering whole runs of the state
+/// vector at a time. The output is the same as that of n calls to rand().
+/// \param p [OUT] Output buffer of at least n words.
+/// \param n Number of words to generate.
+
+void CMersenneTwister::fill(uint64_t* p, size_t n){
+  while(n > 0){
+    if(m_nIndex >= NN)Twist();
+
+    const size_t m = std::min(n, size_t(NN - m_nIndex)); //words in this run
+    const uint64_t* mt = m_nState + m_nIndex; //start of run
+
+    #ifdef MT_X86
+      if(GetISA() >= ISA::AVX2)TemperAVX2(p, mt, m);
+      else if(GetISA() > ISA::Scalar)TemperSSE2(p, mt, m);
+      else TemperScalar(p, mt, m);
+    #else
+      TemperScalar(p, mt, m);
+    #endif
+
+    m_nIndex += (int)m;
+    p += m;
+    n -= m;
+  } //while
+} //fill
+
+#pragma endregion class
+
+///////////////////////////////////////////////////////////////////////////////
+//The reference interface, using a single global instance
+
+#pragma region reference
+
+static CMersenneTwister g_cMT; ///< Instance used by the reference interface.
+
+/* initializes mt[NN] with a seed */
+void init_genrand64(uint64_t seed)
+{
+    g_cMT.srand(seed);
+}
+
+/* initialize by an array with array-length */
+/* init_key is the array for initializing keys */
+/* key_length is its length */
+void init_by_array64(uint64_t init_key[],
+		     uint64_t key_length)
+{
+    g_cMT.srand(init_key, key_length);
 }
 
 /* generates a random number on [0, 2^64-1]-interval */
 uint64_t genrand64_int64(void)
 {
-    int i;
-    uint64_t x;
-    static uint64_t mag01[2]={0ULL, MATRIX_A};
-
-    if (mti >= NN) { /* generate NN words at one time */
-
-        /* if init_genrand64() has not been called, */
-        /* a default initial seed is used     */
-        if (mti == NN+1) 
-            init_genrand64(5489ULL); 
-
-        for (i=0;i<NN-MM;i++) {
-            x = (mt[i]&UM)|(mt[i+1]&LM);
-            mt[i] = mt[i+MM] ^ (x>>1) ^ mag01[(int)(x&1ULL)];
-        }
-        for (;i<NN-1;i++) {
-            x = (mt[i]&UM)|(mt[i+1]&LM);
-            mt[i] = mt[i+(MM-NN)] ^ (x>>1) ^ mag01[(int)(x&1ULL)];
-        }
-        x = (mt[NN-1]&UM)|(mt[0]&LM);
-        mt[NN-1] = mt[MM-1] ^ (x>>1) ^ mag01[(int)(x&1ULL)];
-
-        mti = 0;
-    }
-  
-    x = mt[mti++];
-
-    x ^= (x >> 29) & 0x5555555555555555ULL;
-    x ^= (x << 17) & 0x71D67FFFEDA60000ULL;
-    x ^= (x << 37) & 0xFFF7EEE000000000ULL;
-    x ^= (x >> 43);
-
-    return x;
+    return g_cMT.rand();
 }
 
 /* generates a random number on [0, 2^63-1]-interval */
@@ -169,7 +427,12 @@ double genrand64_real3(void)
     return ((genrand64_int64() >> 12) + 0.5) * (1.0/4503599627370496.0);
 }
 
-// I don't need their main() so I commented it out. Everything above this line is unchanged. IP
+#pragma endregion reference
+
+// I don't need their main() so I commented it out. IP
+// The reference generator above has since been rewritten as the class
+// CMersenneTwister, with vectorized twist and temper, and the reference
+// functions are now wrappers around a static instance. Their output is unchanged.
 //
 //int main(void)
 //{
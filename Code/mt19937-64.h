@@ -0,0 +1,39 @@
+/// \file mt19937-64.h
+/// \brief Declaration of the 64-bit Mersenne Twister CMersenneTwister.
+
+#ifndef __mt19937_64__
+#define __mt19937_64__
+
+#include <cinttypes>
+#include <cstddef>
+
+/// \brief The 64-bit Mersenne Twister MT19937-64.
+///
+/// An instantiable version of Nishimura and Matsumoto's MT19937-64 that is
+/// bit-identical to their reference code. Each instance has its own state,
+/// so instances may be used concurrently by different threads. The state is
+/// regenerated 312 words at a time in SIMD batches where the CPU allows it,
+/// and fill() also tempers its output in SIMD batches.
+
+class CMersenneTwister{
+  private:
+    static const int m_nN = 312; ///< Number of words of state.
+
+    uint64_t m_nState[m_nN]; ///< State vector.
+    int m_nIndex = 0; ///< Index of next word of state.
+
+    void Twist(); ///< Regenerate the state vector.
+
+  public:
+    CMersenneTwister(uint64_t seed=5489); ///< Constructor.
+
+    void srand(uint64_t seed); ///< Seed from a word.
+    void srand(const uint64_t key[], uint64_t n); ///< Seed from an array.
+
+    uint64_t rand(); ///< Generate 64 pseudorandom bits.
+    void fill(uint64_t* p, size_t n); ///< Generate many pseudorandom words.
+
+    uint64_t operator()(); ///< Generate 64 pseudorandom bits.
+}; //CMersenneTwister
+
+#endif
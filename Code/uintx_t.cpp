@@ -4,11 +4,60 @@
 #include "uintx_t.h"
 
 #include "Includes.h"
+#include "Metrics.h"
 
 const int HalfBytesInWord = 2*sizeof(uint32_t); ///< Number of nibbles in a word.
 const int BitsInHalfByte = 4; ///< Number of bits in a nibble.
 const int BitsInWord = 8*sizeof(uint32_t); ///< Number of bits in a word
 
+#if defined(__x86_64__) || defined(_M_X64) //x86-64
+  #define UINTX_CARRY ///< Define to use the add-with-carry intrinsics.
+
+  #ifdef _MSC_VER //Windows Visual Studio
+    #include <intrin.h>
+  #else //gcc and clang
+    #include <x86intrin.h>
+  #endif
+#endif
+
+/// Add two words and a carry.
+/// \param c Carry in, 0 or 1.
+/// \param x A word.
+/// \param y A word.
+/// \param sum [OUT] Least significant word of x + y + c.
+/// \return Carry out, 0 or 1.
+
+static inline uint8_t AddCarry(uint8_t c, uint32_t x, uint32_t y,
+  uint32_t* sum)
+{
+  #ifdef UINTX_CARRY
+    return _addcarry_u32(c, x, y, (unsigned int*)sum);
+  #else //portable
+    const uint64_t s = uint64_t(x) + y + c; //two-word sum
+    *sum = uint32_t(s);
+    return uint8_t(s >> BitsInWord);
+  #endif
+} //AddCarry
+
+/// Subtract a word and a borrow from a word.
+/// \param b Borrow in, 0 or 1.
+/// \param x A word.
+/// \param y A word.
+/// \param diff [OUT] Least significant word of x - y - b.
+/// \return Borrow out, 0 or 1.
+
+static inline uint8_t SubBorrow(uint8_t b, uint32_t x, uint32_t y,
+  uint32_t* diff)
+{
+  #ifdef UINTX_CARRY
+    return _subborrow_u32(b, x, y, (unsigned int*)diff);
+  #else //portable
+    const uint64_t d = uint64_t(x) - y - b; //two-word difference
+    *diff = uint32_t(d);
+    return uint8_t(d >> (2*BitsInWord - 1));
+  #endif
+} //SubBorrow
+
 /////////////////////////////////////////////////////////////////////////////
 //Constructors and destructors.
 
@@ -16,47 +65,47 @@ const int BitsInWord = 8*sizeof(uint32_t); ///< Number of bits in a word
 
 /// Void constructor.
 
-uintx_t::uintx_t():m_nSize(0), m_pData(nullptr){ 
+uintx_t::uintx_t():
+  m_pData(m_nInlineData), m_nSize(0), m_nCapacity(m_nInline){ 
 } //void constructor
 
 /// Integer constructor.
 /// \param i Initial value.
 
-uintx_t::uintx_t(int i): m_nSize(1){ 
-  m_pData = new uint32_t[1]; 
+uintx_t::uintx_t(int i):
+  m_pData(m_nInlineData), m_nSize(1), m_nCapacity(m_nInline){ 
   m_pData[0] = i;
 } //integer constructor
 
 /// String constructor.
 /// \param string String containing initial value in hexadecimal.
 
-uintx_t::uintx_t(const char *string){ 
+uintx_t::uintx_t(const char *string): uintx_t(){ 
   const int n = strlen(string);
-  m_nSize = (int)std::ceil((double)n/HalfBytesInWord);
-  m_pData = new uint32_t[m_nSize]; //grab space
-
-  for(int i=0; i<m_nSize; i++)
-    m_pData[i] = 0; //clear m_pData
-
+  reallocate((int)std::ceil((double)n/HalfBytesInWord)); //grab space
   loadstring(string); //load string
+  normalize(); //remove leading zeros
 } //string constructor
 
 /// Copy constructor.
 /// \param x Extensible unsigned integer to be copied.
-/// \return Reference to this extensible unsigned integer after copying.
-
-uintx_t::uintx_t(const uintx_t& x){ 
-  m_nSize = x.m_nSize;
-  m_pData = new uint32_t[m_nSize]; //grab space
 
-  for(int i=0; i<m_nSize; i++)
-    m_pData[i] = x.m_pData[i]; //load m_pData
+uintx_t::uintx_t(const uintx_t& x): uintx_t(){ 
+  *this = x;
 } //copy constructor
 
+/// Move constructor. Heap storage is taken over rather than copied.
+/// \param x Extensible unsigned integer to be moved, left equal to zero.
+
+uintx_t::uintx_t(uintx_t&& x) noexcept: uintx_t(){ 
+  *this = std::move(x);
+} //move constructor
+
 /// Destructor.
 
 uintx_t::~uintx_t(){ 
-  delete [] m_pData; 
+  if(m_pData != m_nInlineData)
+    delete [] m_pData; 
 } //destructor
 
 #pragma endregion structors
@@ -101,74 +150,72 @@ std::string uintx_t::GetString() const{
   return s;
 } //GetString
 
-/// Change the number of words allocated and zero out the value stored.
-/// \param s Number of words to allocate.
+/// Make sure that there is space for a number of words while keeping the
+/// value stored. The heap is used only if there is not enough inline storage.
+/// \param s Number of words to make space for.
 
-void uintx_t::reallocate(const int s){ 
-  if(m_nSize != s){ //if change needed
-    m_nSize = s; 
-    delete [] m_pData; 
-    m_pData = new uint32_t[s]; //get space
+void uintx_t::reserve(const int s){
+  if(s > m_nCapacity){ //if really an increase in capacity
+    uint32_t* p = new uint32_t[s]; //grab new space
+    METRIC_ADD(UintxAllocs, 1);
 
     for(int i=0; i<m_nSize; i++)
-      m_pData[i] = 0; //zero it out
+      p[i] = m_pData[i]; //copy over old digits
+
+    if(m_pData != m_nInlineData)
+      delete [] m_pData; //recycle old space
+
+    m_pData = p;
+    m_nCapacity = s;
   } //if
+} //reserve
+
+/// Change the number of words used and zero out the value stored.
+/// \param s Number of words to use.
+
+void uintx_t::reallocate(const int s){ 
+  m_nSize = 0; //nothing worth keeping
+  reserve(s);
+  m_nSize = s; 
+
+  for(int i=0; i<m_nSize; i++)
+    m_pData[i] = 0; //zero it out
 } //reallocate
 
 /// Increase the amount of space allocated while keeping the value stored.
 /// \param s Number of words to increase to.
 
 void uintx_t::grow(const int s){
-  uint32_t* olddata = m_pData; //old m_pData
-  int oldsize = m_nSize; //old m_nSize
-
   if(m_nSize <= s){ //if really an increase in m_nSize
-    m_pData = new uint32_t[s]; //grab new space
-    m_nSize = s; 
-    
-    int i; 
+    reserve(s);
 
-    for(i=0; i<oldsize; i++)
-      m_pData[i] = olddata[i]; //copy over old digits
-
-    for(; i<m_nSize; i++)
+    for(int i=m_nSize; i<s; i++)
       m_pData[i] = 0; //zero out the rest
 
-    delete [] olddata; //recycle old space
+    m_nSize = s; 
   } //if
 } //grow
 
 /// \return Least significant 32-bit unsigned integer.
 
-uintx_t::operator uint32_t(){
+uintx_t::operator uint32_t() const{
   return m_pData[0];
 } //uint32_t
 
 /// Construct a 64-bit unsigned integer from the two least-significant words.
 /// \return Least significant 64-bit unsigned integer.
 
-uintx_t::operator uint64_t(){
-  return (uint64_t(m_pData[1]) << 32) | m_pData[0];
+uintx_t::operator uint64_t() const{
+  const uint64_t hi = m_nSize > 1? m_pData[1]: 0; //most significant word
+
+  return (hi << 32) | m_pData[0];
 } //uint64_t
 
-/// Minimize the amount of storage by removing the leading zero words
-/// and reallocating a smaller amount of space if possible.
+/// Remove the leading zero words. The space is kept for later use.
 
 void uintx_t::normalize(){
-  uint32_t* olddata = m_pData; //old m_pData
-  int top;
-
-  for(top=m_nSize - 1; top>0 && m_pData[top]==0; top--);
-
-  if(top < m_nSize - 1){ //if really a change in m_nSize
-    m_nSize = top + 1; 
-    m_pData = new uint32_t[m_nSize]; //grab new space
-
-    for(int i=0; i<=top; i++)
-      m_pData[i] = olddata[i]; //copy over old digits
-
-    delete [] olddata; //recycle old space
-  } //if
+  while(m_nSize > 1 && m_pData[m_nSize - 1] == 0)
+    m_nSize--;
 } //normalize
 
 /// Set the value stored to a hex value.
@@ -219,7 +266,7 @@ void uintx_t::loadstring(const char* string){
 /// Compute the number of significant bits in the value stored.
 /// \return the number of bits stored.
 
-int uintx_t::bitcount(){
+int uintx_t::bitcount() const{
   if(m_nSize <= 0)return 0;
 
   uint32_t word = m_pData[m_nSize - 1]; //most significant word in x
@@ -246,7 +293,10 @@ int uintx_t::bitcount(){
 
 uintx_t& uintx_t::operator=(const uintx_t& x){ 
   if(this != &x){ //protect against self assignment
-    reallocate(x.m_nSize); //grab enough space
+    m_nSize = 0; //nothing worth keeping
+    reserve(x.m_nSize); //grab enough space
+    m_nSize = x.m_nSize;
+
     for(int i=0; i<m_nSize; i++) //copy over data
       m_pData[i] = x.m_pData[i];
   } //if
@@ -254,6 +304,35 @@ uintx_t& uintx_t::operator=(const uintx_t& x){
   return *this;
 } //operator=
 
+/// Move a extensible unsigned integer. Heap storage is taken over rather
+/// than copied, and inline storage is copied without touching the heap.
+/// \param x Extensible unsigned integer to be moved, left equal to zero.
+/// \return Reference to this extensible unsigned integer after moving.
+
+uintx_t& uintx_t::operator=(uintx_t&& x) noexcept{ 
+  if(this != &x){ //protect against self assignment
+    if(x.m_pData == x.m_nInlineData) //fits in our space, no allocation
+      *this = (const uintx_t&)x;
+
+    else{ //take over x's heap storage
+      if(m_pData != m_nInlineData)
+        delete [] m_pData;
+
+      m_pData = x.m_pData;
+      m_nSize = x.m_nSize;
+      m_nCapacity = x.m_nCapacity;
+
+      x.m_pData = x.m_nInlineData;
+      x.m_nCapacity = m_nInline;
+    } //else
+
+    x.m_nSize = 1; //leave x equal to zero
+    x.m_pData[0] = 0;
+  } //if
+
+  return *this;
+} //operator=
+
 /// Assign an integer.
 /// \param i Integer to be copied.
 /// \return Reference to this extensible unsigned integer after copying.
@@ -272,6 +351,7 @@ uintx_t& uintx_t::operator=(const char* s){
   const int n = (int)ceil((double)strlen(s)/HalfBytesInWord);
   reallocate(n);
   loadstring(s);
+  normalize();
   return *this;
 } //operator=
 
@@ -287,68 +367,59 @@ uintx_t& uintx_t::operator=(const char* s){
 /// \param y A extensible unsigned integer.
 /// \return x + y.
 
-uintx_t operator+(uintx_t x, uintx_t y){
-  return x += y;
+uintx_t operator+(uintx_t x, const uintx_t& y){
+  return std::move(x += y);
 } //operator+
 
+/// Add a word in place.
+/// \param y A word.
+
+void uintx_t::addword(uint32_t y){
+  uint8_t carry = 0; //carry
+  int i = 0; //looping variable
+
+  if(m_nSize == 0)grow(1); //safety
+
+  carry = AddCarry(0, m_pData[0], y, &m_pData[0]);
+
+  for(i=1; carry && i<m_nSize; i++) //propagate carry
+    carry = AddCarry(carry, m_pData[i], 0, &m_pData[i]);
+
+  if(carry){ //carry of 1 fell out, need more space for result
+    grow(m_nSize + 1); //need one more place for carry
+    m_pData[m_nSize - 1] = 1; //set most significant digit
+  } //if
+} //addword
+
 /// Add an integer.
 /// \param y An integer.
 /// \return Reference to this extensible unsigned integer after y has been added.
 
 uintx_t& uintx_t::operator+=(const int& y){
-  (*this) += uintx_t(y);
+  addword(uint32_t(y));
   return *this;
 } //operator+=
 
-/// Add a extensible unsigned integer.
+/// Add a extensible unsigned integer in place, one word at a time with
+/// the add-with-carry instruction where available.
 /// \param y A extensible unsigned integer.
 /// \return Reference to this extensible unsigned integer after y has been added.
 
 uintx_t& uintx_t::operator+=(const uintx_t& y){ 
-  uint32_t left, right, left_msb, right_msb; //operands and their msb's
-  uint32_t sum, sum_msb; //sum and its msb
-  uint32_t carry = 0; //single-bit carry
-
-  const uint32_t mask_msb = 1 << (BitsInWord-1); //mask for most significant bit
-  const uint32_t mask_lsb = ~mask_msb; //mask for all but most significant bit
-
+  const int n = y.m_nSize; //number of words in y, before any growth
+  uint8_t carry = 0; //single-bit carry
   int i; //looping variable
-  int oldsize = m_nSize;
-
-  grow(m_nSize > y.m_nSize? m_nSize: y.m_nSize); //make enough space for result
-
-  for(i=0; i<m_nSize; i++){ //for each word in the result
-    //grab a word from each operand
-    left = i < oldsize? m_pData[i]: 0;
-    right = i < y.m_nSize? y.m_pData[i]: 0;
-
-    //extract the most significant bit (msb) from each
-    left_msb = (left & mask_msb) >> (BitsInWord - 1);
-    right_msb = (right & mask_msb) >> (BitsInWord - 1);
 
-    //zero out the msb from each
-    left = left & mask_lsb;
-    right = right & mask_lsb;
+  if(m_nSize < n)
+    grow(n); //make enough space for result
 
-    //add them
-    sum = left + right + carry;
+  for(i=0; i<n; i++) //for each word of y
+    carry = AddCarry(carry, m_pData[i], y.m_pData[i], &m_pData[i]);
 
-    //compute carry
-    sum_msb = (sum & mask_msb) >> (BitsInWord - 1);
-    sum = sum & mask_lsb;
-    carry = left_msb + right_msb + sum_msb; //carry is either 0, 1, 2, or 3 here
-
-    //put leading bit of carry back into sum
-    if((carry == 1) || (carry == 3))
-      sum = sum | mask_msb;
-
-    m_pData[i] = sum;
-
-    //pass along leading bit of carry
-    carry >>= 1;
-  } //for
+  for(; carry && i<m_nSize; i++) //propagate carry
+    carry = AddCarry(carry, m_pData[i], 0, &m_pData[i]);
 
-  if(carry >= 1){ //carry of 1 fell out, need more space for result
+  if(carry){ //carry of 1 fell out, need more space for result
     grow(m_nSize + 1); //need one more place for carry
     m_pData[m_nSize - 1] = 1; //set most significant digit
   } //if
@@ -363,21 +434,49 @@ uintx_t& uintx_t::operator+=(const uintx_t& y){
 
 #pragma region comparison
 
-/// Greater than test for two extensible unsigned integers.
+/// Three-way comparison of two extensible unsigned integers. Leading zero
+/// words are ignored.
 /// \param x A extensible unsigned integer.
 /// \param y A extensible unsigned integer.
-/// \return true If x is greater than y.
+/// \return -1, 0, or 1 if x is less than, equal to, or greater than y.
 
-bool operator>(uintx_t x, uintx_t y){ 
-  if(x.m_nSize > y.m_nSize)return true; //x>y
-  if(x.m_nSize < y.m_nSize)return false; //x<y
+int compare(const uintx_t& x, const uintx_t& y){
+  int m = x.m_nSize; //number of significant words in x
+  while(m > 0 && x.m_pData[m - 1] == 0)m--;
 
-  //check m_pData
-  for(int i=x.m_nSize-1; i>=0; i--)
-    if(x.m_pData[i] > y.m_pData[i])return true; //x>y
-    else if(x.m_pData[i] < y.m_pData[i])return false; //x<y
+  int n = y.m_nSize; //number of significant words in y
+  while(n > 0 && y.m_pData[n - 1] == 0)n--;
 
-  return false; //they're equal
+  if(m != n)return m > n? 1: -1;
+
+  for(int i=m - 1; i>=0; i--) //check m_pData
+    if(x.m_pData[i] != y.m_pData[i])
+      return x.m_pData[i] > y.m_pData[i]? 1: -1;
+
+  return 0; //they're equal
+} //compare
+
+/// Three-way comparison of a extensible unsigned integer and a word.
+/// \param x A extensible unsigned integer.
+/// \param y An unsigned integer.
+/// \return -1, 0, or 1 if x is less than, equal to, or greater than y.
+
+int compare(const uintx_t& x, uint32_t y){
+  for(int i=x.m_nSize - 1; i>0; i--)
+    if(x.m_pData[i] != 0)return 1; //x has more than one significant word
+
+  const uint32_t x0 = x.m_nSize > 0? x.m_pData[0]: 0; //least significant word
+
+  return x0 == y? 0: (x0 > y? 1: -1);
+} //compare
+
+/// Greater than test for two extensible unsigned integers.
+/// \param x A extensible unsigned integer.
+/// \param y A extensible unsigned integer.
+/// \return true If x is greater than y.
+
+bool operator>(const uintx_t& x, const uintx_t& y){ 
+  return compare(x, y) > 0;
 } //operator>
 
 /// Greater than test for a extensible unsigned integer and an integer.
@@ -385,8 +484,8 @@ bool operator>(uintx_t x, uintx_t y){
 /// \param y An integer.
 /// \return true If x is greater than y.
 
-bool operator>(uintx_t x, int y){ 
-  return x > uintx_t(y); //lazy way to do it
+bool operator>(const uintx_t& x, int y){ 
+  return compare(x, uint32_t(y)) > 0;
 } //operator>
 
 /// Greater than or equal to test for two extensible unsigned integers.
@@ -394,16 +493,8 @@ bool operator>(uintx_t x, int y){
 /// \param y A extensible unsigned integer.
 /// \return true If x is greater than or equal to y.
 
-bool operator>=(uintx_t x, uintx_t y){ 
-  if(x.m_nSize > y.m_nSize)return true; //x>y
-  if(x.m_nSize < y.m_nSize)return false; //x<y
-
-  //check m_pData
-  for(int i=x.m_nSize-1; i>=0; i--)
-    if(x.m_pData[i] >y .m_pData[i])return true; //x>y
-    else if(x.m_pData[i] < y.m_pData[i])return false; //x<y
-
-  return true; //they're equal
+bool operator>=(const uintx_t& x, const uintx_t& y){ 
+  return compare(x, y) >= 0;
 } //operator>=
 
 /// Greater than or equal to test for a extensible unsigned integer and
@@ -412,8 +503,8 @@ bool operator>=(uintx_t x, uintx_t y){
 /// \param y An integer.
 /// \return true If x is greater than or equal to y.
 
-bool operator>=(uintx_t x, int y){ 
-  return x >= uintx_t(y); //lazy way to do it
+bool operator>=(const uintx_t& x, int y){ 
+  return compare(x, uint32_t(y)) >= 0;
 } //operator>=
 
 /// Less than test for two extensible unsigned integers.
@@ -421,8 +512,8 @@ bool operator>=(uintx_t x, int y){
 /// \param y A extensible unsigned integer.
 /// \return true If x is less than y.
 
-bool operator<(uintx_t x, uintx_t y){ 
-  return y > x; //lazy again
+bool operator<(const uintx_t& x, const uintx_t& y){ 
+  return compare(x, y) < 0;
 } //operator<
 
 /// Less than test for a extensible unsigned integer and an integer.
@@ -430,8 +521,8 @@ bool operator<(uintx_t x, uintx_t y){
 /// \param y An integer.
 /// \return true If x is less than y.
 
-bool operator<(uintx_t x, int y){ 
-  return x < uintx_t(y); //lazy way to do it
+bool operator<(const uintx_t& x, int y){ 
+  return compare(x, uint32_t(y)) < 0;
 } //operator<
 
 /// Less than or equal to test for two extensible unsigned integers.
@@ -439,8 +530,8 @@ bool operator<(uintx_t x, int y){
 /// \param y A extensible unsigned integer.
 /// \return true If x is less than or equal to y.
 
-bool operator<=(uintx_t x, uintx_t y){ 
-  return y >= x; //lazy again
+bool operator<=(const uintx_t& x, const uintx_t& y){ 
+  return compare(x, y) <= 0;
 } //operator<=
 
 /// Less than or equal to test for a extensible unsigned integer and an integer.
@@ -448,8 +539,8 @@ bool operator<=(uintx_t x, uintx_t y){
 /// \param y An integer.
 /// \return true If x is less than or equal to y.
 
-bool operator<=(uintx_t x, int y){ 
-  return x <= uintx_t(y); //lazy way to do it
+bool operator<=(const uintx_t& x, int y){ 
+  return compare(x, uint32_t(y)) <= 0;
 } //operator<=
 
 /// Equality test for two extensible unsigned integers.
@@ -457,16 +548,8 @@ bool operator<=(uintx_t x, int y){
 /// \param y A extensible unsigned integer.
 /// \return true If x is equal to y.
 
-bool operator==(uintx_t x, uintx_t y){ 
-  if(x.m_nSize != y.m_nSize)
-    return false;
-
-  //check m_pData
-  for(int i=x.m_nSize - 1; i>=0; i--)
-    if(x.m_pData[i] != y.m_pData[i])
-      return false;
-
-  return true; //they're equal
+bool operator==(const uintx_t& x, const uintx_t& y){ 
+  return compare(x, y) == 0;
 } //operator==
 
 /// Equality test for a extensible unsigned integer and an unsigned integer.
@@ -474,8 +557,8 @@ bool operator==(uintx_t x, uintx_t y){
 /// \param y An unsigned integer.
 /// \return true If x is equal to y.
 
-bool operator==(uintx_t x, uint32_t y){ 
-  return (x.m_nSize == 1) && (x.m_pData[0] == y);
+bool operator==(const uintx_t& x, uint32_t y){ 
+  return compare(x, y) == 0;
 } //operator==
 
 /// Equality test for an unsigned integer and a extensible unsigned integer.
@@ -483,7 +566,7 @@ bool operator==(uintx_t x, uint32_t y){
 /// \param y A extensible unsigned integer.
 /// \return true If x is equal to y.
 
-bool operator==(uint32_t x, uintx_t y){ 
+bool operator==(uint32_t x, const uintx_t& y){ 
   return y == x;
 } //operator==
 
@@ -492,7 +575,7 @@ bool operator==(uint32_t x, uintx_t y){
 /// \param y A extensible unsigned integer.
 /// \return true If x is not equal to y.
 
-bool operator!=(uintx_t x, uintx_t y){ 
+bool operator!=(const uintx_t& x, const uintx_t& y){ 
   return !(x == y); 
 } //operator!=
 
@@ -501,7 +584,7 @@ bool operator!=(uintx_t x, uintx_t y){
 /// \param y An unsigned integer.
 /// \return true If x is not equal to y.
 
-bool operator!=(uintx_t x, uint32_t y){ 
+bool operator!=(const uintx_t& x, uint32_t y){ 
   return !(x == y); 
 } //operator!=
 
@@ -510,7 +593,7 @@ bool operator!=(uintx_t x, uint32_t y){
 /// \param y A extensible unsigned integer.
 /// \return true If x is not equal to y.
 
-bool operator!=(uint32_t x, uintx_t y){ 
+bool operator!=(uint32_t x, const uintx_t& y){ 
   return !(x == y); 
 } //operator!=
 
@@ -566,7 +649,7 @@ uintx_t& uintx_t::operator<<=(const int distance){
 /// \return x left-shifted by d bits.
 
 uintx_t operator<<(uintx_t x, int d){ 
-  return x <<= d; 
+  return std::move(x <<= d); 
 } //operator<<
 
 /// Right-shift this.
@@ -574,37 +657,23 @@ uintx_t operator<<(uintx_t x, int d){
 /// \return Reference to this extensible unsigned integer after right-shifting.
 
 uintx_t& uintx_t::operator>>=(const int distance){ 
-  //find new size
-  int newsize = (this->bitcount() - distance + BitsInWord - 1)/BitsInWord;
+  const int words = distance/BitsInWord; //shift distance in words
+  const int d = distance%BitsInWord; //shift distance within words
 
-  if(newsize<1)
-    *this = 0;
+  if(words >= m_nSize) //everything shifted out
+    return *this = 0;
 
-  else{
-    //shift by word
-    int dest = 0; //copy destination
-    int src = dest + distance/BitsInWord; //copy source
-    if(dest != src)
-      while(src < m_nSize){ //until end of source
-        m_pData[dest] = m_pData[src]; //copy
-        m_pData[src] = 0; //zero out copied word
-        dest++; src++; //move along
-      } //whilke
+  const int newsize = m_nSize - words; //number of words remaining
 
-    //shift within words
-    const int d = distance%BitsInWord; //shift distance within words
-    if(d > 0)
-      for(dest=0; dest<newsize; dest++){
-        m_pData[dest] >>= d;
-        if(dest < m_nSize - 1)
-          m_pData[dest] = m_pData[dest] | (m_pData[dest + 1] << (BitsInWord - d));
-      } //for
-  } //else
+  for(int dest=0; dest<newsize; dest++){ //sources are never behind dest
+    m_pData[dest] = m_pData[dest + words] >> d;
 
-  for(int i=newsize; i<m_nSize; i++)
-    m_pData[i] = 0; //zero out unused portion
+    if(d > 0 && dest + words + 1 < m_nSize)
+      m_pData[dest] |= m_pData[dest + words + 1] << (BitsInWord - d);
+  } //for
 
-  this->normalize(); //remove leading zero words
+  m_nSize = newsize;
+  normalize(); //remove leading zero words
 
   return *this;
 } //operator>>=
@@ -615,7 +684,7 @@ uintx_t& uintx_t::operator>>=(const int distance){
 /// \return x right-shifted by d bits.
 
 uintx_t operator>>(uintx_t x, int d){ 
-  return x >>= d; 
+  return std::move(x >>= d); 
 } //operator>>
 
 #pragma endregion shift
@@ -636,15 +705,18 @@ uintx_t operator&(uintx_t x, const uintx_t& y){
   for(int i=0; i<n; i++)
     x.m_pData[i] &= y.m_pData[i];
 
+  x.m_nSize = n; //words of x beyond the end of y are ANDed with zero
+  x.normalize();
+
   return x;
-} //operator|
+} //operator&
 
 /// Logical AND of a extensible unsigned integer and an integer.
 /// \param x A extensible unsigned integer.
 /// \param y A word.
 /// \return The most significant word of x ANDed with y.
 
-int operator&(uintx_t x, int y){
+int operator&(const uintx_t& x, int y){
   return x.m_pData[0] & y;
 } //operator&
 
@@ -654,9 +726,9 @@ int operator&(uintx_t x, int y){
 /// \return x ORed with y.
 
 uintx_t operator|(uintx_t x, const uintx_t& y){
-  const int n = std::min(x.m_nSize, y.m_nSize);
+  x.grow(y.m_nSize); //words of y beyond the end of x are ORed with zero
 
-  for(int i=0; i<n; i++)
+  for(int i=0; i<y.m_nSize; i++)
     x.m_pData[i] |= y.m_pData[i];
 
   return x;
@@ -667,7 +739,7 @@ uintx_t operator|(uintx_t x, const uintx_t& y){
 /// \param y A word.
 /// \return The most significant word of x ORed with y.
 
-int operator|(uintx_t x, int y){
+int operator|(const uintx_t& x, int y){
   return x.m_pData[0] | y;
 } //operator|
 
@@ -678,44 +750,267 @@ int operator|(uintx_t x, int y){
 
 #pragma region multiplication
 
+/// Add an array of words into another in place.
+/// \param r [IN, OUT] Array of words, least significant first.
+/// \param rn Number of words in r.
+/// \param a Array of words to be added to r, least significant first.
+/// \param n Number of words in a, at most rn.
+/// \return Carry out of the most significant word of r.
+
+static uint8_t AddWords(uint32_t* r, int rn, const uint32_t* a, int n){
+  uint8_t carry = 0; //carry
+  int i; //looping variable
+
+  for(i=0; i<n; i++)
+    carry = AddCarry(carry, r[i], a[i], &r[i]);
+
+  for(; carry && i<rn; i++) //propagate carry
+    carry = AddCarry(carry, r[i], 0, &r[i]);
+
+  return carry;
+} //AddWords
+
+/// Subtract an array of words from another in place.
+/// \param r [IN, OUT] Array of words, least significant first.
+/// \param rn Number of words in r.
+/// \param a Array of words to be subtracted from r, least significant first.
+/// \param n Number of words in a, at most rn.
+/// \return Borrow out of the most significant word of r.
+
+static uint8_t SubWords(uint32_t* r, int rn, const uint32_t* a, int n){
+  uint8_t borrow = 0; //borrow
+  int i; //looping variable
+
+  for(i=0; i<n; i++)
+    borrow = SubBorrow(borrow, r[i], a[i], &r[i]);
+
+  for(; borrow && i<rn; i++) //propagate borrow
+    borrow = SubBorrow(borrow, r[i], 0, &r[i]);
+
+  return borrow;
+} //SubWords
+
+/// Multiply two arrays of words by Comba's method, that is, schoolbook
+/// multiplication done one column of the result at a time. The products in
+/// each column are summed in a three-word accumulator, so each word of the
+/// result is written exactly once and no carries need to be rippled.
+/// \param r [OUT] Array of m + n words for the product, not overlapping a or b.
+/// \param a Array of m words, least significant first.
+/// \param m Number of words in a, at least 1.
+/// \param b Array of n words, least significant first.
+/// \param n Number of words in b, at least 1.
+
+static void MulComba(uint32_t* r, const uint32_t* a, int m, 
+  const uint32_t* b, int n)
+{
+  uint64_t lo = 0; //least significant two words of accumulator
+  uint32_t hi = 0; //most significant word of accumulator
+
+  for(int k=0; k<m + n - 1; k++){ //for each column
+    const int i0 = std::max(0, k - n + 1); //first index into a
+    const int i1 = std::min(k, m - 1); //last index into a
+
+    for(int i=i0; i<=i1; i++){
+      const uint64_t p = uint64_t(a[i])*b[k - i]; //two-word product
+      lo += p;
+      hi += lo < p; //carry into the top word
+    } //for
+
+    r[k] = uint32_t(lo);
+    lo = (lo >> BitsInWord) | (uint64_t(hi) << BitsInWord); //next column
+    hi = 0;
+  } //for
+
+  r[m + n - 1] = uint32_t(lo);
+} //MulComba
+
+/// Number of words in the shorter operand below which multiplication uses
+/// Comba's method instead of Karatsuba's. Found by timing on x86-64.
+
+static const int KaratsubaThreshold = 48;
+
+/// Multiply two arrays of words. Small operands use Comba's method and large
+/// ones use Karatsuba's, which replaces four half-size multiplications by
+/// three. Operands of very different lengths are multiplied a slice of the
+/// longer one at a time.
+/// \param r [OUT] Array of m + n words for the product, not overlapping a or b.
+/// \param a Array of m words, least significant first.
+/// \param m Number of words in a, at least 1.
+/// \param b Array of n words, least significant first.
+/// \param n Number of words in b, at least 1.
+
+static void MulWords(uint32_t* r, const uint32_t* a, int m, 
+  const uint32_t* b, int n)
+{
+  if(m < n){ //make a the longer operand
+    std::swap(a, b);
+    std::swap(m, n);
+  } //if
+
+  if(n < KaratsubaThreshold) //small
+    MulComba(r, a, m, b, n);
+
+  else if(m >= 2*n){ //unbalanced, multiply by slices of a
+    std::vector<uint32_t> t(2*n); //product of a slice of a and b
+
+    std::fill(r, r + m + n, 0);
+
+    for(int i=0; i<m; i+=n){ //for each slice of a
+      const int k = std::min(n, m - i); //length of slice
+      MulWords(t.data(), a + i, k, b, n);
+      AddWords(r + i, m + n - i, t.data(), k + n);
+    } //for
+  } //else if
+
+  else{ //Karatsuba
+    const int h = (m + 1)/2; //split point, n >= h since 2n > m
+    const uint32_t* a0 = a; const uint32_t* a1 = a + h; //halves of a
+    const uint32_t* b0 = b; const uint32_t* b1 = b + h; //halves of b
+
+    std::vector<uint32_t> sa(h + 1, 0), sb(h + 1, 0); //a0 + a1 and b0 + b1
+    std::vector<uint32_t> z1(2*h + 2); //middle product
+
+    std::copy(a0, a0 + h, sa.begin());
+    sa[h] = AddWords(sa.data(), h, a1, m - h);
+    std::copy(b0, b0 + h, sb.begin());
+    sb[h] = AddWords(sb.data(), h, b1, n - h);
+
+    MulWords(r, a0, h, b0, h); //a0*b0 in the bottom 2h words
+
+    if(n > h) //a1*b1 in the top m + n - 2h words
+      MulWords(r + 2*h, a1, m - h, b1, n - h);
+    else std::fill(r + 2*h, r + m + n, 0);
+
+    MulWords(z1.data(), sa.data(), h + 1, sb.data(), h + 1);
+    SubWords(z1.data(), 2*h + 2, r, 2*h); //subtract a0*b0
+    SubWords(z1.data(), 2*h + 2, r + 2*h, m + n - 2*h); //subtract a1*b1
+
+    int len = 2*h + 2; //length of z1 = a0*b1 + a1*b0 without leading zeros
+    while(len > 0 && z1[len - 1] == 0)len--;
+
+    AddWords(r + h, m + n - h, z1.data(), len);
+  } //else
+} //MulWords
+
 /// Multiply two extensible unsigned integers.
 /// \param y A extensible unsigned integer.
 /// \param z A extensible unsigned integer
 /// \return y multiplied by z.
 
-uintx_t operator*(uintx_t y, uintx_t z){ 
+uintx_t operator*(const uintx_t& y, const uintx_t& z){ 
   uintx_t result(0); //place for returned result
 
-  while(z > 0){
-    result += y * z.m_pData[0];
-    y <<= BitsInWord;
-    z >>= BitsInWord;
-  } //while
+  if(y.m_nSize > 0 && z.m_nSize > 0){
+    result.reallocate(y.m_nSize + z.m_nSize);
+    MulWords(result.m_pData, y.m_pData, y.m_nSize, z.m_pData, z.m_nSize);
+    result.normalize();
+  } //if
 
   return result;
 } //operator*
 
-/// Multiply a extensible unsigned integer by an integer.
-/// \param x A extensible unsigned integer.
-/// \param y An integer.
-/// \return x multiplied by y.
+/// Fused multiply-add, that is, add the product of two extensible unsigned
+/// integers to a third without building the product separately, unless it
+/// is large enough for Karatsuba's method to pay off.
+/// \param x [IN, OUT] A extensible unsigned integer, replaced by x + a*b.
+/// \param a A extensible unsigned integer.
+/// \param b A extensible unsigned integer.
 
-uintx_t operator*(uintx_t x, int y){ 
-  uintx_t word, carry(0);
+void muladd(uintx_t& x, const uintx_t& a, const uintx_t& b){
+  const int m = a.m_nSize; //number of words in a
+  const int n = b.m_nSize; //number of words in b
 
-  word.grow(x.m_nSize);
-  carry.grow(x.m_nSize + 1);
+  if(m == 0 || n == 0)return; //nothing to add
 
-  for(int i=0; i<x.m_nSize; i++){
-    uint64_t prod = (uint64_t)x.m_pData[i]*(uint64_t)y;
-    word.m_pData[i] = unsigned(prod & 0xFFFFFFFF);
-    carry.m_pData[i + 1] = unsigned(prod >> 32);
+  if(&x == &a || &x == &b || std::min(m, n) >= KaratsubaThreshold){
+    x += a*b; //aliased or large
+    return;
+  } //if
+
+  x.grow(std::max(x.m_nSize, m + n) + 1); //room for the sum
+
+  for(int j=0; j<n; j++){ //add a*b[j] into x, one row at a time
+    const uint64_t bj = b.m_pData[j]; //current word of b
+    uint64_t carry = 0; //carry word
+
+    for(int i=0; i<m; i++){
+      const uint64_t t = a.m_pData[i]*bj + x.m_pData[i + j] + carry;
+      x.m_pData[i + j] = uint32_t(t);
+      carry = t >> BitsInWord;
+    } //for
+
+    for(int k=j + m; carry && k<x.m_nSize; k++){ //propagate carry
+      const uint64_t t = x.m_pData[k] + carry; //sum
+      x.m_pData[k] = uint32_t(t);
+      carry = t >> BitsInWord;
+    } //for
   } //for
 
-  word.normalize();
-  carry.normalize();
+  x.normalize();
+} //muladd
 
-  return word + carry;
+/// Fused multiply-add with a word, that is, add the product of a extensible
+/// unsigned integer and a word to another in a single pass.
+/// \param x [IN, OUT] A extensible unsigned integer, replaced by x + a*b.
+/// \param a A extensible unsigned integer.
+/// \param b A word.
+
+void muladd(uintx_t& x, const uintx_t& a, uint32_t b){
+  const int m = a.m_nSize; //number of words in a
+
+  if(&x == &a){ //aliased
+    x += a*b;
+    return;
+  } //if
+
+  x.grow(std::max(x.m_nSize, m) + 1); //room for the sum
+  uint64_t carry = 0; //carry word
+
+  int i; //looping variable
+
+  for(i=0; i<m; i++){
+    const uint64_t t = a.m_pData[i]*uint64_t(b) + x.m_pData[i] + carry;
+    x.m_pData[i] = uint32_t(t);
+    carry = t >> BitsInWord;
+  } //for
+
+  for(; carry && i<x.m_nSize; i++){ //propagate carry
+    const uint64_t t = x.m_pData[i] + carry; //sum
+    x.m_pData[i] = uint32_t(t);
+    carry = t >> BitsInWord;
+  } //for
+
+  x.normalize();
+} //muladd
+
+/// Multiply by a word in place.
+/// \param y A word.
+
+void uintx_t::mulword(uint32_t y){
+  uint64_t carry = 0; //carry word
+
+  for(int i=0; i<m_nSize; i++){
+    const uint64_t prod = uint64_t(m_pData[i])*y + carry; //two-word product
+    m_pData[i] = uint32_t(prod);
+    carry = prod >> BitsInWord;
+  } //for
+
+  if(carry > 0){ //need one more word
+    grow(m_nSize + 1);
+    m_pData[m_nSize - 1] = uint32_t(carry);
+  } //if
+
+  normalize();
+} //mulword
+
+/// Multiply a extensible unsigned integer by an integer.
+/// \param x A extensible unsigned integer.
+/// \param y An integer.
+/// \return x multiplied by y.
+
+uintx_t operator*(uintx_t x, int y){ 
+  x.mulword(uint32_t(y));
+  return x;
 } //operator*
 
 /// Multiply an integer by a extensible unsigned integer.
@@ -723,7 +1018,7 @@ uintx_t operator*(uintx_t x, int y){
 /// \param y A extensible unsigned integer.
 /// \return x multiplied by y.
 
-uintx_t operator*(int x, uintx_t y){ 
+uintx_t operator*(int x, const uintx_t& y){ 
   return y*x;
 } //operator*
 
@@ -733,21 +1028,8 @@ uintx_t operator*(int x, uintx_t y){
 /// \return x multiplied by y.
 
 uintx_t operator*(uintx_t x, uint32_t y){ 
-  uintx_t word, carry(0);
-
-  word.grow(x.m_nSize);
-  carry.grow(x.m_nSize + 1);
-
-  for(int i=0; i<x.m_nSize; i++){
-    uint64_t prod = (uint64_t)x.m_pData[i]*(uint64_t)y;
-    word.m_pData[i] = unsigned(prod & 0xFFFFFFFF);
-    carry.m_pData[i + 1] = unsigned(prod >> 32);
-  } //for
-
-  word.normalize();
-  carry.normalize();
-
-  return word + carry;
+  x.mulword(y);
+  return x;
 } //operator*
 
 /// Multiply an unsigned integer by a extensible unsigned integer.
@@ -755,7 +1037,7 @@ uintx_t operator*(uintx_t x, uint32_t y){
 /// \param y A extensible unsigned integer.
 /// \return x multiplied by y.
 
-uintx_t operator*(uint32_t x, uintx_t y){ 
+uintx_t operator*(uint32_t x, const uintx_t& y){ 
   return y*x;
 } //operator*
 
@@ -779,41 +1061,33 @@ uintx_t& uintx_t::operator*=(const uintx_t& y){
 /// \param y A extensible unsigned integer
 /// \return y subtracted from x, if non-negative.
 
-uintx_t operator-(uintx_t x, uintx_t y){ 
-  return x -= y;
+uintx_t operator-(uintx_t x, const uintx_t& y){ 
+  return std::move(x -= y);
 } //operator-
 
-/// Subtract a extensible unsigned integer.
+/// Subtract a extensible unsigned integer in place, one word at a time with
+/// the subtract-with-borrow instruction where available.
 /// \param y A extensible unsigned integer.
 /// \return Reference to this extensible unsigned integer after y is subtracted.
 
 uintx_t& uintx_t::operator-=(const uintx_t& y){ 
-  if(y >= *this)
+  if(compare(y, *this) >= 0)
     *this = 0; //subtracting something too big
 
-  else if(y > 0){
-    uint32_t left, right; //operands
-    bool borrow = false; //single-bit borrow
+  else{ //y < this, so any words of y beyond m_nSize are zero
+    const int n = std::min(m_nSize, y.m_nSize); //number of words to subtract
+    uint8_t borrow = 0; //single-bit borrow
     int i; //looping variable
 
-    for(i=0; i<m_nSize; i++){ //for each word in the result
-      //grab a word from each operand
-      left=m_pData[i];
-      right = (i < y.m_nSize)? y.m_pData[i]: 0;
+    for(i=0; i<n; i++) //for each word of y
+      borrow = SubBorrow(borrow, m_pData[i], y.m_pData[i], &m_pData[i]);
 
-      //subtract them
-      if(borrow)
-        borrow = ++right == 0; //try to add borrow to right
+    for(; borrow && i<m_nSize; i++) //propagate borrow
+      borrow = SubBorrow(borrow, m_pData[i], 0, &m_pData[i]);
 
-      m_pData[i] = left - right; //subtraction of uint32_t borrows automatically
-
-      if(left < right)
-        borrow = true;
-    } //for
+    normalize();
   } //else
 
-  normalize();
-
   return *this;
 } //operator-=
 
@@ -824,43 +1098,181 @@ uintx_t& uintx_t::operator-=(const uintx_t& y){
 
 #pragma region division
 
-/// Divide a extensible unsigned integer by a extensible unsigned integer.
-/// \param y A extensible unsigned integer.
-/// \param z An unsigned integer.
-/// \return x divided by y, rounded down.
+/// Divide by a single word in place, one word at a time from the most
+/// significant end.
+/// \param d A nonzero word.
+/// \return The remainder.
 
-uintx_t operator/(uintx_t y, uintx_t z){
-  uintx_t q(0); //result
+uint32_t uintx_t::divword(uint32_t d){
+  assert(d != 0); //safety
+  uint64_t r = 0; //remainder
 
-  if(y >= z){
-    uintx_t r(y), w(z);
+  for(int i=m_nSize - 1; i>=0; i--){
+    const uint64_t num = (r << BitsInWord) | m_pData[i]; //two-word numerator
+    m_pData[i] = uint32_t(num/d);
+    r = num%d;
+  } //for
 
-    w <<= y.bitcount() - z.bitcount();
+  normalize();
+  return uint32_t(r);
+} //divword
+
+/// Compute the remainder after dividing by a single word, leaving the value
+/// stored unchanged.
+/// \param d A nonzero word.
+/// \return The remainder.
+
+uint32_t uintx_t::modword(uint32_t d) const{
+  assert(d != 0); //safety
+  uint64_t r = 0; //remainder
+
+  for(int i=m_nSize - 1; i>=0; i--)
+    r = ((r << BitsInWord) | m_pData[i])%d;
+
+  return uint32_t(r);
+} //modword
+
+/// Compute the quotient and remainder together using Knuth's Algorithm D
+/// (The Art of Computer Programming, Vol. 2, Section 4.3.1), that is, long
+/// division one 32-bit word at a time. The divisor is normalized by shifting
+/// it left until its most significant bit is set, which guarantees that each
+/// estimated quotient word is at most 2 too large. Single-word divisors use
+/// the faster divword().
+/// \param y A extensible unsigned integer, the dividend.
+/// \param z A nonzero extensible unsigned integer, the divisor.
+/// \param q [OUT] The quotient y/z, rounded down.
+/// \param r [OUT] The remainder y%z.
+
+void divmod(const uintx_t& y, const uintx_t& z, uintx_t& q, uintx_t& r){
+  const uint64_t b = uint64_t(1) << BitsInWord; //the base
+
+  int m = y.m_nSize; //number of significant words in y
+  while(m > 0 && y.m_pData[m - 1] == 0)m--;
+
+  int n = z.m_nSize; //number of significant words in z
+  while(n > 0 && z.m_pData[n - 1] == 0)n--;
+
+  assert(n > 0); //division by zero
+
+  if(m < n){ //y < z
+    r = y;
+    r.normalize();
+    q = 0;
+    return;
+  } //if
 
-    while(w <= y)
-      w <<= 1;
+  if(n == 1){ //single-word divisor
+    const uint32_t d = z.m_pData[0]; //divisor
+    q = y;
+    r = int(q.divword(d));
+    return;
+  } //if
+
+  //normalize so that the most significant bit of the divisor is set
+
+  int s = 0; //shift distance
+  for(uint32_t top=z.m_pData[n - 1]; !(top & 0x80000000); top<<=1)s++;
+
+  uintx_t vtemp, utemp; //space for normalized divisor and dividend
+  vtemp.reallocate(n);
+  utemp.reallocate(m + 1); //one word longer than the dividend
+
+  uint32_t* vn = vtemp.m_pData; //normalized divisor
+  uint32_t* un = utemp.m_pData; //normalized dividend
+
+  for(int i=n - 1; i>0; i--)
+    vn[i] = (z.m_pData[i] << s) | 
+      (s? uint32_t(uint64_t(z.m_pData[i - 1]) >> (BitsInWord - s)): 0);
+  vn[0] = z.m_pData[0] << s;
+
+  un[m] = s? uint32_t(uint64_t(y.m_pData[m - 1]) >> (BitsInWord - s)): 0;
+  for(int i=m - 1; i>0; i--)
+    un[i] = (y.m_pData[i] << s) |
+      (s? uint32_t(uint64_t(y.m_pData[i - 1]) >> (BitsInWord - s)): 0);
+  un[0] = y.m_pData[0] << s;
 
-    while(w > z){
-      q <<= 1; 
-      w >>= 1;
+  q.reallocate(m - n + 1); //zeroed space for quotient
 
-      if(w <= r){
-        r -= w;
-        q += 1;
-      } //if
+  //main loop, one quotient word per iteration
+
+  for(int j=m - n; j>=0; j--){
+    //estimate quotient word from the top two words of the remainder
+
+    const uint64_t num = (uint64_t(un[j + n]) << BitsInWord) | un[j + n - 1];
+    uint64_t qhat = num/vn[n - 1]; //estimated quotient word
+    uint64_t rhat = num%vn[n - 1]; //its remainder
+
+    while(qhat >= b ||
+      qhat*vn[n - 2] > ((rhat << BitsInWord) | un[j + n - 2]))
+    { //estimate too large
+      qhat--;
+      rhat += vn[n - 1];
+      if(rhat >= b)break;
     } //while
-  } //if
 
+    //multiply and subtract
+
+    int64_t borrow = 0; //signed borrow
+    int64_t t; //difference
+
+    for(int i=0; i<n; i++){
+      const uint64_t p = qhat*vn[i]; //product
+      t = int64_t(un[i + j]) - borrow - int64_t(p & 0xFFFFFFFF);
+      un[i + j] = uint32_t(t);
+      borrow = int64_t(p >> BitsInWord) - (t >> BitsInWord);
+    } //for
+
+    t = int64_t(un[j + n]) - borrow;
+    un[j + n] = uint32_t(t);
+
+    q.m_pData[j] = uint32_t(qhat);
+
+    if(t < 0){ //subtracted too much, add back
+      q.m_pData[j]--;
+      uint64_t carry = 0; //carry
+
+      for(int i=0; i<n; i++){
+        const uint64_t sum = uint64_t(un[i + j]) + vn[i] + carry; //sum
+        un[i + j] = uint32_t(sum);
+        carry = sum >> BitsInWord;
+      } //for
+
+      un[j + n] += uint32_t(carry);
+    } //if
+  } //for
+
+  q.normalize();
+
+  //unnormalize the remainder
+
+  r.reallocate(n);
+
+  for(int i=0; i<n; i++)
+    r.m_pData[i] = (un[i] >> s) |
+      (s? uint32_t(uint64_t(un[i + 1]) << (BitsInWord - s)): 0);
+
+  r.normalize();
+} //divmod
+
+/// Divide a extensible unsigned integer by a extensible unsigned integer.
+/// \param y A extensible unsigned integer.
+/// \param z A nonzero extensible unsigned integer.
+/// \return y divided by z, rounded down.
+
+uintx_t operator/(const uintx_t& y, const uintx_t& z){
+  uintx_t q, r; //quotient and remainder
+  divmod(y, z, q, r);
   return q;
 } //operator/
 
 /// Divide a extensible unsigned integer by an unsigned integer.
 /// \param y A extensible unsigned integer.
-/// \param z An unsigned integer.
+/// \param z A nonzero unsigned integer.
 /// \return y divided by z, rounded down.
 
 uintx_t operator/(uintx_t y, uint32_t z){ 
-  return y/uintx_t(z);
+  y.divword(z);
+  return y;
 } //operator/
 
 /// Divide by a extensible unsigned integer.
@@ -868,29 +1280,21 @@ uintx_t operator/(uintx_t y, uint32_t z){
 /// \return Reference to this extensible unsigned integer after division.
 
 uintx_t& uintx_t::operator/=(const uintx_t& y){ 
-  return *this = *this/y;
+  uintx_t r; //remainder
+  divmod(*this, y, *this, r);
+  return *this;
 } //operator/
 
 /// Remainder after dividing a extensible unsigned integer by a extensible
 /// unsigned integer.
 /// \param y A extensible unsigned integer.
-/// \param z A extensible unsigned integer.
+/// \param z A nonzero extensible unsigned integer.
 /// \return The remainder after y is divided by z.
 
-uintx_t operator%(uintx_t y, uintx_t z){ 
-  uintx_t w(z);
-
-  while(w <= y)
-    w <<= 1;
-
-  while(w > z){ 
-    w >>= 1;
-
-    if(w <= y)
-      y -= w;
-  } //while
-
-  return y;
+uintx_t operator%(const uintx_t& y, const uintx_t& z){ 
+  uintx_t q, r; //quotient and remainder
+  divmod(y, z, q, r);
+  return r;
 } //operator%
 
 /// Remainder after dividing by a extensible unsigned integer.
@@ -898,16 +1302,18 @@ uintx_t operator%(uintx_t y, uintx_t z){
 /// \return Reference to this extensible unsigned integer after remaindering.
 
 uintx_t& uintx_t::operator%=(const uintx_t& y){ 
-  return *this = *this%y;
+  uintx_t q; //quotient
+  divmod(*this, y, q, *this);
+  return *this;
 } //operator%=
 
 /// Remainder after dividing a extensible unsigned integer by an unsigned integer.
 /// \param y A extensible unsigned integer.
-/// \param z An unsigned integer.
+/// \param z A nonzero unsigned integer.
 /// \return The remainder after y is divided by z.
 
-uintx_t operator%(uintx_t y, uint32_t z){ 
-  return y%uintx_t(z);
+uintx_t operator%(const uintx_t& y, uint32_t z){ 
+  return uintx_t(int(y.modword(z)));
 } //operator%
 
 #pragma endregion division
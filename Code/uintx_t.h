@@ -9,24 +9,40 @@
 
 /// \brief The extensible unsigned integer class.
 ///
-/// An extensible unsigned integer can have arbitrary length.
+/// An extensible unsigned integer can have arbitrary length. Values of up to
+/// m_nInline words, which covers the rank of a permutation of up to 57
+/// elements, are stored inline without touching the heap.
 
 class uintx_t{ 
   private:
+    static const int m_nInline = 8; ///< Number of words stored inline.
+
+    uint32_t m_nInlineData[m_nInline]; ///< Inline storage for small values.
     uint32_t* m_pData; ///< Array of 32-bit words, least significant first.
-    int m_nSize; ///< Number of words in m_pData.
+    int m_nSize; ///< Number of words in use in m_pData.
+    int m_nCapacity; ///< Number of words allocated in m_pData.
 
     void loadstring(const char* string); ///< Load hex string.
+    void reserve(const int s); ///< Reserve space for s words.
     void reallocate(const int s); ///< Reallocate space for s words.
     void grow(const int s); ///< Grow space for s words.
     void normalize(); ///< Remove leading zero words.
-    int bitcount(); ///< Number of bits.
+    int bitcount() const; ///< Number of bits.
+
+    void addword(uint32_t y); ///< Add a word in place.
+    void mulword(uint32_t y); ///< Multiply by a word in place.
+    uint32_t divword(uint32_t d); ///< Divide by a word in place.
+    uint32_t modword(uint32_t d) const; ///< Remainder after division by a word.
+
+    friend int compare(const uintx_t&, const uintx_t&); ///< Three-way compare.
+    friend int compare(const uintx_t&, uint32_t); ///< Three-way compare.
 
   public:
     uintx_t(); ///< Constructor.
     uintx_t(int); ///< Constructor.
     uintx_t(const char*); ///< Constructor.
     uintx_t(const uintx_t&); ///< Copy constructor.
+    uintx_t(uintx_t&&) noexcept; ///< Move constructor.
 
     ~uintx_t(); ///< Destructor
 
@@ -35,6 +51,7 @@ class uintx_t{
     //assignment operators
 
     uintx_t& operator=(const uintx_t&); ///< Assignment.
+    uintx_t& operator=(uintx_t&&) noexcept; ///< Move assignment.
     uintx_t& operator=(const int); ///< Assignment.
     uintx_t& operator=(const char*); ///< Assignment.
 
@@ -42,38 +59,41 @@ class uintx_t{
 
     uintx_t& operator+=(const uintx_t&); ///< Add to.
     uintx_t& operator+=(const int&); ///< Add to.
-    friend uintx_t operator+(uintx_t, uintx_t); ///< Addition.
+    friend uintx_t operator+(uintx_t, const uintx_t&); ///< Addition.
 
     //multiplication operators
 
     uintx_t& operator*=(const uintx_t&); ///< Multiply by.
-    friend uintx_t operator*(uintx_t, uintx_t); ///< Multiplication.
+    friend uintx_t operator*(const uintx_t&, const uintx_t&); ///< Multiplication.
     friend uintx_t operator*(uintx_t, int); ///< Multiplication.
-    friend uintx_t operator*(int, uintx_t); ///< Multiplication.
+    friend uintx_t operator*(int, const uintx_t&); ///< Multiplication.
     friend uintx_t operator*(uintx_t, uint32_t); ///< Multiplication.
-    friend uintx_t operator*(uint32_t, uintx_t); ///< Multiplication.
+    friend uintx_t operator*(uint32_t, const uintx_t&); ///< Multiplication.
+
+    friend void muladd(uintx_t&, const uintx_t&, const uintx_t&); ///< x += a*b.
+    friend void muladd(uintx_t&, const uintx_t&, uint32_t); ///< x += a*b.
 
     //comparison operators
 
-    friend bool operator>(uintx_t, uintx_t); ///< Greater than.
-    friend bool operator>(uintx_t, int); ///< Greater than.
+    friend bool operator>(const uintx_t&, const uintx_t&); ///< Greater than.
+    friend bool operator>(const uintx_t&, int); ///< Greater than.
 
-    friend bool operator>=(uintx_t, uintx_t); ///< Greater than or equal.
-    friend bool operator>=(uintx_t, int); ///< Greater than or equal.
+    friend bool operator>=(const uintx_t&, const uintx_t&); ///< Greater than or equal.
+    friend bool operator>=(const uintx_t&, int); ///< Greater than or equal.
 
-    friend bool operator<(uintx_t, uintx_t); ///< Less than.
-    friend bool operator<(uintx_t, int); ///< Less than.
+    friend bool operator<(const uintx_t&, const uintx_t&); ///< Less than.
+    friend bool operator<(const uintx_t&, int); ///< Less than.
 
-    friend bool operator<=(uintx_t, uintx_t); ///< Less than or equal.
-    friend bool operator<=(uintx_t, int); ///< Less than or equal.
+    friend bool operator<=(const uintx_t&, const uintx_t&); ///< Less than or equal.
+    friend bool operator<=(const uintx_t&, int); ///< Less than or equal.
 
-    friend bool operator==(uintx_t, uintx_t); ///< Equal to.
-    friend bool operator==(uintx_t, uint32_t); ///< Equal to.
-    friend bool operator==(uint32_t, uintx_t); ///< Equal to.
+    friend bool operator==(const uintx_t&, const uintx_t&); ///< Equal to.
+    friend bool operator==(const uintx_t&, uint32_t); ///< Equal to.
+    friend bool operator==(uint32_t, const uintx_t&); ///< Equal to.
 
-    friend bool operator!=(uintx_t, uintx_t); ///< Not equal to.
-    friend bool operator!=(uintx_t, uint32_t); ///< Not equal to.
-    friend bool operator!=(uint32_t, uintx_t); ///< Not equal to.
+    friend bool operator!=(const uintx_t&, const uintx_t&); ///< Not equal to.
+    friend bool operator!=(const uintx_t&, uint32_t); ///< Not equal to.
+    friend bool operator!=(uint32_t, const uintx_t&); ///< Not equal to.
 
     //bit shift operators
 
@@ -85,31 +105,34 @@ class uintx_t{
 
     //bitwise operators
 
-    friend int operator&(uintx_t, int); ///< Bit-wise AND.
+    friend int operator&(const uintx_t&, int); ///< Bit-wise AND.
     friend uintx_t operator&(uintx_t, const uintx_t&); ///< Bit-wise AND.
 
-    friend int operator|(uintx_t, int); ///< Bit-wise OR operator.
+    friend int operator|(const uintx_t&, int); ///< Bit-wise OR operator.
     friend uintx_t operator|(uintx_t, const uintx_t&); ///< Bit-wise OR.
 
     //subtraction operators
 
     uintx_t& operator-=(const uintx_t&); ///< Subtract from.
-    friend uintx_t operator-(uintx_t, uintx_t); ///< Subtraction.
+    friend uintx_t operator-(uintx_t, const uintx_t&); ///< Subtraction.
 
     //division operators
 
+    friend void divmod(const uintx_t&, const uintx_t&, uintx_t&,
+      uintx_t&); ///< Quotient and remainder.
+
     uintx_t& operator/=(const uintx_t&); ///< Divide by.
-    friend uintx_t operator/(uintx_t, uintx_t); ///< Division.
+    friend uintx_t operator/(const uintx_t&, const uintx_t&); ///< Division.
     friend uintx_t operator/(uintx_t, uint32_t); ///< Division.
 
     uintx_t& operator%=(const uintx_t&); ///< Remainder.
-    friend uintx_t operator%(uintx_t, uintx_t); ///< Remainder.
-    friend uintx_t operator%(uintx_t, uint32_t); ///< Remainder.
+    friend uintx_t operator%(const uintx_t&, const uintx_t&); ///< Remainder.
+    friend uintx_t operator%(const uintx_t&, uint32_t); ///< Remainder.
 
     //type casts
 
-    operator uint32_t(); ///< Cast to uint32_t.
-    operator uint64_t(); ///< Cast to uint64_t.
+    operator uint32_t() const; ///< Cast to uint32_t.
+    operator uint64_t() const; ///< Cast to uint64_t.
 };
 
 #endif
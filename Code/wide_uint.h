@@ -0,0 +1,607 @@
+/// \file wide_uint.h
+/// \brief Declaration and implementation of the fixed-width unsigned integer
+/// template wide_uint.
+
+#ifndef __wide_uint__
+#define __wide_uint__
+
+#include "Includes.h"
+#include <cinttypes>
+#include <type_traits>
+
+/// \brief Fixed-width unsigned integer.
+///
+/// A fixed-width unsigned integer has a number of bits that is a multiple of
+/// 32, at least 64, and known at compile time. It has the same operators as
+/// uintx_t, but it lives entirely on the stack and its loops have constant
+/// trip counts, which makes it much faster for values of known maximum size
+/// such as the ranks of permutations of size up to 57. Arithmetic is modulo
+/// \f$2^{Bits}\f$, and everything except GetString() is constexpr.
+
+template<int Bits> class wide_uint{
+  static_assert(Bits >= 64 && Bits%32 == 0, "Bits must be a multiple of 32");
+
+  private:
+    static const int m_nWords = Bits/32; ///< Number of 32-bit words.
+    uint32_t m_nData[m_nWords]; ///< Words, least significant first.
+
+    constexpr int sigwords() const; ///< Number of significant words.
+    constexpr uint32_t divword(uint32_t d); ///< Divide by a word in place.
+    constexpr uint32_t modword(uint32_t d) const; ///< Remainder by a word.
+    constexpr void mulword(uint32_t y); ///< Multiply by a word in place.
+
+  public:
+    constexpr wide_uint(); ///< Constructor.
+    template<class T, class = typename
+      std::enable_if<std::is_integral<T>::value>::type>
+      constexpr wide_uint(T); ///< Constructor.
+    constexpr explicit wide_uint(const char*); ///< Constructor.
+
+    std::string GetString() const; ///< Get as string.
+
+    constexpr int compare(const wide_uint&) const; ///< Three-way compare.
+    constexpr void divmod(const wide_uint&, wide_uint&,
+      wide_uint&) const; ///< Quotient and remainder.
+
+    constexpr wide_uint& operator+=(const wide_uint&); ///< Add to.
+    constexpr wide_uint& operator-=(const wide_uint&); ///< Subtract from.
+    constexpr wide_uint& operator*=(const wide_uint&); ///< Multiply by.
+    constexpr wide_uint& operator*=(uint32_t); ///< Multiply by.
+    constexpr wide_uint& operator/=(const wide_uint&); ///< Divide by.
+    constexpr wide_uint& operator/=(uint32_t); ///< Divide by.
+    constexpr wide_uint& operator%=(const wide_uint&); ///< Remainder.
+    constexpr wide_uint& operator%=(uint32_t); ///< Remainder.
+
+    constexpr wide_uint& operator<<=(int); ///< Left shift by.
+    constexpr wide_uint& operator>>=(int); ///< Right shift by.
+    constexpr wide_uint& operator&=(const wide_uint&); ///< Bit-wise AND with.
+    constexpr wide_uint& operator|=(const wide_uint&); ///< Bit-wise OR with.
+
+    constexpr explicit operator uint32_t() const; ///< Cast to uint32_t.
+    constexpr explicit operator uint64_t() const; ///< Cast to uint64_t.
+}; //wide_uint
+
+typedef wide_uint<128> uint128w_t; ///< 128-bit unsigned integer, holds 32!.
+typedef wide_uint<256> uint256w_t; ///< 256-bit unsigned integer, holds 57!.
+typedef wide_uint<512> uint512w_t; ///< 512-bit unsigned integer, holds 98!.
+
+/////////////////////////////////////////////////////////////////////////////
+//Constructors.
+
+#pragma region structors
+
+/// Void constructor, initializes to zero.
+
+template<int Bits> constexpr wide_uint<Bits>::wide_uint(): m_nData{}{
+} //void constructor
+
+/// Integer constructor. This is a template so that any integer type, in
+/// particular the literal 0, is an exact match that beats the string
+/// constructor. A negative value is sign-extended to every word, giving its
+/// value modulo \f$2^{Bits}\f$.
+/// \param i Initial value.
+
+template<int Bits> template<class T, class>
+constexpr wide_uint<Bits>::wide_uint(T i): m_nData{}{
+  const bool negative = std::is_signed<T>::value && (uint64_t(i) >> 63);
+
+  m_nData[0] = uint32_t(uint64_t(i));
+  m_nData[1] = uint32_t(uint64_t(i) >> 32);
+
+  for(int j=2; j<m_nWords; j++)
+    m_nData[j] = negative? 0xFFFFFFFF: 0;
+} //integer constructor
+
+/// String constructor. Digits that do not fit are lost from the top.
+/// \param string String containing initial value in hexadecimal.
+
+template<int Bits> constexpr wide_uint<Bits>::wide_uint(const char* string):
+  m_nData{}
+{
+  for(const char* p=string; *p; p++){ //for each digit, most significant first
+    uint32_t digit = 0; //digit value
+
+    if(*p >= '0' && *p <= '9')digit = *p - '0';
+    else if(*p >= 'A' && *p <= 'F')digit = 10 + *p - 'A';
+    else if(*p >= 'a' && *p <= 'f')digit = 10 + *p - 'a';
+    else assert(false); //safety
+
+    *this <<= 4;
+    m_nData[0] |= digit;
+  } //for
+} //string constructor
+
+#pragma endregion structors
+
+/////////////////////////////////////////////////////////////////////////////
+//General purpose functions.
+
+#pragma region general
+
+/// Convert to a hexadecimal string.
+/// \return Hexadecimal string without leading zeros.
+
+template<int Bits> std::string wide_uint<Bits>::GetString() const{
+  std::string s; //result
+
+  for(int i=m_nWords - 1; i>=0; i--){ //for each word, most significant first
+    char word[9]; //word as 8 hex digits
+    snprintf(word, sizeof(word), "%08" PRIX32, m_nData[i]);
+    s += word;
+  } //for
+
+  const size_t first = s.find_first_not_of('0'); //first significant digit
+  return first == std::string::npos? "0": s.substr(first);
+} //GetString
+
+/// Count the number of words up to and including the most significant
+/// nonzero one.
+/// \return Number of significant words, 0 if the value is zero.
+
+template<int Bits> constexpr int wide_uint<Bits>::sigwords() const{
+  int n = m_nWords; //result
+  while(n > 0 && m_nData[n - 1] == 0)n--;
+  return n;
+} //sigwords
+
+/// Three-way comparison.
+/// \param y A fixed-width unsigned integer.
+/// \return -1, 0, or 1 if this is less than, equal to, or greater than y.
+
+template<int Bits>
+constexpr int wide_uint<Bits>::compare(const wide_uint& y) const{
+  for(int i=m_nWords - 1; i>=0; i--)
+    if(m_nData[i] != y.m_nData[i])
+      return m_nData[i] > y.m_nData[i]? 1: -1;
+
+  return 0; //they're equal
+} //compare
+
+/// Cast to a 32-bit unsigned integer.
+/// \return Least significant 32 bits.
+
+template<int Bits>
+constexpr wide_uint<Bits>::operator uint32_t() const{
+  return m_nData[0];
+} //uint32_t
+
+/// Cast to a 64-bit unsigned integer.
+/// \return Least significant 64 bits.
+
+template<int Bits>
+constexpr wide_uint<Bits>::operator uint64_t() const{
+  return (uint64_t(m_nData[1]) << 32) | m_nData[0];
+} //uint64_t
+
+#pragma endregion general
+
+/////////////////////////////////////////////////////////////////////////////
+//Addition, subtraction, and bitwise operators.
+
+#pragma region additive
+
+/// Add a fixed-width unsigned integer, modulo \f$2^{Bits}\f$.
+/// \param y A fixed-width unsigned integer.
+/// \return Reference to this after y has been added.
+
+template<int Bits>
+constexpr wide_uint<Bits>& wide_uint<Bits>::operator+=(const wide_uint& y){
+  uint64_t carry = 0; //carry
+
+  for(int i=0; i<m_nWords; i++){
+    const uint64_t t = uint64_t(m_nData[i]) + y.m_nData[i] + carry; //sum
+    m_nData[i] = uint32_t(t);
+    carry = t >> 32;
+  } //for
+
+  return *this;
+} //operator+=
+
+/// Subtract a fixed-width unsigned integer, modulo \f$2^{Bits}\f$.
+/// \param y A fixed-width unsigned integer.
+/// \return Reference to this after y has been subtracted.
+
+template<int Bits>
+constexpr wide_uint<Bits>& wide_uint<Bits>::operator-=(const wide_uint& y){
+  uint64_t borrow = 0; //borrow
+
+  for(int i=0; i<m_nWords; i++){
+    const uint64_t t = uint64_t(m_nData[i]) - y.m_nData[i] - borrow; //difference
+    m_nData[i] = uint32_t(t);
+    borrow = t >> 63;
+  } //for
+
+  return *this;
+} //operator-=
+
+/// Bit-wise AND with a fixed-width unsigned integer.
+/// \param y A fixed-width unsigned integer.
+/// \return Reference to this after ANDing with y.
+
+template<int Bits>
+constexpr wide_uint<Bits>& wide_uint<Bits>::operator&=(const wide_uint& y){
+  for(int i=0; i<m_nWords; i++)
+    m_nData[i] &= y.m_nData[i];
+
+  return *this;
+} //operator&=
+
+/// Bit-wise OR with a fixed-width unsigned integer.
+/// \param y A fixed-width unsigned integer.
+/// \return Reference to this after ORing with y.
+
+template<int Bits>
+constexpr wide_uint<Bits>& wide_uint<Bits>::operator|=(const wide_uint& y){
+  for(int i=0; i<m_nWords; i++)
+    m_nData[i] |= y.m_nData[i];
+
+  return *this;
+} //operator|=
+
+#pragma endregion additive
+
+/////////////////////////////////////////////////////////////////////////////
+//Bit shift operators.
+
+#pragma region shift
+
+/// Left-shift, losing bits off the top.
+/// \param distance Number of bits to left-shift by.
+/// \return Reference to this after left-shifting.
+
+template<int Bits>
+constexpr wide_uint<Bits>& wide_uint<Bits>::operator<<=(int distance){
+  const int words = distance/32; //shift distance in words
+  const int d = distance%32; //shift distance within words
+
+  for(int dest=m_nWords - 1; dest>=0; dest--){ //sources are never ahead
+    const int src = dest - words; //source word
+    uint32_t w = src >= 0? m_nData[src] << d: 0; //new word
+
+    if(d > 0 && src > 0)
+      w |= m_nData[src - 1] >> (32 - d);
+
+    m_nData[dest] = w;
+  } //for
+
+  return *this;
+} //operator<<=
+
+/// Right-shift.
+/// \param distance Number of bits to right-shift by.
+/// \return Reference to this after right-shifting.
+
+template<int Bits>
+constexpr wide_uint<Bits>& wide_uint<Bits>::operator>>=(int distance){
+  const int words = distance/32; //shift distance in words
+  const int d = distance%32; //shift distance within words
+
+  for(int dest=0; dest<m_nWords; dest++){ //sources are never behind
+    const int src = dest + words; //source word
+    uint32_t w = src < m_nWords? m_nData[src] >> d: 0; //new word
+
+    if(d > 0 && src + 1 < m_nWords)
+      w |= m_nData[src + 1] << (32 - d);
+
+    m_nData[dest] = w;
+  } //for
+
+  return *this;
+} //operator>>=
+
+#pragma endregion shift
+
+/////////////////////////////////////////////////////////////////////////////
+//Multiplication operators.
+
+#pragma region multiplication
+
+/// Multiply by a word in place, modulo \f$2^{Bits}\f$.
+/// \param y A word.
+
+template<int Bits> constexpr void wide_uint<Bits>::mulword(uint32_t y){
+  uint64_t carry = 0; //carry word
+
+  for(int i=0; i<m_nWords; i++){
+    const uint64_t t = uint64_t(m_nData[i])*y + carry; //two-word product
+    m_nData[i] = uint32_t(t);
+    carry = t >> 32;
+  } //for
+} //mulword
+
+/// Multiply by a fixed-width unsigned integer, modulo \f$2^{Bits}\f$, by
+/// schoolbook multiplication. Products that fall off the top are skipped.
+/// \param y A fixed-width unsigned integer.
+/// \return Reference to this after multiplication by y.
+
+template<int Bits>
+constexpr wide_uint<Bits>& wide_uint<Bits>::operator*=(const wide_uint& y){
+  wide_uint result; //product
+
+  for(int j=0; j<m_nWords; j++){ //for each word of y
+    const uint64_t yj = y.m_nData[j]; //current word of y
+    uint64_t carry = 0; //carry word
+
+    for(int i=0; i + j<m_nWords; i++){
+      const uint64_t t = m_nData[i]*yj + result.m_nData[i + j] + carry;
+      result.m_nData[i + j] = uint32_t(t);
+      carry = t >> 32;
+    } //for
+  } //for
+
+  return *this = result;
+} //operator*=
+
+/// Multiply by a word, modulo \f$2^{Bits}\f$.
+/// \param y A word.
+/// \return Reference to this after multiplication by y.
+
+template<int Bits>
+constexpr wide_uint<Bits>& wide_uint<Bits>::operator*=(uint32_t y){
+  mulword(y);
+  return *this;
+} //operator*=
+
+#pragma endregion multiplication
+
+/////////////////////////////////////////////////////////////////////////////
+//Division and remainder operators.
+
+#pragma region division
+
+/// Divide by a single word in place.
+/// \param d A nonzero word.
+/// \return The remainder.
+
+template<int Bits> constexpr uint32_t wide_uint<Bits>::divword(uint32_t d){
+  uint64_t r = 0; //remainder
+
+  for(int i=m_nWords - 1; i>=0; i--){
+    const uint64_t num = (r << 32) | m_nData[i]; //two-word numerator
+    m_nData[i] = uint32_t(num/d);
+    r = num%d;
+  } //for
+
+  return uint32_t(r);
+} //divword
+
+/// Compute the remainder after dividing by a single word.
+/// \param d A nonzero word.
+/// \return The remainder.
+
+template<int Bits>
+constexpr uint32_t wide_uint<Bits>::modword(uint32_t d) const{
+  uint64_t r = 0; //remainder
+
+  for(int i=m_nWords - 1; i>=0; i--)
+    r = ((r << 32) | m_nData[i])%d;
+
+  return uint32_t(r);
+} //modword
+
+/// Compute the quotient and remainder together using Knuth's Algorithm D,
+/// exactly as for uintx_t but on fixed-size arrays.
+/// \param z A nonzero fixed-width unsigned integer, the divisor.
+/// \param q [OUT] The quotient, rounded down.
+/// \param r [OUT] The remainder.
+
+template<int Bits> constexpr void wide_uint<Bits>::divmod(const wide_uint& z,
+  wide_uint& q, wide_uint& r) const
+{
+  const int m = sigwords(); //number of significant words in this
+  const int n = z.sigwords(); //number of significant words in z
+  assert(n > 0); //division by zero
+
+  if(m < n){ //this < z
+    r = *this;
+    q = wide_uint();
+    return;
+  } //if
+
+  if(n == 1){ //single-word divisor
+    const uint32_t d = z.m_nData[0]; //divisor
+    q = *this;
+    r = wide_uint(q.divword(d));
+    return;
+  } //if
+
+  //normalize so that the most significant bit of the divisor is set
+
+  int s = 0; //shift distance
+  for(uint32_t top=z.m_nData[n - 1]; !(top & 0x80000000); top<<=1)s++;
+
+  uint32_t vn[m_nWords] = {}; //normalized divisor
+  uint32_t un[m_nWords + 1] = {}; //normalized dividend, one word longer
+
+  for(int i=n - 1; i>0; i--)
+    vn[i] = (z.m_nData[i] << s) |
+      (s? uint32_t(uint64_t(z.m_nData[i - 1]) >> (32 - s)): 0);
+  vn[0] = z.m_nData[0] << s;
+
+  un[m] = s? uint32_t(uint64_t(m_nData[m - 1]) >> (32 - s)): 0;
+  for(int i=m - 1; i>0; i--)
+    un[i] = (m_nData[i] << s) |
+      (s? uint32_t(uint64_t(m_nData[i - 1]) >> (32 - s)): 0);
+  un[0] = m_nData[0] << s;
+
+  wide_uint quotient; //quotient
+
+  for(int j=m - n; j>=0; j--){ //one quotient word per iteration
+    const uint64_t num = (uint64_t(un[j + n]) << 32) | un[j + n - 1];
+    uint64_t qhat = num/vn[n - 1]; //estimated quotient word
+    uint64_t rhat = num%vn[n - 1]; //its remainder
+
+    while(qhat >= (uint64_t(1) << 32) ||
+      qhat*vn[n - 2] > ((rhat << 32) | un[j + n - 2]))
+    { //estimate too large
+      qhat--;
+      rhat += vn[n - 1];
+      if(rhat >= (uint64_t(1) << 32))break;
+    } //while
+
+    int64_t borrow = 0; //signed borrow
+    int64_t t = 0; //difference
+
+    for(int i=0; i<n; i++){ //multiply and subtract
+      const uint64_t p = qhat*vn[i]; //product
+      t = int64_t(un[i + j]) - borrow - int64_t(p & 0xFFFFFFFF);
+      un[i + j] = uint32_t(t);
+      borrow = int64_t(p >> 32) - (t >> 32);
+    } //for
+
+    t = int64_t(un[j + n]) - borrow;
+    un[j + n] = uint32_t(t);
+
+    quotient.m_nData[j] = uint32_t(qhat);
+
+    if(t < 0){ //subtracted too much, add back
+      quotient.m_nData[j]--;
+      uint64_t carry = 0; //carry
+
+      for(int i=0; i<n; i++){
+        const uint64_t sum = uint64_t(un[i + j]) + vn[i] + carry; //sum
+        un[i + j] = uint32_t(sum);
+        carry = sum >> 32;
+      } //for
+
+      un[j + n] += uint32_t(carry);
+    } //if
+  } //for
+
+  q = quotient;
+  r = wide_uint();
+
+  for(int i=0; i<n; i++) //unnormalize the remainder
+    r.m_nData[i] = (un[i] >> s) |
+      (s? uint32_t(uint64_t(un[i + 1]) << (32 - s)): 0);
+} //divmod
+
+/// Divide by a fixed-width unsigned integer.
+/// \param y A nonzero fixed-width unsigned integer.
+/// \return Reference to this after division by y, rounded down.
+
+template<int Bits>
+constexpr wide_uint<Bits>& wide_uint<Bits>::operator/=(const wide_uint& y){
+  wide_uint r; //remainder
+  divmod(y, *this, r);
+  return *this;
+} //operator/=
+
+/// Divide by a word.
+/// \param y A nonzero word.
+/// \return Reference to this after division by y, rounded down.
+
+template<int Bits>
+constexpr wide_uint<Bits>& wide_uint<Bits>::operator/=(uint32_t y){
+  divword(y);
+  return *this;
+} //operator/=
+
+/// Remainder after dividing by a fixed-width unsigned integer.
+/// \param y A nonzero fixed-width unsigned integer.
+/// \return Reference to this after remaindering.
+
+template<int Bits>
+constexpr wide_uint<Bits>& wide_uint<Bits>::operator%=(const wide_uint& y){
+  wide_uint q; //quotient
+  divmod(y, q, *this);
+  return *this;
+} //operator%=
+
+/// Remainder after dividing by a word.
+/// \param y A nonzero word.
+/// \return Reference to this after remaindering.
+
+template<int Bits>
+constexpr wide_uint<Bits>& wide_uint<Bits>::operator%=(uint32_t y){
+  return *this = wide_uint(modword(y));
+} //operator%=
+
+#pragma endregion division
+
+/////////////////////////////////////////////////////////////////////////////
+//Binary operators, in terms of the compound assignment operators.
+
+#pragma region binary
+
+/// Compute quotient and remainder, for symmetry with uintx_t.
+/// \param y A fixed-width unsigned integer, the dividend.
+/// \param z A nonzero fixed-width unsigned integer, the divisor.
+/// \param q [OUT] The quotient y/z, rounded down.
+/// \param r [OUT] The remainder y%z.
+
+template<int Bits> constexpr void divmod(const wide_uint<Bits>& y,
+  const wide_uint<Bits>& z, wide_uint<Bits>& q, wide_uint<Bits>& r)
+{
+  y.divmod(z, q, r);
+} //divmod
+
+template<int Bits> constexpr wide_uint<Bits> operator+(wide_uint<Bits> x,
+  const wide_uint<Bits>& y){return x += y;} ///< Addition.
+template<int Bits> constexpr wide_uint<Bits> operator-(wide_uint<Bits> x,
+  const wide_uint<Bits>& y){return x -= y;} ///< Subtraction.
+
+template<int Bits> constexpr wide_uint<Bits> operator*(wide_uint<Bits> x,
+  const wide_uint<Bits>& y){return x *= y;} ///< Multiplication.
+template<int Bits> constexpr wide_uint<Bits> operator*(wide_uint<Bits> x,
+  uint32_t y){return x *= y;} ///< Multiplication.
+template<int Bits> constexpr wide_uint<Bits> operator*(uint32_t x,
+  wide_uint<Bits> y){return y *= x;} ///< Multiplication.
+template<int Bits> constexpr wide_uint<Bits> operator*(wide_uint<Bits> x,
+  int y){return x *= uint32_t(y);} ///< Multiplication.
+template<int Bits> constexpr wide_uint<Bits> operator*(int x,
+  wide_uint<Bits> y){return y *= uint32_t(x);} ///< Multiplication.
+
+template<int Bits> constexpr wide_uint<Bits> operator/(wide_uint<Bits> x,
+  const wide_uint<Bits>& y){return x /= y;} ///< Division.
+template<int Bits> constexpr wide_uint<Bits> operator/(wide_uint<Bits> x,
+  uint32_t y){return x /= y;} ///< Division.
+template<int Bits> constexpr wide_uint<Bits> operator%(wide_uint<Bits> x,
+  const wide_uint<Bits>& y){return x %= y;} ///< Remainder.
+template<int Bits> constexpr wide_uint<Bits> operator%(wide_uint<Bits> x,
+  uint32_t y){return x %= y;} ///< Remainder.
+
+template<int Bits> constexpr wide_uint<Bits> operator<<(wide_uint<Bits> x,
+  int d){return x <<= d;} ///< Left shift.
+template<int Bits> constexpr wide_uint<Bits> operator>>(wide_uint<Bits> x,
+  int d){return x >>= d;} ///< Right shift.
+
+template<int Bits> constexpr wide_uint<Bits> operator&(wide_uint<Bits> x,
+  const wide_uint<Bits>& y){return x &= y;} ///< Bit-wise AND.
+template<int Bits> constexpr wide_uint<Bits> operator|(wide_uint<Bits> x,
+  const wide_uint<Bits>& y){return x |= y;} ///< Bit-wise OR.
+
+template<int Bits> constexpr int operator&(const wide_uint<Bits>& x,
+  int y){return int(uint32_t(x)) & y;} ///< Bit-wise AND of the low word.
+template<int Bits> constexpr int operator|(const wide_uint<Bits>& x,
+  int y){return int(uint32_t(x)) | y;} ///< Bit-wise OR of the low word.
+
+template<int Bits> constexpr bool operator>(const wide_uint<Bits>& x,
+  const wide_uint<Bits>& y){return x.compare(y) > 0;} ///< Greater than.
+template<int Bits> constexpr bool operator>=(const wide_uint<Bits>& x,
+  const wide_uint<Bits>& y){return x.compare(y) >= 0;} ///< At least.
+template<int Bits> constexpr bool operator<(const wide_uint<Bits>& x,
+  const wide_uint<Bits>& y){return x.compare(y) < 0;} ///< Less than.
+template<int Bits> constexpr bool operator<=(const wide_uint<Bits>& x,
+  const wide_uint<Bits>& y){return x.compare(y) <= 0;} ///< At most.
+template<int Bits> constexpr bool operator==(const wide_uint<Bits>& x,
+  const wide_uint<Bits>& y){return x.compare(y) == 0;} ///< Equal to.
+template<int Bits> constexpr bool operator!=(const wide_uint<Bits>& x,
+  const wide_uint<Bits>& y){return x.compare(y) != 0;} ///< Not equal to.
+
+template<int Bits> constexpr bool operator>(const wide_uint<Bits>& x,
+  uint64_t y){return x > wide_uint<Bits>(y);} ///< Greater than.
+template<int Bits> constexpr bool operator>=(const wide_uint<Bits>& x,
+  uint64_t y){return x >= wide_uint<Bits>(y);} ///< At least.
+template<int Bits> constexpr bool operator<(const wide_uint<Bits>& x,
+  uint64_t y){return x < wide_uint<Bits>(y);} ///< Less than.
+template<int Bits> constexpr bool operator<=(const wide_uint<Bits>& x,
+  uint64_t y){return x <= wide_uint<Bits>(y);} ///< At most.
+template<int Bits> constexpr bool operator==(const wide_uint<Bits>& x,
+  uint64_t y){return x == wide_uint<Bits>(y);} ///< Equal to.
+template<int Bits> constexpr bool operator!=(const wide_uint<Bits>& x,
+  uint64_t y){return x != wide_uint<Bits>(y);} ///< Not equal to.
+
+#pragma endregion binary
+
+#endif